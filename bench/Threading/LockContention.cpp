@@ -0,0 +1,156 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/bench/Threading/LockContention.cpp
+ * \brief Contention microbenchmark of classes Threading::Mutex and Threading::RWLock.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#include "PACC/Threading/Mutex.hpp"
+#include "PACC/Threading/RWLock.hpp"
+#include "PACC/Threading/Thread.hpp"
+#include "PACC/Util/Timer.hpp"
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace PACC;
+
+namespace {
+
+	//! Number of shared counters, all updated by every write.
+	const unsigned int cCounters = 16;
+
+	//! Shared data protected by the benchmarked lock.
+	volatile long gCounters[cCounters];
+
+	//! Exclusive access for both reads and writes (class Threading::Mutex).
+	struct MutexPolicy {
+		static void lockRead(Threading::Mutex& ioLock) {ioLock.lock();}
+		static void unlockRead(Threading::Mutex& ioLock) {ioLock.unlock();}
+		static void lockWrite(Threading::Mutex& ioLock) {ioLock.lock();}
+		static void unlockWrite(Threading::Mutex& ioLock) {ioLock.unlock();}
+	};
+
+	//! Shared access for reads and exclusive access for writes (class Threading::RWLock).
+	struct RWLockPolicy {
+		static void lockRead(Threading::RWLock& ioLock) {ioLock.lockShared();}
+		static void unlockRead(Threading::RWLock& ioLock) {ioLock.unlockShared();}
+		static void lockWrite(Threading::RWLock& ioLock) {ioLock.lock();}
+		static void unlockWrite(Threading::RWLock& ioLock) {ioLock.unlock();}
+	};
+
+	//! Thread that reads or writes the shared counters under lock \c Lock, with a given ratio of writes.
+	template <class Lock, class Policy>
+	class Worker : public Threading::Thread {
+		public:
+		Worker(Lock& inLock, unsigned int inOperations, unsigned int inWritePercent, unsigned int inSeed) :
+			mLock(inLock), mOperations(inOperations), mWritePercent(inWritePercent), mSeed(inSeed), mErrors(0) {}
+
+		//! Return the number of inconsistent reads (must be 0).
+		unsigned int getErrors(void) const {return mErrors;}
+
+		protected:
+		Lock& mLock; //!< Benchmarked lock.
+		unsigned int mOperations; //!< Number of operations to perform.
+		unsigned int mWritePercent; //!< Percentage of writes.
+		unsigned int mSeed; //!< State of the random generator.
+		unsigned int mErrors; //!< Number of inconsistent reads.
+
+		void main(void) {
+			for(unsigned int i = 0; i < mOperations; ++i) {
+				mSeed = mSeed*1103515245 + 12345;
+				if((mSeed >> 16)%100 < mWritePercent) {
+					Policy::lockWrite(mLock);
+					for(unsigned int j = 0; j < cCounters; ++j) gCounters[j] = gCounters[j]+1;
+					Policy::unlockWrite(mLock);
+				} else {
+					Policy::lockRead(mLock);
+					long lValue = gCounters[0];
+					for(unsigned int j = 1; j < cCounters; ++j) if(gCounters[j] != lValue) ++mErrors;
+					Policy::unlockRead(mLock);
+				}
+			}
+		}
+	};
+
+	//! Return the time (in seconds) for \c inThreads threads to perform \c inOperations operations each on lock \c ioLock.
+	template <class Lock, class Policy>
+	double measure(Lock& ioLock, unsigned int inThreads, unsigned int inOperations, unsigned int inWritePercent, unsigned int& ioErrors)
+	{
+		for(unsigned int j = 0; j < cCounters; ++j) gCounters[j] = 0;
+		vector<Worker<Lock, Policy>*> lWorkers;
+		for(unsigned int i = 0; i < inThreads; ++i) lWorkers.push_back(new Worker<Lock, Policy>(ioLock, inOperations, inWritePercent, i+1));
+		Timer lTimer;
+		for(unsigned int i = 0; i < inThreads; ++i) lWorkers[i]->run();
+		for(unsigned int i = 0; i < inThreads; ++i) lWorkers[i]->wait();
+		double lTime = lTimer.getValue();
+		for(unsigned int i = 0; i < inThreads; ++i) {
+			ioErrors += lWorkers[i]->getErrors();
+			delete lWorkers[i];
+		}
+		return lTime;
+	}
+
+}
+
+/*!
+Usage: benchLockContention [threads [operations]]
+
+Every thread performs the given number of operations (default 200000) on 16 shared counters, a given percentage of which are writes; the other operations are reads that check that the counters are consistent. The run times of the blocking and adaptive modes of Mutex and RWLock are printed for 1%, 10% and 50% of writes. On a single processor, adaptive locks never spin and readers cannot overlap, so that only the overhead of the locks is measured.
+ */
+int main(int argc, char** argv)
+{
+	unsigned int lThreads = (argc > 1) ? atoi(argv[1]) : 4;
+	unsigned int lOperations = (argc > 2) ? atoi(argv[2]) : 200000;
+	unsigned int lErrors = 0;
+	unsigned int lPercents[] = {1, 10, 50};
+	cout << lThreads << " threads x " << lOperations << " operations (times in seconds)" << endl;
+	cout << fixed << setprecision(3);
+	for(unsigned int i = 0; i < sizeof(lPercents)/sizeof(lPercents[0]); ++i) {
+		Threading::Mutex lMutex;
+		Threading::Mutex lAdaptiveMutex(Threading::Mutex::eAdaptive);
+		Threading::RWLock lRWLock;
+		Threading::RWLock lAdaptiveRWLock(Threading::Mutex::eAdaptive);
+		cout << "writes " << setw(2) << lPercents[i] << "%:";
+		cout << " mutex " << measure<Threading::Mutex, MutexPolicy>(lMutex, lThreads, lOperations, lPercents[i], lErrors);
+		cout << " adaptive " << measure<Threading::Mutex, MutexPolicy>(lAdaptiveMutex, lThreads, lOperations, lPercents[i], lErrors);
+		cout << " rwlock " << measure<Threading::RWLock, RWLockPolicy>(lRWLock, lThreads, lOperations, lPercents[i], lErrors);
+		cout << " rwlock-adaptive " << measure<Threading::RWLock, RWLockPolicy>(lAdaptiveRWLock, lThreads, lOperations, lPercents[i], lErrors);
+		cout << endl;
+	}
+	if(lErrors > 0) {
+		cerr << "inconsistent reads: " << lErrors << endl;
+		return 1;
+	}
+	return 0;
+}
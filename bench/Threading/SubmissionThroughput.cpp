@@ -0,0 +1,109 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/bench/Threading/SubmissionThroughput.cpp
+ * \brief Microbenchmark of the task submission throughput of class Threading::ThreadPool.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#include "PACC/Threading/ThreadPool.hpp"
+#include "PACC/Threading/Thread.hpp"
+#include "PACC/Util/Timer.hpp"
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace PACC;
+
+namespace {
+
+	//! Empty task, so that only the cost of submission and dispatch is measured.
+	class EmptyTask : public Threading::Task {
+		protected:
+		void main(void) {}
+	};
+
+	//! Thread that submits its tasks to a pool, one by one or in a single batch, and waits for them.
+	class Submitter : public Threading::Thread {
+		public:
+		Submitter(Threading::ThreadPool& inPool, unsigned int inTasks, bool inBatch) : mPool(inPool), mTasks(inTasks), mBatch(inBatch) {}
+
+		protected:
+		Threading::ThreadPool& mPool; //!< Pool of the tasks.
+		vector<EmptyTask> mTasks; //!< Submitted tasks.
+		bool mBatch; //!< Submit tasks with ThreadPool::pushBatch flag.
+
+		void main(void) {
+			if(mBatch) mPool.pushBatch(mTasks.begin(), mTasks.end());
+			else for(size_t i = 0; i < mTasks.size(); ++i) mPool.push(mTasks[i]);
+			for(size_t i = 0; i < mTasks.size(); ++i) mTasks[i].wait();
+		}
+	};
+
+	//! Return the number of tasks per second for \c inSubmitters threads submitting \c inTasks tasks in total to a pool of \c inWorkers slaves.
+	double measure(unsigned int inWorkers, unsigned int inSubmitters, unsigned int inTasks, bool inBatch)
+	{
+		Threading::ThreadPool lPool(inWorkers);
+		vector<Submitter*> lSubmitters;
+		for(unsigned int i = 0; i < inSubmitters; ++i) lSubmitters.push_back(new Submitter(lPool, inTasks/inSubmitters, inBatch));
+		Timer lTimer;
+		for(unsigned int i = 0; i < inSubmitters; ++i) lSubmitters[i]->run();
+		for(unsigned int i = 0; i < inSubmitters; ++i) lSubmitters[i]->wait();
+		double lTime = lTimer.getValue();
+		for(unsigned int i = 0; i < inSubmitters; ++i) delete lSubmitters[i];
+		return (inTasks/inSubmitters)*inSubmitters/lTime;
+	}
+
+}
+
+/*!
+Usage: benchSubmissionThroughput [max workers [max submitters [tasks]]]
+
+For every power of two of workers and submitters up to the given maxima (default 8 and 4), the submitters push a total of the given number of empty tasks (default 200000) onto the pool, and wait for all of them. The throughput is printed in tasks per second, for tasks pushed one by one (ThreadPool::push) and in one batch per submitter (ThreadPool::pushBatch).
+ */
+int main(int argc, char** argv)
+{
+	unsigned int lMaxWorkers = (argc > 1) ? atoi(argv[1]) : 8;
+	unsigned int lMaxSubmitters = (argc > 2) ? atoi(argv[2]) : 4;
+	unsigned int lTasks = (argc > 3) ? atoi(argv[3]) : 200000;
+	cout << lTasks << " empty tasks (throughput in tasks/s)" << endl;
+	cout << fixed << setprecision(0);
+	for(unsigned int lWorkers = 1; lWorkers <= lMaxWorkers; lWorkers *= 2) {
+		for(unsigned int lSubmitters = 1; lSubmitters <= lMaxSubmitters; lSubmitters *= 2) {
+			cout << "workers " << setw(2) << lWorkers << " submitters " << setw(2) << lSubmitters << ":";
+			cout << " push " << setw(9) << measure(lWorkers, lSubmitters, lTasks, false);
+			cout << " pushBatch " << setw(9) << measure(lWorkers, lSubmitters, lTasks, true);
+			cout << endl;
+		}
+	}
+	return 0;
+}
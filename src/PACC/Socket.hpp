@@ -44,6 +44,7 @@
 #include "PACC/Socket/Address.hpp"
 #include "PACC/Socket/Cafe.hpp"
 #include "PACC/Socket/ConnectedUDP.hpp"
+#include "PACC/Socket/Poller.hpp"
 #include "PACC/Socket/TCP.hpp"
 #include "PACC/Socket/TCPServer.hpp"
 #include "PACC/Socket/UDP.hpp"
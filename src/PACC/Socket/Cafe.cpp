@@ -245,11 +245,13 @@ void Socket::Cafe::sendMessage(const string& inMessage, unsigned int inCompressi
 
 
 /*!
-WARNING: in order to enable message compression/uncompression, this class needs to be compiled with variable PACC_ZLIB set.
+WARNING: in order to enable message compression/uncompression, this class needs to be compiled with variable PACC_ZLIB set. Otherwise, a Socket::Exception is thrown.
 */
-#ifdef PACC_ZLIB
 void Socket::Cafe::uncompress(std::string& ioMessage, unsigned long inUncompressedSize)
 {
+#ifndef PACC_ZLIB
+	throw Exception(eOtherError, "Cafe::uncompress() class needs to be compiled with variable PACC_ZLIB set, in order to enable message decompression");
+#else
 	string lUncompressedMessage;
 	lUncompressedMessage.resize(inUncompressedSize);
 	int lReturn = ::uncompress((Bytef*)&lUncompressedMessage[0], (uLong*)&inUncompressedSize, (const Bytef*)ioMessage.data(), ioMessage.size());
@@ -257,5 +259,5 @@ void Socket::Cafe::uncompress(std::string& ioMessage, unsigned long inUncompress
 		throw Exception(eOtherError, "Cafe::uncompress() unable to uncompress message!");
 	}
 	ioMessage = lUncompressedMessage;
-}
 #endif
+}
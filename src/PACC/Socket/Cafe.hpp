@@ -85,6 +85,42 @@ namespace PACC {
 			//! Send string message \c inMessage to connected server using the cafe protocol.
 			void sendMessage(const string& inMessage, unsigned int inCompressionLevel = 0);
 			
+#ifdef PACC_COROUTINES
+			/*! \brief Receive string message using the cafe protocol, without blocking a thread (requires C++20).
+			
+			The returned coroutine resolves to the received message (see Cafe::receiveMessage), suspending whenever the socket has no data (see class Poller). There is no time out. Any error raises a Socket::Exception into the awaiting coroutine.
+			*/
+			Threading::CoTask<string> receiveMessageAsync(void) {
+				if(mDescriptor < 0) throw Exception(eBadDescriptor, "Cafe::receiveMessageAsync() invalid socket");
+				unsigned char lHeader[8];
+				co_await receiveAsync((char*) lHeader, 8);
+				unsigned long lSignature = decodeWord(lHeader);
+				unsigned long lMessageSize = decodeWord(lHeader+4);
+				if(lSignature != 0xCAFE && lSignature != 0xCCAFE) throw Exception(eBadMessage, "Cafe::receiveMessageAsync() invalid signature");
+				unsigned long lUncompressedSize = 0;
+				if(lSignature == 0xCCAFE) {
+					co_await receiveAsync((char*) lHeader, 4);
+					lUncompressedSize = decodeWord(lHeader);
+				}
+				string lMessage(lMessageSize, '\0');
+				co_await receiveAsync(&lMessage[0], lMessageSize);
+				if(lSignature == 0xCCAFE) uncompress(lMessage, lUncompressedSize);
+				co_return lMessage;
+			}
+			
+			/*! \brief Send string message \c inMessage using the cafe protocol, without blocking a thread (requires C++20).
+			
+			The message is always sent uncompressed. The returned coroutine completes once the whole message has been sent, suspending whenever the socket send buffer is full (see class Poller). There is no time out. Any error raises a Socket::Exception into the awaiting coroutine.
+			*/
+			Threading::CoTask<void> sendMessageAsync(string inMessage) {
+				string lFrame(8, '\0');
+				encodeWord(0xCAFE, (unsigned char*) &lFrame[0]);
+				encodeWord(inMessage.size(), (unsigned char*) &lFrame[4]);
+				lFrame += inMessage;
+				co_await sendAsync(lFrame.data(), lFrame.size());
+			}
+#endif // PACC_COROUTINES
+			
 		 protected:
 			//! Compress string \c inMessage using compression level \c inCompressionLevel, and return result through string \c outMessage.
 			void compress(const string& inMessage, string& outMessage, unsigned int inCompressionLevel);
@@ -94,6 +130,25 @@ namespace PACC {
 			
 			//! Receive \c inCount bytes from socket.
 			void receive(char* inBuffer, unsigned int inCount);
+			
+#ifdef PACC_COROUTINES
+			//! Receive \c inCount bytes from socket, without blocking a thread (requires C++20).
+			Threading::CoTask<void> receiveAsync(char* outBuffer, unsigned int inCount) {
+				unsigned int lTotalReceived = 0;
+				while(lTotalReceived < inCount) lTotalReceived += co_await Port::receiveAsync(outBuffer+lTotalReceived, inCount-lTotalReceived);
+			}
+			
+			//! Return double word \c inBytes decoded from network order.
+			static unsigned long decodeWord(const unsigned char* inBytes) {
+				return ((unsigned long) inBytes[0] << 24) | ((unsigned long) inBytes[1] << 16) | ((unsigned long) inBytes[2] << 8) | inBytes[3];
+			}
+			
+			//! Encode double word \c inWord in network order into \c outBytes.
+			static void encodeWord(unsigned long inWord, unsigned char* outBytes) {
+				outBytes[0] = (unsigned char) (inWord >> 24); outBytes[1] = (unsigned char) (inWord >> 16);
+				outBytes[2] = (unsigned char) (inWord >> 8); outBytes[3] = (unsigned char) inWord;
+			}
+#endif // PACC_COROUTINES
 		};
 		
 	} // end of Socket namespace
@@ -0,0 +1,324 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Socket/Poller.cpp
+ * \brief Class methods for the socket readiness poller.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#include "PACC/Socket/Poller.hpp"
+#include "PACC/Socket/Exception.hpp"
+#include "PACC/config.hpp"
+#include <atomic>
+#include <vector>
+
+#ifdef PACC_SOCKET_WIN32
+///////////// specifics for windows /////////////
+#include <winsock2.h>
+#define ErrNo WSAGetLastError() // descriptor of last error
+
+#else
+///////////// specifics for unixes /////////////
+#define ErrNo errno // descriptor of last error
+#include <sys/errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#ifdef PACC_EPOLL
+#include <sys/epoll.h>
+#else
+#include <poll.h>
+#endif
+#endif
+
+using namespace std;
+using namespace PACC;
+
+namespace {
+	
+	//! Process-wide poller, once created (see Poller::getDefault).
+	atomic<Socket::Poller*> gDefault(0);
+	
+}
+
+/*!
+The poller thread is started immediately. Any error raises a Socket::Exception.
+*/
+Socket::Poller::Poller(void) : mPoll(-1), mShutdown(false), mThread(0)
+{
+	mWakeup[0] = mWakeup[1] = -1;
+#ifndef PACC_SOCKET_WIN32
+	if(::pipe(mWakeup) != 0) throw Exception(ErrNo, "Poller::Poller() unable to create pipe");
+	::fcntl(mWakeup[0], F_SETFL, O_NONBLOCK);
+	::fcntl(mWakeup[1], F_SETFL, O_NONBLOCK);
+#endif
+#ifdef PACC_EPOLL
+	if((mPoll = ::epoll_create(64)) < 0) throw Exception(ErrNo, "Poller::Poller() unable to create epoll descriptor");
+	epoll_event lEvent;
+	lEvent.events = EPOLLIN;
+	lEvent.data.fd = mWakeup[0];
+	if(::epoll_ctl(mPoll, EPOLL_CTL_ADD, mWakeup[0], &lEvent) != 0) throw Exception(ErrNo, "Poller::Poller() unable to watch pipe");
+#endif
+	mThread = new PollThread(this);
+}
+
+/*!
+The poller thread is terminated. Pending watches are discarded without calling their callbacks.
+*/
+Socket::Poller::~Poller(void)
+{
+	Poller* lThis = this;
+	gDefault.compare_exchange_strong(lThis, 0);
+	mMutex.lock();
+	mShutdown = true;
+	mMutex.unlock();
+	wake();
+	delete mThread;
+#ifdef PACC_EPOLL
+	::close(mPoll);
+#endif
+#ifndef PACC_SOCKET_WIN32
+	::close(mWakeup[0]);
+	::close(mWakeup[1]);
+#endif
+}
+
+/*!
+Pending watches of descriptor \c inDescriptor are removed without calling their callbacks. If \c outCallbacks is not null, the callbacks are appended to it, so that the caller can call them itself, once the descriptor is closed. This method must be called before closing a descriptor that may still be watched: a closed descriptor leaves the native poller silently, and its watches would otherwise never fire, nor could its number be watched again once reused.
+*/
+void Socket::Poller::cancel(int inDescriptor, vector<function<void()> >* outCallbacks)
+{
+	mMutex.lock();
+	map<int, Watch>::iterator lIter = mWatches.find(inDescriptor);
+	if(lIter != mWatches.end()) {
+		if(outCallbacks) {
+			if(lIter->second.mReadable) outCallbacks->push_back(lIter->second.mReadable);
+			if(lIter->second.mWritable) outCallbacks->push_back(lIter->second.mWritable);
+		}
+#ifdef PACC_EPOLL
+		if(lIter->second.mRegistered) {
+			epoll_event lEvent;
+			::epoll_ctl(mPoll, EPOLL_CTL_DEL, inDescriptor, &lEvent);
+		}
+#endif
+		mWatches.erase(lIter);
+	}
+	mMutex.unlock();
+}
+
+/*! \brief Dispatch events until the poller is deleted (poller thread).
+
+The callbacks of ready descriptors are removed from their watches under the mutex, and then called without it, so that they can add new watches.
+*/
+void Socket::Poller::dispatch(void)
+{
+	vector<function<void()> > lCallbacks;
+#ifdef PACC_EPOLL
+	epoll_event lEvents[64];
+	for(;;) {
+		int lCount = ::epoll_wait(mPoll, lEvents, 64, -1);
+		mMutex.lock();
+		if(mShutdown) {
+			mMutex.unlock();
+			return;
+		}
+		for(int i = 0; i < lCount; ++i) {
+			int lDescriptor = lEvents[i].data.fd;
+			if(lDescriptor == mWakeup[0]) {
+				char lBuffer[64];
+				while(::read(mWakeup[0], lBuffer, sizeof(lBuffer)) > 0);
+				continue;
+			}
+			map<int, Watch>::iterator lIter = mWatches.find(lDescriptor);
+			if(lIter == mWatches.end()) continue;
+			Watch& lWatch = lIter->second;
+			unsigned int lReady = lEvents[i].events;
+			if((lReady & (EPOLLIN | EPOLLHUP | EPOLLERR)) && lWatch.mReadable) {
+				lCallbacks.push_back(lWatch.mReadable);
+				lWatch.mReadable = function<void()>();
+			}
+			if((lReady & (EPOLLOUT | EPOLLHUP | EPOLLERR)) && lWatch.mWritable) {
+				lCallbacks.push_back(lWatch.mWritable);
+				lWatch.mWritable = function<void()>();
+			}
+			// watches are one-shot: rearm the remaining event, if any
+			if(lWatch.mReadable || lWatch.mWritable) {
+				epoll_event lEvent;
+				lEvent.events = getMask(lWatch);
+				lEvent.data.fd = lDescriptor;
+				::epoll_ctl(mPoll, EPOLL_CTL_MOD, lDescriptor, &lEvent);
+			}
+		}
+		mMutex.unlock();
+		for(size_t i = 0; i < lCallbacks.size(); ++i) lCallbacks[i]();
+		lCallbacks.clear();
+	}
+#else
+#ifdef PACC_SOCKET_WIN32
+	vector<WSAPOLLFD> lDescriptors;
+#else
+	vector<pollfd> lDescriptors;
+#endif
+	for(;;) {
+		// gather watched descriptors
+		mMutex.lock();
+		if(mShutdown) {
+			mMutex.unlock();
+			return;
+		}
+		lDescriptors.clear();
+#ifndef PACC_SOCKET_WIN32
+		lDescriptors.resize(1);
+		lDescriptors[0].fd = mWakeup[0];
+		lDescriptors[0].events = POLLIN;
+#endif
+		for(map<int, Watch>::iterator lIter = mWatches.begin(); lIter != mWatches.end(); ++lIter) {
+			if(!lIter->second.mReadable && !lIter->second.mWritable) continue;
+			lDescriptors.resize(lDescriptors.size()+1);
+			lDescriptors.back().fd = lIter->first;
+			lDescriptors.back().events = (lIter->second.mReadable ? POLLIN : 0) | (lIter->second.mWritable ? POLLOUT : 0);
+		}
+		mMutex.unlock();
+		for(size_t i = 0; i < lDescriptors.size(); ++i) lDescriptors[i].revents = 0;
+#ifdef PACC_SOCKET_WIN32
+		// there is no pipe to wake up the thread: poll new watches every 10 milliseconds
+		if(lDescriptors.empty()) {
+			Threading::Thread::sleep(0.01);
+			continue;
+		}
+		if(::WSAPoll(&lDescriptors[0], (ULONG) lDescriptors.size(), 10) <= 0) continue;
+#else
+		if(::poll(&lDescriptors[0], lDescriptors.size(), -1) <= 0) continue;
+#endif
+		// collect callbacks of ready descriptors
+		mMutex.lock();
+		for(size_t i = 0; i < lDescriptors.size(); ++i) {
+			short lReady = lDescriptors[i].revents;
+			if(lReady == 0) continue;
+#ifndef PACC_SOCKET_WIN32
+			if(i == 0) {
+				char lBuffer[64];
+				while(::read(mWakeup[0], lBuffer, sizeof(lBuffer)) > 0);
+				continue;
+			}
+#endif
+			map<int, Watch>::iterator lIter = mWatches.find((int) lDescriptors[i].fd);
+			if(lIter == mWatches.end()) continue;
+			Watch& lWatch = lIter->second;
+			if((lReady & (POLLIN | POLLHUP | POLLERR | POLLNVAL)) && lWatch.mReadable) {
+				lCallbacks.push_back(lWatch.mReadable);
+				lWatch.mReadable = function<void()>();
+			}
+			if((lReady & (POLLOUT | POLLHUP | POLLERR | POLLNVAL)) && lWatch.mWritable) {
+				lCallbacks.push_back(lWatch.mWritable);
+				lWatch.mWritable = function<void()>();
+			}
+			if(!lWatch.mReadable && !lWatch.mWritable) mWatches.erase(lIter);
+		}
+		mMutex.unlock();
+		for(size_t i = 0; i < lCallbacks.size(); ++i) lCallbacks[i]();
+		lCallbacks.clear();
+	}
+#endif
+}
+
+/*!
+\return Process-wide poller, or null if it was not created yet (or was already deleted at program exit).
+*/
+Socket::Poller* Socket::Poller::findDefault(void)
+{
+	return gDefault.load(memory_order_acquire);
+}
+
+/*!
+The poller is created on first use, and deleted at program exit.
+*/
+Socket::Poller& Socket::Poller::getDefault(void)
+{
+	static Poller lPoller;
+	if(!gDefault.load(memory_order_relaxed)) gDefault.store(&lPoller, memory_order_release);
+	return lPoller;
+}
+
+#ifdef PACC_EPOLL
+//! Return the one-shot epoll event mask of the pending callbacks of watch \c inWatch.
+unsigned int Socket::Poller::getMask(const Watch& inWatch)
+{
+	unsigned int lMask = EPOLLONESHOT;
+	if(inWatch.mReadable) lMask |= EPOLLIN;
+	if(inWatch.mWritable) lMask |= EPOLLOUT;
+	return lMask;
+}
+#endif
+
+/*! \brief Call function \c inCallback once descriptor \c inDescriptor is ready for event \c inEvent.
+
+The callback is called only once, from the poller thread (see class Poller). A descriptor can be watched for both events at the same time, but only once per event: a Socket::Exception is thrown if the descriptor is already watched for \c inEvent, or if the descriptor is invalid.
+*/
+void Socket::Poller::watch(int inDescriptor, Event inEvent, const function<void()>& inCallback)
+{
+	if(inDescriptor < 0) throw Exception(eBadDescriptor, "Poller::watch() invalid socket");
+	mMutex.lock();
+	Watch& lWatch = mWatches[inDescriptor];
+	function<void()>& lCallback = (inEvent == eReadable ? lWatch.mReadable : lWatch.mWritable);
+	if(lCallback) {
+		mMutex.unlock();
+		throw Exception(eOtherError, "Poller::watch() descriptor is already watched for this event");
+	}
+	lCallback = inCallback;
+#ifdef PACC_EPOLL
+	epoll_event lEvent;
+	lEvent.events = getMask(lWatch);
+	lEvent.data.fd = inDescriptor;
+	int lResult = ::epoll_ctl(mPoll, lWatch.mRegistered ? EPOLL_CTL_MOD : EPOLL_CTL_ADD, inDescriptor, &lEvent);
+	// a closed descriptor leaves epoll by itself, and its number may have been reused
+	if(lResult != 0 && errno == ENOENT) lResult = ::epoll_ctl(mPoll, EPOLL_CTL_ADD, inDescriptor, &lEvent);
+	else if(lResult != 0 && errno == EEXIST) lResult = ::epoll_ctl(mPoll, EPOLL_CTL_MOD, inDescriptor, &lEvent);
+	if(lResult != 0) {
+		int lCode = ErrNo;
+		lCallback = function<void()>();
+		mMutex.unlock();
+		throw Exception(lCode, "Poller::watch() unable to watch descriptor");
+	}
+	lWatch.mRegistered = true;
+	mMutex.unlock();
+#else
+	mMutex.unlock();
+	wake();
+#endif
+}
+
+//! Wake up the poller thread.
+void Socket::Poller::wake(void)
+{
+#ifndef PACC_SOCKET_WIN32
+	char lByte = 0;
+	if(::write(mWakeup[1], &lByte, 1) < 0) {} // pipe is full: the thread is awake anyway
+#endif
+}
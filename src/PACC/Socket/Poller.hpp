@@ -0,0 +1,164 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Socket/Poller.hpp
+ * \brief Class definition for the socket readiness poller.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#ifndef PACC_Socket_Poller_hpp_
+#define PACC_Socket_Poller_hpp_
+
+#include "PACC/Threading/CoTask.hpp"
+#include "PACC/Threading/Mutex.hpp"
+#include "PACC/Threading/Thread.hpp"
+#include <functional>
+#include <map>
+#include <vector>
+
+namespace PACC { 
+	
+	using namespace std;
+	
+	namespace Socket {
+		
+		/*! \brief Notifier of socket readiness.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Socket
+		
+		This class watches any number of socket descriptors with a single thread, and calls a function once a descriptor becomes readable or writable (see Poller::watch). Every watch is one-shot: it fires once, and must be renewed for the next event. Errors and connection hangups fire both kinds of watches, so that the next operation on the socket reports them.
+		
+		Under Linux, the poller is based on \c epoll, and its cost does not depend on the number of watched descriptors. Other Unix systems use \c poll, with a pipe to wake up the thread when a watch is added. Under Windows, \c WSAPoll is used, and new watches are noticed within 10 milliseconds.
+		
+		A descriptor that is closed must first be removed from the poller (see Poller::cancel); class Port does it when a socket is closed, and then calls the pending callbacks, so that the coroutines suspended on the socket resume and receive a Socket::Exception with code Socket::eBadDescriptor. Callbacks run in the poller thread, and should therefore return quickly (e.g. push a task onto a thread pool). For C++20 coroutines, Poller::readable and Poller::writable return awaiters that resume the awaiting coroutine on its thread pool (see class Threading::CoTask); the asynchronous socket operations (e.g. Cafe::receiveMessageAsync) use the process-wide poller returned by Poller::getDefault.
+		*/
+		class Poller {
+			public:
+			//! Socket events.
+			enum Event {
+				eReadable = 1, //!< Data can be received (or the connection was closed).
+				eWritable = 2 //!< Data can be sent.
+			};
+			
+			Poller(void);
+			~Poller(void);
+			
+			void cancel(int inDescriptor, vector<function<void()> >* outCallbacks=0);
+			static Poller* findDefault(void);
+			static Poller& getDefault(void);
+			void watch(int inDescriptor, Event inEvent, const function<void()>& inCallback);
+			
+#ifdef PACC_COROUTINES
+			/*! \brief Awaiter of socket readiness (requires C++20).
+			\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+			\ingroup Socket
+			*/
+			class Awaiter {
+				public:
+				//! Construct awaiter of event \c inEvent for descriptor \c inDescriptor of poller \c inPoller.
+				Awaiter(Poller& inPoller, int inDescriptor, Event inEvent) : mPoller(inPoller), mDescriptor(inDescriptor), mEvent(inEvent) {}
+				
+				//! Always suspend.
+				bool await_ready(void) const noexcept {return false;}
+				//! Watch descriptor, and resume coroutine \c inHandle on its thread pool when ready.
+				template <class Promise>
+				void await_suspend(std::coroutine_handle<Promise> inHandle) {
+					Threading::ThreadPool* lPool = Threading::getCoroutinePool(inHandle);
+					std::coroutine_handle<> lHandle = inHandle;
+					mPoller.watch(mDescriptor, mEvent, [lHandle, lPool]() {Threading::resumeCoroutine(lHandle, lPool);});
+				}
+				//! Nothing to return.
+				void await_resume(void) const noexcept {}
+				
+				protected:
+				Poller& mPoller; //!< Poller of the descriptor.
+				int mDescriptor; //!< Watched descriptor.
+				Event mEvent; //!< Watched event.
+			};
+			
+			//! Return awaiter that suspends a coroutine until descriptor \c inDescriptor is readable (requires C++20).
+			Awaiter readable(int inDescriptor) {return Awaiter(*this, inDescriptor, eReadable);}
+			//! Return awaiter that suspends a coroutine until descriptor \c inDescriptor is writable (requires C++20).
+			Awaiter writable(int inDescriptor) {return Awaiter(*this, inDescriptor, eWritable);}
+#endif // PACC_COROUTINES
+			
+			protected:
+			/*! \brief Pending watches of a descriptor.
+			\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+			\ingroup Socket
+			*/
+			struct Watch {
+				function<void()> mReadable; //!< Callback of the readable event (empty if not watched).
+				function<void()> mWritable; //!< Callback of the writable event (empty if not watched).
+				bool mRegistered; //!< Descriptor is registered with the native poller (epoll only).
+				Watch(void) : mRegistered(false) {}
+			};
+			
+			/*! \brief Thread of a poller.
+			\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+			\ingroup Socket
+			*/
+			class PollThread : public Threading::Thread {
+				public:
+				//! Construct and start thread of poller \c inPoller.
+				PollThread(Poller* inPoller) : mPoller(inPoller) {run();}
+				//! Delete thread; wait for thread termination.
+				~PollThread(void) {wait(true);}
+				
+				protected:
+				Poller* mPoller; //!< Parent poller.
+				
+				//! Dispatch events until the poller is deleted.
+				void main(void) {mPoller->dispatch();}
+			};
+			
+			Threading::Mutex mMutex; //!< Mutex of the watches.
+			map<int, Watch> mWatches; //!< Watches indexed by descriptor.
+			int mPoll; //!< Native poller descriptor (epoll only).
+			int mWakeup[2]; //!< Pipe that wakes up the poller thread (Unix only).
+			bool mShutdown; //!< Poller is being deleted flag (protected by the mutex).
+			PollThread* mThread; //!< Poller thread.
+			
+			void dispatch(void);
+			static unsigned int getMask(const Watch& inWatch);
+			void wake(void);
+			
+			private:
+			//! restrict (disable) copy constructor.
+			Poller(const Poller&);
+			//! restrict (disable) assignment operator.
+			void operator=(const Poller&);
+		};
+		
+	} // end of Socket namespace
+	
+} // end of PACC namespace
+
+#endif // PACC_Socket_Poller_hpp_
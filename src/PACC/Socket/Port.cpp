@@ -90,9 +90,11 @@ Socket::Port::Port(Socket::Protocol inProtocol) : mDescriptor(INVALID_SOCKET)
 }
 
 /*!
+Pending asynchronous operations are abandoned: the watches of the socket are discarded without resuming them (see Port::close).
  */
 Socket::Port::~Port()
 {
+	if(mDescriptor != INVALID_SOCKET && Poller::findDefault()) Poller::findDefault()->cancel(mDescriptor);
 	close();
 }
 
@@ -135,22 +137,25 @@ void Socket::Port::bind(unsigned int inPortNumber)
 
 /*!
 This function will shutdown the connection and free the resources associated with the socket. It may block (linger) for a while, until the send buffer is empty. The linger delay can be set using function Port::setSockOpt with Socket::Option parameter \c eLinger. Any error raises a Socket::Exception.
+
+The socket is first removed from the default Poller, and once it is closed, the callbacks of its pending watches are called: asynchronous operations suspended on the socket (e.g. Port::receiveAsync) therefore resume, and fail with a Socket::Exception with code Socket::eBadDescriptor. Closing the socket is the usual way of aborting these operations, since they have no time out.
  */
 void Socket::Port::close()
 {
-	if(mDescriptor != INVALID_SOCKET) {
+	if(mDescriptor == INVALID_SOCKET) return;
+	vector<function<void()> > lCallbacks;
+	if(Poller::findDefault()) Poller::findDefault()->cancel(mDescriptor, &lCallbacks);
 #ifdef PACC_SOCKET_WIN32
-		::shutdown(mDescriptor, SD_BOTH);
-		if(::closesocket(mDescriptor) != 0)
+	::shutdown(mDescriptor, SD_BOTH);
+	bool lClosed = (::closesocket(mDescriptor) == 0);
 #else
-		::shutdown(mDescriptor, SHUT_RDWR);
-		if(::close(mDescriptor) != 0)
+	::shutdown(mDescriptor, SHUT_RDWR);
+	bool lClosed = (::close(mDescriptor) == 0);
 #endif
-		{
-			throw Exception(ErrNo, "Port::close() unable to close (or bad) socket descriptor");
-		}
-	}
+	int lError = ErrNo;
 	mDescriptor = INVALID_SOCKET;
+	for(size_t i = 0; i < lCallbacks.size(); ++i) lCallbacks[i]();
+	if(!lClosed) throw Exception(lError, "Port::close() unable to close (or bad) socket descriptor");
 }
 
 /*!
@@ -389,6 +394,77 @@ void Socket::Port::send(const char* inBuffer, unsigned int inCount)
 	}
 }
 
+/*!
+\return Number of sent characters, or -1 if the send buffer is full.
+
+This function sends to its peer socket as many of the \c inCount characters of buffer \c inBuffer as possible, without blocking (socket is assumed connected). It is used by the asynchronous operations (see Port::sendAsync), which wait for the socket to be writable when -1 is returned. Any other error raises a Socket::Exception, as for function Port::send.
+
+Since many threads may send at the same time, the SIGPIPE signal of a closed connection is suppressed for this call only (flag \c MSG_NOSIGNAL), rather than by changing the process-wide signal handler; the handler is only swapped on platforms without this flag.
+*/
+int Socket::Port::trySend(const char* inBuffer, unsigned int inCount)
+{
+	if(mDescriptor == INVALID_SOCKET) throw Exception(eBadDescriptor, "Port::trySend() invalid socket");
+#ifdef PACC_SOCKET_WIN32
+	u_long lMode = 1;
+	::ioctlsocket(mDescriptor, FIONBIO, &lMode);
+	int lSent = ::send(mDescriptor, inBuffer, inCount, 0);
+	int lError = ErrNo;
+	lMode = 0;
+	::ioctlsocket(mDescriptor, FIONBIO, &lMode);
+	bool lWouldBlock = (lSent < 0 && lError == WSAEWOULDBLOCK);
+#else
+#ifdef MSG_NOSIGNAL
+	int lSent = ::send(mDescriptor, inBuffer, inCount, MSG_NOSIGNAL | MSG_DONTWAIT);
+	int lError = ErrNo;
+#else
+	void(*lPipeMethod)(int) = ::signal(SIGPIPE, SIG_IGN);
+	int lSent = ::send(mDescriptor, inBuffer, inCount, MSG_DONTWAIT);
+	int lError = ErrNo;
+	::signal(SIGPIPE, lPipeMethod);
+#endif
+	bool lWouldBlock = (lSent < 0 && (lError == EAGAIN || lError == EWOULDBLOCK));
+#endif
+	if(lWouldBlock) return -1;
+	if(lSent < 0) {
+		throw Exception(lError, "Port::trySend() operation incomplete");
+	} else if(lSent < 1 && inCount > 0) {
+		close();
+		throw Exception(eConnectionClosed, "Port::trySend() operation incomplete");
+	}
+	return lSent;
+}
+
+/*!
+\return Number of received characters, or -1 if no data is available.
+
+This function receives up to \c inMaxCount characters of data into buffer \c outBuffer, without blocking. It is used by the asynchronous operations (see Port::receiveAsync), which wait for the socket to be readable when -1 is returned. Any other error raises a Socket::Exception, as for function Port::receive; in particular, an exception with code Socket::eConnectionClosed is thrown if the other party closed the connection. Receiving never raises SIGPIPE, so that the signal handler is left untouched.
+*/
+int Socket::Port::tryReceive(char* outBuffer, unsigned inMaxCount)
+{
+	if(mDescriptor == INVALID_SOCKET) throw Exception(eBadDescriptor, "Port::tryReceive() invalid socket");
+#ifdef PACC_SOCKET_WIN32
+	u_long lMode = 1;
+	::ioctlsocket(mDescriptor, FIONBIO, &lMode);
+	int lRecv = ::recv(mDescriptor, outBuffer, inMaxCount, 0);
+	int lError = ErrNo;
+	lMode = 0;
+	::ioctlsocket(mDescriptor, FIONBIO, &lMode);
+	bool lWouldBlock = (lRecv < 0 && lError == WSAEWOULDBLOCK);
+#else
+	int lRecv = ::recv(mDescriptor, outBuffer, inMaxCount, MSG_DONTWAIT);
+	int lError = ErrNo;
+	bool lWouldBlock = (lRecv < 0 && (lError == EAGAIN || lError == EWOULDBLOCK));
+#endif
+	if(lWouldBlock) return -1;
+	if(lRecv < 0) {
+		throw Exception(lError, "Port::tryReceive() operation incomplete");
+	} else if(lRecv == 0) {
+		close();
+		throw Exception(eConnectionClosed, "Port::tryReceive() operation incomplete");
+	}
+	return lRecv;
+}
+
 /*!
 This function sends to peer \c inPeer the data contained in buffer \c inBuffer (total of \c inCount characters). Any error raises a Socket::Exception. For instance, it throws an exception with code Socket::eConnectionClosed if the connection is closed by the other party during message transmission, or with code Socket::eTimeOut if the message cannot be sent before the time out period expires. The time out period can be changed using function Port::setSockOpt with parameter Socket::eSendTimeOut.
 */
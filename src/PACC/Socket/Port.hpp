@@ -38,6 +38,7 @@
 
 #include "PACC/Socket/Address.hpp"
 #include "PACC/Socket/Exception.hpp"
+#include "PACC/Socket/Poller.hpp"
 
 namespace PACC { 
 	
@@ -145,6 +146,39 @@ namespace PACC {
 			//! Send data to unconnected socket.
 			void sendTo(const char* inBuffer, unsigned int inCount, const Address& inPeer);
 			
+			//! Receive available data from connected socket without blocking; return -1 if none.
+			int tryReceive(char* outBuffer, unsigned inMaxCount);
+			
+			//! Send data to connected socket without blocking; return number of sent characters, or -1 if none.
+			int trySend(const char* inBuffer, unsigned int inCount);
+			
+#ifdef PACC_COROUTINES
+			/*! \brief Receive data from connected socket without blocking a thread (requires C++20).
+			
+			The returned coroutine resolves to the number of received characters (see Port::receive), suspending until the socket is readable (see class Poller). There is no time out. Any error raises a Socket::Exception into the awaiting coroutine.
+			*/
+			Threading::CoTask<unsigned int> receiveAsync(char* outBuffer, unsigned inMaxCount) {
+				for(;;) {
+					int lRecv = tryReceive(outBuffer, inMaxCount);
+					if(lRecv >= 0) co_return (unsigned int) lRecv;
+					co_await Poller::getDefault().readable(mDescriptor);
+				}
+			}
+			
+			/*! \brief Send data to connected socket without blocking a thread (requires C++20).
+			
+			The returned coroutine completes once all \c inCount characters of buffer \c inBuffer have been sent, suspending whenever the socket send buffer is full (see class Poller). The buffer must remain valid until completion. There is no time out. Any error raises a Socket::Exception into the awaiting coroutine.
+			*/
+			Threading::CoTask<void> sendAsync(const char* inBuffer, unsigned int inCount) {
+				unsigned int lTotalSent = 0;
+				while(lTotalSent < inCount) {
+					int lSent = trySend(inBuffer+lTotalSent, inCount-lTotalSent);
+					if(lSent >= 0) lTotalSent += lSent;
+					else co_await Poller::getDefault().writable(mDescriptor);
+				}
+			}
+#endif // PACC_COROUTINES
+			
 			//! Wait for activity.
 			bool waitForActivity(double inSeconds);
 			
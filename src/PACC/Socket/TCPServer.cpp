@@ -102,6 +102,7 @@ Upon return, the server is not binded to any port, nor listening to any connecti
 */
 Socket::TCPServer::TCPServer(void)
 {
+	setName("TCPServer");
 	setDefaultOptions();
 }
 
@@ -112,6 +113,7 @@ Any error raises a Socket::Exception (for example, if the requested port number
 */
 Socket::TCPServer::TCPServer(unsigned int inPortNumber, unsigned int inMinPending)
 {
+	setName("TCPServer");
 	setDefaultOptions();
 	Port::bind(inPortNumber);
 	Port::listen(inMinPending);
@@ -173,15 +175,15 @@ void Socket::TCPServer::setDefaultOptions()
 /*!
 Upon return, this method has added \c inThreads new threads to the server's thread pool. These new threads start accepting incomming connections immediately, and until some thread calls method TCPServer::halt. Incomming connections are processed through calls to virtual function TCPServer::main which needs to be overloaded in a sub-class. Halt requests will be honored at least every \c inMaxHaltDelay seconds (default=1), or after a connection terminates.
 
-This method can be called any number of times to increase the size of the thread pool. 
+This method can be called any number of times to increase the size of the thread pool. If argument \c inAffinity is not empty, the new threads are pinned to this set of processors (see Threading::Thread::setAffinity).
 
 \attention if the server was constructed using the default constructor, methods TCPServer::bind and TCPServer::listen must be called prior to calling this method. Otherwise, no incomming connection will ever be accepted, nor any error raised. Any error during the initialization of the new threads raises a Socket::Exception.
 */
-void Socket::TCPServer::run(unsigned int inThreads, double inMaxHaltDelay)
+void Socket::TCPServer::run(unsigned int inThreads, double inMaxHaltDelay, const vector<unsigned int>& inAffinity)
 {
 	// allocate new threads
 	for(unsigned int i = 0; i < inThreads; ++i) {
-		ServerThread* lThread = new ServerThread(this, inMaxHaltDelay);
+		ServerThread* lThread = new ServerThread(this, inMaxHaltDelay, inAffinity);
 		mThreadPool.push_back(lThread);
 	}
 }
@@ -56,8 +56,11 @@ namespace PACC {
 		*/
 		class ServerThread : public Threading::Thread {
 		 public:
-			//! Construct thread and link to server \c inServer.
-			ServerThread(Socket::TCPServer* inServer, double inMaxHaltDelay) : mServer(inServer), mMaxHaltDelay(inMaxHaltDelay) {run();}
+			//! Construct thread and link to server \c inServer; pin thread to processors \c inAffinity (if not empty).
+			ServerThread(Socket::TCPServer* inServer, double inMaxHaltDelay, const vector<unsigned int>& inAffinity=vector<unsigned int>()) : mServer(inServer), mMaxHaltDelay(inMaxHaltDelay) {
+				mAffinity = inAffinity;
+				run();
+			}
 			//! delete thread.
 			~ServerThread(void) {wait();}
 			
@@ -109,7 +112,7 @@ namespace PACC {
 			void open(void) {Port::open();}
 			
 			//! Start accepting incomming connections.
-			void run(unsigned int inThreads, double inMaxHaltDelay=1);
+			void run(unsigned int inThreads, double inMaxHaltDelay=1, const vector<unsigned int>& inAffinity=vector<unsigned int>());
 			
 			//! Wait for server termination.
 			void wait(void);
@@ -43,9 +43,25 @@
  * \brief Framework for multithreaded programming. 
  */
 
+#include "PACC/Threading/AtomicSemaphore.hpp"
+#include "PACC/Threading/Barrier.hpp"
+#include "PACC/Threading/CancellationToken.hpp"
+#include "PACC/Threading/ConcurrentHashMap.hpp"
+#include "PACC/Threading/Channel.hpp"
 #include "PACC/Threading/Condition.hpp"
+#include "PACC/Threading/CoTask.hpp"
+#include "PACC/Threading/Latch.hpp"
+#include "PACC/Threading/LockProfiler.hpp"
 #include "PACC/Threading/Mutex.hpp"
+#include "PACC/Threading/Parallel.hpp"
+#include "PACC/Threading/PartitionedThreadPool.hpp"
+#include "PACC/Threading/Pipeline.hpp"
+#include "PACC/Threading/RWLock.hpp"
+#include "PACC/Threading/ScheduledExecutor.hpp"
 #include "PACC/Threading/Semaphore.hpp"
+#include "PACC/Threading/TaskGraph.hpp"
 #include "PACC/Threading/Thread.hpp"
+#include "PACC/Threading/ThreadLocal.hpp"
 #include "PACC/Threading/ThreadPool.hpp"
 #include "PACC/Threading/TLS.hpp"
+#include "PACC/Threading/Topology.hpp"
@@ -0,0 +1,67 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/AtomicSemaphore.cpp
+ * \brief Class methods for the lock-free counting semaphore.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#include "PACC/Threading/AtomicSemaphore.hpp"
+#include "PACC/Util/Timer.hpp"
+
+using namespace std;
+using namespace PACC;
+
+/*! \brief Block up to \c inMaxTime seconds until a resource is acquired (slow path of AtomicSemaphore::wait).
+\return True if resource was acquired, false if timed out.
+
+The thread registers itself on the event count before checking the count a last time, so that a concurrent post cannot be missed.
+*/
+bool Threading::AtomicSemaphore::waitSlow(double inMaxTime)
+{
+	Timer lTimer;
+	for(;;) {
+		unsigned int lKey = mEvent.prepareWait();
+		if(tryWait()) {
+			mEvent.cancelWait();
+			return true;
+		}
+		double lRemaining = 0;
+		if(inMaxTime > 0) {
+			lRemaining = inMaxTime - lTimer.getValue();
+			if(lRemaining <= 0) {
+				mEvent.cancelWait();
+				return false;
+			}
+		}
+		if(!mEvent.wait(lKey, lRemaining)) return tryWait();
+		if(tryWait()) return true;
+	}
+}
@@ -0,0 +1,105 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/AtomicSemaphore.hpp
+ * \brief Class definition for the lock-free counting semaphore.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#ifndef PACC_Threading_AtomicSemaphore_hpp_
+#define PACC_Threading_AtomicSemaphore_hpp_
+
+#include "PACC/Threading/EventCount.hpp"
+
+namespace PACC { 
+	
+	namespace Threading {
+		
+		/*! \brief Counting semaphore with lock-free acquire and release.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		This class provides the same AtomicSemaphore::post, AtomicSemaphore::tryWait and AtomicSemaphore::wait operations as class Semaphore, but without any mutex. As long as resources are available, acquiring one is a single atomic compare-and-swap, and releasing one is a single atomic increment followed by an atomic load: no lock is taken and no system call is made. Only a thread that finds the count exhausted blocks, on an EventCount (i.e. a futex under Linux); a post wakes up blocked threads only if there are any.
+		
+		Contrary to class Semaphore, the count cannot be locked by the caller, and it cannot be set other than by posting. When several threads are blocked, the order in which they are released is undetermined, and a thread that calls AtomicSemaphore::wait while resources are available may overtake blocked threads.
+		*/
+		class AtomicSemaphore {
+			public:
+			//! Construct semaphore with initial count \c inCount.
+			explicit AtomicSemaphore(unsigned int inCount=0) : mCount(inCount) {}
+			
+			//! Return count of semaphore (may be outdated as soon as it is returned).
+			unsigned int getCount(void) const {return mCount.load(memory_order_relaxed);}
+			
+			//! Release \c inCount resources, and wake up as many blocked threads, if any.
+			void post(unsigned int inCount=1) {
+				mCount.fetch_add(inCount, memory_order_seq_cst);
+				mEvent.notify(inCount);
+			}
+			
+			/*! \brief Try to acquire one resource, but don't block if resources are exhausted. 
+			\return True if resource was acquired, false otherwise.
+			*/
+			bool tryWait(void) {
+				unsigned int lCount = mCount.load(memory_order_relaxed);
+				while(lCount > 0) {
+					if(mCount.compare_exchange_weak(lCount, lCount-1, memory_order_acquire, memory_order_relaxed)) return true;
+				}
+				return false;
+			}
+			
+			/*! \brief Wait up to \c inMaxTime seconds to acquire one resource. 
+			\return True if resource was acquired, false if timed out.
+			
+			A negative or null time out (default) means that the method should wait indefinitely (for a null time out, use method AtomicSemaphore::tryWait).
+			*/
+			bool wait(double inMaxTime=0) {
+				if(tryWait()) return true;
+				return waitSlow(inMaxTime);
+			}
+			
+			protected:
+			atomic<unsigned int> mCount; //!< Number of available resources.
+			EventCount mEvent; //!< Event count on which exhausted threads block.
+			
+			bool waitSlow(double inMaxTime);
+			
+			private:
+			//! restrict (disable) copy constructor.
+			AtomicSemaphore(const AtomicSemaphore&);
+			//! restrict (disable) assignment operator.
+			void operator=(const AtomicSemaphore&);
+		};
+		
+	} // end of Threading namespace
+	
+} // end of PACC namespace
+
+#endif // PACC_Threading_AtomicSemaphore_hpp_
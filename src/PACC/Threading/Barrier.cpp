@@ -0,0 +1,86 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/Barrier.cpp
+ * \brief Class methods for the reusable thread barrier.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#include "PACC/Threading/Barrier.hpp"
+#include "PACC/Threading/ThreadPool.hpp"
+#include "PACC/Threading/Topology.hpp"
+
+using namespace std;
+using namespace PACC;
+
+/*! \brief Construct barrier for \c inCount participating threads.
+
+Waiting threads spin for at most 1000 iterations, or never spin on single processor systems. A null count raises a Threading::Exception.
+*/
+Threading::Barrier::Barrier(unsigned int inCount) : mCount(inCount), mMaxSpin(0), mRemaining(inCount), mPhase(0)
+{
+	if(inCount == 0) throw Exception(eOtherError, "Barrier::Barrier() invalid count");
+	if(Topology::getCPUCount() > 1) mMaxSpin = 1000;
+}
+
+/*! \brief Wait for all participating threads to arrive at the barrier.
+\return True for a single thread per phase (the last one to arrive), false for the others.
+
+The returned value can be used to elect a thread that performs some serial work between two phases. A participant should call this method exactly once per phase.
+*/
+bool Threading::Barrier::wait(void)
+{
+	// read phase before arriving, since the last thread advances it
+	unsigned int lPhase = mPhase.load(memory_order_acquire);
+	if(mRemaining.fetch_sub(1, memory_order_acq_rel) == 1) {
+		// last thread: rearm the barrier, and release the others
+		mRemaining.store(mCount, memory_order_relaxed);
+		mPhase.fetch_add(1, memory_order_release);
+		mEvent.notifyAll();
+		return true;
+	}
+	for(unsigned int i = 0; i < mMaxSpin; ++i) {
+		if(mPhase.load(memory_order_acquire) != lPhase) return false;
+		Thread::pause();
+	}
+	SlaveThread* lSlave = SlaveThread::getCurrent();
+	for(;;) {
+		if(mPhase.load(memory_order_acquire) != lPhase) return false;
+		// help the pool of the calling slave, if any
+		if(lSlave && lSlave->getPool()->runPending()) continue;
+		unsigned int lKey = mEvent.prepareWait();
+		if(mPhase.load(memory_order_acquire) != lPhase) {
+			mEvent.cancelWait();
+			return false;
+		}
+		// a parked slave checks its pool again every millisecond
+		mEvent.wait(lKey, lSlave ? 0.001 : 0);
+	}
+}
@@ -0,0 +1,92 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/Barrier.hpp
+ * \brief Class definition for the reusable thread barrier.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#ifndef PACC_Threading_Barrier_hpp_
+#define PACC_Threading_Barrier_hpp_
+
+#include "PACC/Threading/EventCount.hpp"
+
+namespace PACC { 
+	
+	namespace Threading {
+		
+		/*! \brief Reusable barrier for phase synchronization.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		A barrier blocks a fixed number of participating threads (see constructor) until all of them have called Barrier::wait; they are then all released, and the barrier is immediately ready for the next phase. Here is a typical iterative solver:
+		\code
+Threading::Barrier lBarrier(lThreads);
+...
+// in each of the lThreads participants:
+for(unsigned int i = 0; i < lIterations; ++i) {
+	computeMyPart(i);
+	if(lBarrier.wait()) swapBuffers(); // a single participant per phase
+}
+		\endcode
+		
+		The barrier is sense-reversing: a phase counter is incremented by the last arriving thread, and waiting threads only watch this counter, so that a fast thread can enter the next phase without disturbing the threads that are leaving the previous one. Arriving is a single atomic decrement. Waiting threads first spin for a bounded number of iterations (on multiprocessor systems), and then park on an EventCount; the last arriving thread wakes them up with a single system call, and only if some thread is parked.
+		
+		When a waiting thread is a slave of a thread pool (see SlaveThread::getCurrent), it executes the pending tasks of its pool (see ThreadPool::runPending) before parking, instead of leaving its processor idle; while parked, it checks its pool again every millisecond. Note that a slave can only return from the barrier once the task that it is running completes; if this task waits on the same barrier, the barrier may deadlock. Participants should therefore not outnumber the slaves that can run them simultaneously.
+		*/
+		class Barrier {
+			public:
+			explicit Barrier(unsigned int inCount);
+			
+			//! Return number of participating threads.
+			unsigned int getCount(void) const {return mCount;}
+			//! Return number of completed phases.
+			unsigned int getPhase(void) const {return mPhase.load(memory_order_acquire);}
+			bool wait(void);
+			
+			protected:
+			unsigned int mCount; //!< Number of participating threads.
+			unsigned int mMaxSpin; //!< Maximum number of spin iterations before helping or parking.
+			atomic<unsigned int> mRemaining; //!< Number of threads that have not yet arrived in the current phase.
+			atomic<unsigned int> mPhase; //!< Number of completed phases.
+			EventCount mEvent; //!< Event count on which waiting threads park.
+			
+			private:
+			//! restrict (disable) copy constructor.
+			Barrier(const Barrier&);
+			//! restrict (disable) assignment operator.
+			void operator=(const Barrier&);
+		};
+		
+	} // end of Threading namespace
+	
+} // end of PACC namespace
+
+#endif // PACC_Threading_Barrier_hpp_
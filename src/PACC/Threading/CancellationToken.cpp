@@ -0,0 +1,99 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/CancellationToken.cpp
+ * \brief Class methods for cooperative cancellation tokens.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#include "PACC/Threading/CancellationToken.hpp"
+#include "PACC/Threading/Exception.hpp"
+
+using namespace std;
+using namespace PACC;
+
+/*! \brief Add state \c inChild as a child of this state.
+
+The child is canceled right away if this state is already canceled. Expired children (i.e. whose sources were all destroyed) are pruned whenever the child list must grow, so that a long lived parent does not accumulate them.
+*/
+void Threading::CancellationState::addChild(const shared_ptr<CancellationState>& inChild)
+{
+	mMutex.lock();
+	// the canceled flag is set before the child list is taken by cancel
+	if(mCanceled.load(memory_order_acquire)) {
+		mMutex.unlock();
+		inChild->cancel();
+		return;
+	}
+	if(mChildren.size() == mChildren.capacity()) {
+		size_t j = 0;
+		for(size_t i = 0; i < mChildren.size(); ++i) {
+			if(!mChildren[i].expired()) mChildren[j++] = mChildren[i];
+		}
+		mChildren.resize(j);
+	}
+	mChildren.push_back(inChild);
+	mMutex.unlock();
+}
+
+/*! \brief Cancel this state and its children.
+
+Only the first call has any effect. Children are canceled outside of the mutex of this state.
+*/
+void Threading::CancellationState::cancel(void)
+{
+	if(mCanceled.exchange(true, memory_order_acq_rel)) return;
+	vector<weak_ptr<CancellationState> > lChildren;
+	mMutex.lock();
+	lChildren.swap(mChildren);
+	mMutex.unlock();
+	for(size_t i = 0; i < lChildren.size(); ++i) {
+		shared_ptr<CancellationState> lChild = lChildren[i].lock();
+		if(lChild) lChild->cancel();
+	}
+}
+
+/*! \brief Throw a Threading::Exception with code Threading::eCanceled if the source of this token was canceled.
+
+This is a convenient way for a deeply nested computation to unwind once canceled; the exception is stored into the future of a task created by ThreadPool::submit.
+*/
+void Threading::CancellationToken::throwIfCanceled(void) const
+{
+	if(isCanceled()) throw Exception(eCanceled, "CancellationToken::throwIfCanceled() operation canceled");
+}
+
+/*! \brief Construct source as a child of token \c inParent.
+
+The child source is canceled whenever the source of \c inParent is canceled (immediately if it already is). If \c inParent cannot be canceled (i.e. was default constructed), the child is an independent source.
+*/
+Threading::CancellationSource::CancellationSource(const CancellationToken& inParent) : mState(make_shared<CancellationState>())
+{
+	if(inParent.mState) inParent.mState->addChild(mState);
+}
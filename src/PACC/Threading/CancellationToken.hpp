@@ -0,0 +1,139 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/CancellationToken.hpp
+ * \brief Class definition for cooperative cancellation tokens.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#ifndef PACC_Threading_CancellationToken_hpp_
+#define PACC_Threading_CancellationToken_hpp_
+
+#include "PACC/Threading/Mutex.hpp"
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace PACC { 
+	
+	using namespace std;
+	
+	namespace Threading {
+		
+		/*! \brief Shared state of a cancellation source and of its tokens.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		The canceled flag is an atomic boolean that is set only once. The state also keeps weak references to the states of its child sources, which are canceled along with it.
+		*/
+		class CancellationState {
+			public:
+			//! Construct state that is not canceled.
+			CancellationState(void) : mCanceled(false) {}
+			
+			void addChild(const shared_ptr<CancellationState>& inChild);
+			void cancel(void);
+			//! Return whether state is canceled.
+			bool isCanceled(void) const {return mCanceled.load(memory_order_acquire);}
+			
+			protected:
+			atomic<bool> mCanceled; //!< Canceled flag.
+			Mutex mMutex; //!< Mutex of child list.
+			vector<weak_ptr<CancellationState> > mChildren; //!< States of child sources.
+			
+			private:
+			//! restrict (disable) copy constructor.
+			CancellationState(const CancellationState&);
+			//! restrict (disable) assignment operator.
+			void operator=(const CancellationState&);
+		};
+		
+		/*! \brief Cancellation token, used to observe the cancellation of a CancellationSource.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		A token is obtained with method CancellationSource::getToken, and is cheap to copy, since all copies share the state of their source. Checking a token (see CancellationToken::isCanceled) is a single atomic load, so that long running computations can poll it often. A default constructed token can never be canceled.
+		*/
+		class CancellationToken {
+			public:
+			//! Construct token that can never be canceled.
+			CancellationToken(void) {}
+			
+			//! Return whether token has a source, i.e. whether it can be canceled.
+			bool canBeCanceled(void) const {return (bool)mState;}
+			//! Return whether the source of token was canceled.
+			bool isCanceled(void) const {return mState && mState->isCanceled();}
+			void throwIfCanceled(void) const;
+			
+			protected:
+			shared_ptr<CancellationState> mState; //!< Shared state of source.
+			
+			//! Construct token for shared state \c inState.
+			explicit CancellationToken(const shared_ptr<CancellationState>& inState) : mState(inState) {}
+			
+			friend class CancellationSource;
+		};
+		
+		/*! \brief Source of cooperative cancellation.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		A source hands out tokens (see CancellationSource::getToken) that are attached to tasks (see Task::setCancellationToken) or passed to any other computation. Calling CancellationSource::cancel marks all of its tokens as canceled: thread pools skip the tasks that have not started yet, and running tasks can poll their token (see Task::isCanceled) in order to return early. Cancellation is cooperative: a running task is never interrupted. Here is a simple usage example:
+		\code
+CancellationSource lClient;
+Future<int> lResult = lPool.submit([]() {return computeAnswer();}, lClient.getToken());
+...
+lClient.cancel(); // the function will not run if it has not started yet
+		\endcode
+		
+		A source can be constructed as the child of the token of another source (see CancellationSource(const CancellationToken&)): canceling the parent then cancels the child, but not the other way around. This allows, for example, to cancel all of the requests of a connection at once, or only one of them. Sources are cheap to copy, since all copies share the same state. Once canceled, a source stays canceled.
+		*/
+		class CancellationSource {
+			public:
+			//! Construct source that is not canceled.
+			CancellationSource(void) : mState(make_shared<CancellationState>()) {}
+			explicit CancellationSource(const CancellationToken& inParent);
+			
+			//! Cancel source, its tokens, and its child sources.
+			void cancel(void) {mState->cancel();}
+			//! Return a token of this source.
+			CancellationToken getToken(void) const {return CancellationToken(mState);}
+			//! Return whether source was canceled.
+			bool isCanceled(void) const {return mState->isCanceled();}
+			
+			protected:
+			shared_ptr<CancellationState> mState; //!< Shared state.
+		};
+		
+	} // end of Threading namespace
+	
+} // end of PACC namespace
+
+#endif // PACC_Threading_CancellationToken_hpp_
@@ -0,0 +1,217 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/Channel.hpp
+ * \brief Class definition for the bounded inter-thread channel.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#ifndef PACC_Threading_Channel_hpp_
+#define PACC_Threading_Channel_hpp_
+
+#include "PACC/Threading/EventCount.hpp"
+#include "PACC/Threading/MPMCQueue.hpp"
+#include "PACC/Threading/SPSCQueue.hpp"
+#include "PACC/Threading/Thread.hpp"
+#include "PACC/Threading/Topology.hpp"
+#include "PACC/Util/Timer.hpp"
+
+namespace PACC { 
+	
+	namespace Threading {
+		
+		/*! \brief Bounded channel for passing values between threads.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		A channel is a bounded FIFO queue of values of type \c T, with blocking and non-blocking operations. Blocking operations apply backpressure: Channel::push blocks while the channel is full, and Channel::pop blocks while it is empty. The non-blocking operations (Channel::tryPush, Channel::tryPop) return immediately. Values can also be exchanged in batches (Channel::pushN, Channel::popN), which amortizes the cost of synchronization over many small messages.
+		
+		The underlying lock-free queue is selected by template argument \c Queue:
+		- SPSCQueue<T> (default): a single producer thread and a single consumer thread;
+		- MPMCQueue<T>: any number of producer and consumer threads.
+		
+		The fast path of every operation is a lock-free queue operation followed by an EventCount notification, which costs a single atomic load when the other side is not blocked. A thread that must block first spins for a bounded number of iterations (on multiprocessor systems), and then parks on an EventCount.
+		
+		A channel can be closed by any thread (see Channel::close): producers can no longer push, and consumers receive the remaining values before their pop operations fail. Closing is the usual way of terminating the consumer of a pipeline stage:
+		\code
+Threading::Channel<Message*> lChannel(4096);
+...
+// consumer thread
+Message* lMessage;
+while(lChannel.pop(lMessage)) process(lMessage);
+		\endcode
+		*/
+		template <class T, class Queue=SPSCQueue<T> >
+		class Channel {
+			public:
+			//! Construct empty channel of capacity \c inCapacity (rounded up to a power of two).
+			Channel(size_t inCapacity=1024) : mQueue(inCapacity), mClosed(false), mMaxSpin(Topology::getCPUCount() > 1 ? 100 : 0) {}
+			
+			//! Close channel, and wake up all blocked threads.
+			void close(void) {
+				mClosed.store(true, memory_order_seq_cst);
+				mNotEmpty.notifyAll();
+				mNotFull.notifyAll();
+			}
+			
+			//! Return whether the channel is (momentarily) empty.
+			bool empty(void) const {return mQueue.empty();}
+			//! Return the capacity of the channel.
+			size_t getCapacity(void) const {return mQueue.getCapacity();}
+			//! Return whether the channel is closed.
+			bool isClosed(void) const {return mClosed.load(memory_order_acquire);}
+			//! Return the (momentary) number of values in the channel.
+			size_t size(void) const {return mQueue.size();}
+			
+			/*! \brief Remove value at the head of the channel into \c outValue, waiting up to \c inMaxTime seconds for one.
+			\return True if a value was removed; false if timed out, or if the channel is closed and empty.
+			
+			A negative or null time out (default) means that the method should wait indefinitely.
+			*/
+			bool pop(T& outValue, double inMaxTime=0) {
+				return popN(&outValue, 1, inMaxTime) == 1;
+			}
+			
+			/*! \brief Remove up to \c inMaxCount values at the head of the channel into array \c outValues, waiting up to \c inMaxTime seconds for at least one.
+			\return Number of removed values; 0 if timed out, or if the channel is closed and empty.
+			
+			The method does not wait for \c inMaxCount values: it returns as soon as it can remove some. A negative or null time out (default) means that the method should wait indefinitely.
+			*/
+			size_t popN(T* outValues, size_t inMaxCount, double inMaxTime=0) {
+				for(;;) {
+					size_t lCount = tryPopN(outValues, inMaxCount);
+					if(lCount > 0 || inMaxCount == 0) return lCount;
+					if(isClosed()) return tryPopN(outValues, inMaxCount);
+					if(!await(mNotEmpty, [this]() {return !mQueue.empty() || isClosed();}, inMaxTime)) return tryPopN(outValues, inMaxCount);
+				}
+			}
+			
+			/*! \brief Append value \c inValue at the tail of the channel, waiting while the channel is full.
+			\return True if the value was appended, false if the channel is closed.
+			*/
+			bool push(const T& inValue) {
+				return pushN(&inValue, 1) == 1;
+			}
+			
+			/*! \brief Append the \c inCount values of array \c inValues at the tail of the channel, waiting while the channel is full.
+			\return Number of appended values (less than \c inCount only if the channel is closed).
+			
+			Values are appended in as few batches as the free room of the channel allows, and consumers are notified after each batch.
+			*/
+			size_t pushN(const T* inValues, size_t inCount) {
+				size_t lPushed = 0;
+				while(lPushed < inCount && !isClosed()) {
+					lPushed += tryPushN(inValues+lPushed, inCount-lPushed);
+					if(lPushed < inCount) await(mNotFull, [this]() {return mQueue.size() < mQueue.getCapacity() || isClosed();}, 0);
+				}
+				return lPushed;
+			}
+			
+			//! Remove value at the head of the channel into \c outValue; return false if the channel is empty.
+			bool tryPop(T& outValue) {
+				return tryPopN(&outValue, 1) == 1;
+			}
+			
+			//! Remove up to \c inMaxCount values at the head of the channel into array \c outValues, without blocking; return the number of removed values.
+			size_t tryPopN(T* outValues, size_t inMaxCount) {
+				size_t lCount = mQueue.pop(outValues, inMaxCount);
+				if(lCount > 0) mNotFull.notify(lCount);
+				return lCount;
+			}
+			
+			//! Append value \c inValue at the tail of the channel; return false if the channel is full or closed.
+			bool tryPush(const T& inValue) {
+				return tryPushN(&inValue, 1) == 1;
+			}
+			
+			/*! \brief Append as many as possible of the \c inCount values of array \c inValues at the tail of the channel, without blocking.
+			\return Number of appended values (0 if the channel is full or closed).
+			*/
+			size_t tryPushN(const T* inValues, size_t inCount) {
+				if(isClosed()) return 0;
+				size_t lPushed = 0;
+				size_t lBatch = inCount < mQueue.getCapacity() ? inCount : mQueue.getCapacity();
+				// try the largest batch first, halving it until it fits
+				while(lPushed < inCount && lBatch > 0) {
+					if(lBatch > inCount-lPushed) lBatch = inCount-lPushed;
+					if(mQueue.push(inValues+lPushed, lBatch)) lPushed += lBatch;
+					else lBatch /= 2;
+				}
+				if(lPushed > 0) mNotEmpty.notify(lPushed);
+				return lPushed;
+			}
+			
+			protected:
+			Queue mQueue; //!< Lock-free queue of values.
+			atomic<bool> mClosed; //!< Channel is closed flag.
+			unsigned int mMaxSpin; //!< Maximum number of spin iterations before parking.
+			EventCount mNotEmpty; //!< Event count on which consumers park.
+			EventCount mNotFull; //!< Event count on which producers park.
+			
+			/*! \brief Wait up to \c inMaxTime seconds for predicate \c inReady to become true, using event count \c ioEvent.
+			\return False if timed out, true otherwise.
+			*/
+			template <class Predicate>
+			bool await(EventCount& ioEvent, Predicate inReady, double inMaxTime) {
+				for(unsigned int i = 0; i < mMaxSpin; ++i) {
+					if(inReady()) return true;
+					Thread::pause();
+				}
+				Timer lTimer;
+				for(;;) {
+					unsigned int lKey = ioEvent.prepareWait();
+					if(inReady()) {
+						ioEvent.cancelWait();
+						return true;
+					}
+					double lRemaining = 0;
+					if(inMaxTime > 0) {
+						lRemaining = inMaxTime - lTimer.getValue();
+						if(lRemaining <= 0) {
+							ioEvent.cancelWait();
+							return false;
+						}
+					}
+					if(!ioEvent.wait(lKey, lRemaining)) return inReady();
+				}
+			}
+			
+			private:
+			//! restrict (disable) copy constructor.
+			Channel(const Channel&);
+			//! restrict (disable) assignment operator.
+			void operator=(const Channel&);
+		};
+		
+	} // end of Threading namespace
+	
+} // end of PACC namespace
+
+#endif // PACC_Threading_Channel_hpp_
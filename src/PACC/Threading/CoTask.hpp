@@ -0,0 +1,414 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/CoTask.hpp
+ * \brief Class definition for the coroutine tasks (requires C++20).
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#ifndef PACC_Threading_CoTask_hpp_
+#define PACC_Threading_CoTask_hpp_
+
+// coroutines are only available to code compiled as C++20 (the library itself is not)
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#define PACC_COROUTINES
+#endif
+#endif
+
+#ifdef PACC_COROUTINES
+
+#include "PACC/Threading/Exception.hpp"
+#include "PACC/Threading/Future.hpp"
+#include "PACC/Threading/ThreadPool.hpp"
+#include <coroutine>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace PACC { 
+	
+	using namespace std;
+	
+	namespace Threading {
+		
+		template <class T> class CoTask;
+		
+		/*! \brief %Task that resumes a suspended coroutine.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		This task is pushed as a detached task (see ThreadPool::pushDetached), and is deleted by the thread pool after it has run.
+		*/
+		class CoResumeTask : public Task {
+			public:
+			//! Construct task that resumes coroutine \c inHandle.
+			explicit CoResumeTask(coroutine_handle<> inHandle) : mHandle(inHandle) {}
+			
+			//! Resume coroutine.
+			void main(void) {mHandle.resume();}
+			
+			protected:
+			coroutine_handle<> mHandle; //!< Coroutine to resume.
+		};
+		
+		/*! \brief Promise of a coroutine task, without its value.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		The promise records the thread pool on which the coroutine resumes after suspension, the coroutine that awaits its completion (if any), and the exception that it has thrown (if any).
+		*/
+		class CoPromiseBase {
+			public:
+			//! Return thread pool of the coroutine (null if it resumes in the thread that wakes it up).
+			ThreadPool* getPool(void) const {return mPool;}
+			//! Do not start coroutine before it is awaited or run.
+			suspend_always initial_suspend(void) noexcept {return suspend_always();}
+			//! Set thread pool of the coroutine to \c inPool.
+			void setPool(ThreadPool* inPool) {mPool = inPool;}
+			//! Store exception that escaped the coroutine.
+			void unhandled_exception(void) {mException = current_exception();}
+			
+			protected:
+			ThreadPool* mPool = 0; //!< Thread pool of the coroutine.
+			coroutine_handle<> mContinuation; //!< Coroutine that awaits this one.
+			exception_ptr mException; //!< Exception thrown by the coroutine.
+			
+			template <class T> friend class CoTask;
+			friend class CoFinalAwaiter;
+		};
+		
+		/*! \brief Return thread pool of the coroutine \c inHandle.
+		
+		The pool is null if the coroutine is not a coroutine task (see class CoTask), or if it has no pool.
+		*/
+		template <class Promise>
+		ThreadPool* getCoroutinePool(coroutine_handle<Promise> inHandle)
+		{
+			if constexpr(is_base_of<CoPromiseBase, Promise>::value) return inHandle.promise().getPool();
+			else return 0;
+		}
+		
+		//! Resume coroutine \c inHandle on thread pool \c inPool, or in the calling thread if \c inPool is null.
+		inline void resumeCoroutine(coroutine_handle<> inHandle, ThreadPool* inPool)
+		{
+			if(inPool) inPool->pushDetached(new CoResumeTask(inHandle));
+			else inHandle.resume();
+		}
+		
+		/*! \brief Awaiter of the final suspension point of a coroutine task.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		A completed coroutine transfers control to the coroutine that awaits it, if any. A coroutine that was started with CoTask::run instead publishes its result into its future, and destroys itself.
+		*/
+		class CoFinalAwaiter {
+			public:
+			//! Always suspend.
+			bool await_ready(void) noexcept {return false;}
+			//! Resume awaiting coroutine, or publish result of coroutine \c inHandle.
+			template <class Promise>
+			coroutine_handle<> await_suspend(coroutine_handle<Promise> inHandle) noexcept {
+				Promise& lPromise = inHandle.promise();
+				if(lPromise.mContinuation) return lPromise.mContinuation;
+				if(lPromise.mResult) {
+					lPromise.publish();
+					inHandle.destroy();
+				}
+				return noop_coroutine();
+			}
+			//! Nothing to do (never resumed).
+			void await_resume(void) noexcept {}
+		};
+		
+		/*! \brief Promise of a coroutine task of type \c T.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		*/
+		template <class T>
+		class CoPromise : public CoPromiseBase {
+			public:
+			CoTask<T> get_return_object(void);
+			//! Return final awaiter.
+			CoFinalAwaiter final_suspend(void) noexcept {return CoFinalAwaiter();}
+			//! Return value of the coroutine, or throw its exception.
+			T& getValue(void) {
+				if(mException) rethrow_exception(mException);
+				return *mValue;
+			}
+			//! Store value \c inValue returned by the coroutine.
+			template <class U>
+			void return_value(U&& inValue) {mValue.emplace(std::forward<U>(inValue));}
+			
+			protected:
+			optional<T> mValue; //!< Returned value.
+			shared_ptr<FutureState<T> > mResult; //!< Future state (if started with CoTask::run).
+			
+			//! Publish result into future state.
+			void publish(void) {
+				if(mException) mResult->setException(mException);
+				else mResult->setValue(std::move(*mValue));
+			}
+			
+			friend class CoTask<T>;
+			friend class CoFinalAwaiter;
+		};
+		
+		/*! \brief Promise of a coroutine task without value.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		*/
+		template <>
+		class CoPromise<void> : public CoPromiseBase {
+			public:
+			CoTask<void> get_return_object(void);
+			//! Return final awaiter.
+			CoFinalAwaiter final_suspend(void) noexcept {return CoFinalAwaiter();}
+			//! Throw exception of the coroutine, if any.
+			void getValue(void) {if(mException) rethrow_exception(mException);}
+			//! Coroutine returns.
+			void return_void(void) {}
+			
+			protected:
+			shared_ptr<FutureState<void> > mResult; //!< Future state (if started with CoTask::run).
+			
+			//! Publish result into future state.
+			void publish(void) {
+				if(mException) mResult->setException(mException);
+				else mResult->setValue();
+			}
+			
+			friend class CoTask<void>;
+			friend class CoFinalAwaiter;
+		};
+		
+		/*! \brief Coroutine task returning a value of type \c T (requires C++20).
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		A function that returns a CoTask and uses \c co_await or \c co_return is a coroutine. It does not start when called: it starts either when awaited by another coroutine task (which then resumes when it completes, and receives its value or exception), or when run on a thread pool (see CoTask::run), which returns a Future of its value. A coroutine task runs on the thread pool of the coroutine that awaits it, and whenever it suspends (e.g. waiting for a socket, see Socket::Poller), it releases its thread, and is resumed later by a task of this pool. Thousands of suspended coroutines thus cost no thread at all, while their code remains sequential:
+		\code
+CoTask<void> session(Socket::Cafe* inSocket)
+{
+	for(;;) {
+		string lRequest = co_await inSocket->receiveMessageAsync();
+		string lAnswer = co_await lPool.submit([&]() {return process(lRequest);});
+		co_await inSocket->sendMessageAsync(lAnswer);
+	}
+}
+...
+session(lSocket).run(lPool);
+		\endcode
+		
+		Coroutines can also await a Future (see operator co_await(const Future<T>&)), and move to another thread pool (see function resumeOn). A coroutine task object owns its coroutine until it is run; it cannot be copied, only moved.
+		
+		This class and the awaitable operations that build on it are only defined when the including code is compiled with C++20 coroutine support (macro PACC_COROUTINES is then defined).
+		*/
+		template <class T=void>
+		class CoTask {
+			public:
+			typedef CoPromise<T> promise_type;
+			
+			//! Construct invalid task.
+			CoTask(void) {}
+			//! Construct task that owns coroutine \c inHandle.
+			explicit CoTask(coroutine_handle<promise_type> inHandle) : mHandle(inHandle) {}
+			//! Move task \c ioTask into a new task.
+			CoTask(CoTask&& ioTask) noexcept : mHandle(ioTask.mHandle) {ioTask.mHandle = nullptr;}
+			//! Destroy coroutine (if not run).
+			~CoTask(void) {if(mHandle) mHandle.destroy();}
+			
+			//! Move task \c ioTask into this task.
+			CoTask& operator=(CoTask&& ioTask) noexcept {
+				if(this != &ioTask) {
+					if(mHandle) mHandle.destroy();
+					mHandle = ioTask.mHandle;
+					ioTask.mHandle = nullptr;
+				}
+				return *this;
+			}
+			
+			//! Return whether this task owns a coroutine.
+			bool isValid(void) const {return (bool) mHandle;}
+			
+			/*! \brief Start coroutine on thread pool \c inPool.
+			\return Future of the value of the coroutine.
+			
+			The coroutine is resumed by a task of \c inPool, and this object releases it: it destroys itself once completed, after setting the returned future. Throws a Threading::Exception if this task is invalid (e.g. already run).
+			*/
+			Future<T> run(ThreadPool& inPool) {
+				if(!mHandle) throw Exception(eOtherError, "CoTask::run() invalid coroutine");
+				promise_type& lPromise = mHandle.promise();
+				lPromise.setPool(&inPool);
+				lPromise.mResult = make_shared<FutureState<T> >(&inPool);
+				Future<T> lFuture(lPromise.mResult);
+				coroutine_handle<promise_type> lHandle = mHandle;
+				mHandle = nullptr;
+				inPool.pushDetached(new CoResumeTask(lHandle));
+				return lFuture;
+			}
+			
+			//! Return whether coroutine has completed (awaiter interface).
+			bool await_ready(void) const noexcept {return !mHandle || mHandle.done();}
+			//! Start coroutine in the awaiting coroutine \c inAwaiting, which it resumes when completed (awaiter interface).
+			template <class Promise>
+			coroutine_handle<> await_suspend(coroutine_handle<Promise> inAwaiting) noexcept {
+				promise_type& lPromise = mHandle.promise();
+				lPromise.mContinuation = inAwaiting;
+				lPromise.setPool(getCoroutinePool(inAwaiting));
+				return mHandle;
+			}
+			//! Return value of completed coroutine, or throw its exception (awaiter interface).
+			T await_resume(void) {
+				if(!mHandle) throw Exception(eOtherError, "CoTask::await_resume() invalid coroutine");
+				if constexpr(is_void<T>::value) mHandle.promise().getValue();
+				else return std::move(mHandle.promise().getValue());
+			}
+			
+			protected:
+			coroutine_handle<promise_type> mHandle; //!< Owned coroutine.
+			
+			private:
+			//! restrict (disable) copy constructor.
+			CoTask(const CoTask&);
+			//! restrict (disable) assignment operator.
+			void operator=(const CoTask&);
+		};
+		
+		//! Return coroutine task of this promise.
+		template <class T>
+		CoTask<T> CoPromise<T>::get_return_object(void)
+		{
+			return CoTask<T>(coroutine_handle<CoPromise<T> >::from_promise(*this));
+		}
+		
+		//! Return coroutine task of this promise.
+		inline CoTask<void> CoPromise<void>::get_return_object(void)
+		{
+			return CoTask<void>(coroutine_handle<CoPromise<void> >::from_promise(*this));
+		}
+		
+		/*! \brief Awaiter that moves a coroutine to a thread pool.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		*/
+		class CoSwitch {
+			public:
+			//! Construct awaiter for thread pool \c inPool.
+			explicit CoSwitch(ThreadPool& inPool) : mPool(inPool) {}
+			
+			//! Always suspend.
+			bool await_ready(void) const noexcept {return false;}
+			//! Resume coroutine \c inHandle on the thread pool, which becomes its pool.
+			template <class Promise>
+			void await_suspend(coroutine_handle<Promise> inHandle) {
+				if constexpr(is_base_of<CoPromiseBase, Promise>::value) inHandle.promise().setPool(&mPool);
+				mPool.pushDetached(new CoResumeTask(inHandle));
+			}
+			//! Nothing to return.
+			void await_resume(void) const noexcept {}
+			
+			protected:
+			ThreadPool& mPool; //!< Destination thread pool.
+		};
+		
+		/*! \brief Return awaiter that moves the awaiting coroutine to thread pool \c inPool.
+		
+		After <tt>co_await resumeOn(inPool)</tt>, the coroutine runs on a slave of \c inPool, and later suspensions also resume on this pool.
+		*/
+		inline CoSwitch resumeOn(ThreadPool& inPool)
+		{
+			return CoSwitch(inPool);
+		}
+		
+		/*! \brief Awaiter of a future.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		The awaiting coroutine registers a callback of the future, which resumes it on its thread pool once the future is ready.
+		*/
+		template <class T>
+		class CoFutureAwaiter {
+			public:
+			//! Construct awaiter for future \c inFuture.
+			explicit CoFutureAwaiter(const Future<T>& inFuture) : mFuture(inFuture) {}
+			
+			//! Return whether the future is ready.
+			bool await_ready(void) const {return mFuture.isReady();}
+			//! Resume coroutine \c inHandle once the future is ready.
+			template <class Promise>
+			void await_suspend(coroutine_handle<Promise> inHandle) {
+				mFuture.getState()->addCallback(new Callback(inHandle, getCoroutinePool(inHandle)));
+			}
+			//! Return value of the future, or throw its exception.
+			typename FutureState<T>::Reference await_resume(void) const {return mFuture.get();}
+			
+			protected:
+			/*! \brief Callback that resumes a coroutine.
+			\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+			\ingroup Threading
+			*/
+			class Callback : public FutureCallback {
+				public:
+				//! Construct callback that resumes coroutine \c inHandle on pool \c inPool.
+				Callback(coroutine_handle<> inHandle, ThreadPool* inPool) : mHandle(inHandle), mPool(inPool) {}
+				//! Resume coroutine, and delete this callback.
+				void invoke(void) {
+					resumeCoroutine(mHandle, mPool);
+					delete this;
+				}
+				
+				protected:
+				coroutine_handle<> mHandle; //!< Coroutine to resume.
+				ThreadPool* mPool; //!< Thread pool of the coroutine.
+			};
+			
+			Future<T> mFuture; //!< Awaited future.
+		};
+		
+		/*! \brief Await future \c inFuture in a coroutine.
+		
+		The coroutine suspends until the future is ready, and then receives its value (or its exception is thrown).
+		*/
+		template <class T>
+		CoFutureAwaiter<T> operator co_await(const Future<T>& inFuture)
+		{
+			return CoFutureAwaiter<T>(inFuture);
+		}
+		
+	} // end of Threading namespace
+	
+} // end of PACC namespace
+
+#endif // PACC_COROUTINES
+
+#endif // PACC_Threading_CoTask_hpp_
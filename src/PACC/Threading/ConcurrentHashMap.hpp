@@ -0,0 +1,314 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/ConcurrentHashMap.hpp
+ * \brief Class definition for the concurrent hash map.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#ifndef PACC_Threading_ConcurrentHashMap_hpp_
+#define PACC_Threading_ConcurrentHashMap_hpp_
+
+#include "PACC/Threading/Future.hpp"
+#include "PACC/Threading/RWLock.hpp"
+#include "PACC/Threading/Topology.hpp"
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+namespace PACC { 
+	
+	using namespace std;
+	
+	namespace Threading {
+		
+		/*! \brief Hash map that can be shared by any number of threads.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		This class maps keys of type \c Key to values of type \c Value, and is meant for caches shared by the slaves of a thread pool (e.g. memoized evaluations, parsed files). The map is split into a power of two number of segments, each with its own hash table and reader-writer lock (see class RWLock): lookups of any number of threads proceed in parallel (a single atomic operation on lock and unlock), and insertions only lock the segment of their key, so that threads seldom contend unless they modify the same keys.
+		
+		Values are always returned by copy, while the segment is locked: no reference to an element ever escapes the map, so that elements can be erased or evicted at any time, without deferred reclamation. Values that are expensive to copy should be stored through a shared pointer (e.g. <tt>ConcurrentHashMap<string, shared_ptr<const XML::Document> ></tt>).
+		
+		A map can be bounded (see constructor): once a segment is full, inserting a new key evicts another key of the same segment, chosen by the CLOCK algorithm (an approximation of LRU eviction). Every lookup marks its element as referenced, using a relaxed store only if the element was not marked already; eviction sweeps the segment, clearing marks, and evicts the first element that was not referenced since the last sweep. The bound is therefore enforced per segment, and the map may evict keys before its total size reaches the bound.
+		
+		Method ConcurrentHashMap::getOrCompute computes missing values at most once, even when several threads miss the same key at the same time: the first thread computes the value outside of any lock, while the other threads wait for its result (or exception):
+		\code
+Threading::ConcurrentHashMap<unsigned long, double> lCache(100000);
+...
+// within tasks
+double lFitness = lCache.getOrCompute(lGenome.getHash(), [&]() {return evaluate(lGenome);});
+		\endcode
+		*/
+		template <class Key, class Value, class Hash=hash<Key>, class Equal=equal_to<Key> >
+		class ConcurrentHashMap {
+			public:
+			/*! \brief Construct empty map of at most \c inMaxSize elements (0 means unbounded), with \c inSegments segments.
+			
+			The number of segments is rounded up to a power of two; by default (0), it is 8 segments per processor. When bounded, the number of segments is reduced to at most \c inMaxSize, and each segment holds at most the bound divided by the number of segments (rounded down), so that the map never holds more than \c inMaxSize elements.
+			*/
+			explicit ConcurrentHashMap(size_t inMaxSize=0, unsigned int inSegments=0) : mMaxSize(inMaxSize) {
+				if(inSegments == 0) inSegments = 8*Topology::getCPUCount();
+				if(inSegments > (1U << 16)) inSegments = 1U << 16;
+				unsigned int lCount = 1;
+				while(lCount < inSegments) lCount <<= 1;
+				while(inMaxSize > 0 && lCount > inMaxSize) lCount >>= 1;
+				mSegments = new Segment[lCount];
+				mMask = lCount-1;
+				mSegmentSize = inMaxSize/lCount;
+			}
+			//! Delete map and its elements.
+			~ConcurrentHashMap(void) {delete[] mSegments;}
+			
+			//! Remove all elements.
+			void clear(void) {
+				for(size_t i = 0; i <= mMask; ++i) {
+					WriteGuard lGuard(mSegments[i].mLock);
+					mSegments[i].mMap.clear();
+				}
+			}
+			
+			//! Return whether key \c inKey is in map.
+			bool contains(const Key& inKey) const {
+				const Segment& lSegment = getSegment(inKey);
+				ReadGuard lGuard(lSegment.mLock);
+				return lSegment.mMap.find(inKey) != lSegment.mMap.end();
+			}
+			
+			//! Return whether map is (momentarily) empty.
+			bool empty(void) const {return size() == 0;}
+			
+			//! Remove key \c inKey; return false if it was not in map.
+			bool erase(const Key& inKey) {
+				Segment& lSegment = getSegment(inKey);
+				WriteGuard lGuard(lSegment.mLock);
+				return lSegment.mMap.erase(inKey) > 0;
+			}
+			
+			//! Copy value of key \c inKey into \c outValue; return false if the key is not in map.
+			bool find(const Key& inKey, Value& outValue) const {
+				const Segment& lSegment = getSegment(inKey);
+				ReadGuard lGuard(lSegment.mLock);
+				typename Map::const_iterator lIter = lSegment.mMap.find(inKey);
+				if(lIter == lSegment.mMap.end()) return false;
+				lIter->second.touch();
+				outValue = lIter->second.mValue;
+				return true;
+			}
+			
+			//! Return maximum number of elements (0 if unbounded).
+			size_t getMaxSize(void) const {return mMaxSize;}
+			
+			/*! \brief Return value of key \c inKey, computing it with nullary function \c inFunction if the key is not in map.
+			
+			The value returned by \c inFunction is inserted in the map and returned. If other threads ask for the same missing key meanwhile, they wait for this value instead of computing it again. If \c inFunction throws an exception, nothing is inserted, and the exception is thrown to all of these threads; the next call then computes the value again. Function \c inFunction is called without any lock held; it may therefore access this map, but must not ask for key \c inKey itself.
+			*/
+			template <class Function>
+			Value getOrCompute(const Key& inKey, Function inFunction) {
+				Segment& lSegment = getSegment(inKey);
+				{
+					ReadGuard lGuard(lSegment.mLock);
+					typename Map::const_iterator lIter = lSegment.mMap.find(inKey);
+					if(lIter != lSegment.mMap.end()) {
+						lIter->second.touch();
+						return lIter->second.mValue;
+					}
+				}
+				// miss: either compute value, or wait for the thread that already does
+				shared_ptr<FutureState<Value> > lPending;
+				{
+					WriteGuard lGuard(lSegment.mLock);
+					typename Map::const_iterator lIter = lSegment.mMap.find(inKey);
+					if(lIter != lSegment.mMap.end()) {
+						lIter->second.touch();
+						return lIter->second.mValue;
+					}
+					typename PendingMap::const_iterator lWaiting = lSegment.mPending.find(inKey);
+					if(lWaiting != lSegment.mPending.end()) lPending = lWaiting->second;
+					else lSegment.mPending.insert(make_pair(inKey, make_shared<FutureState<Value> >((ThreadPool*)0)));
+				}
+				if(lPending) {
+					lPending->wait();
+					return lPending->get();
+				}
+				try {
+					Value lValue(inFunction());
+					WriteGuard lGuard(lSegment.mLock);
+					lPending = lSegment.mPending[inKey];
+					lSegment.mPending.erase(inKey);
+					assign(lSegment, inKey, lValue);
+					lPending->setValue(lValue);
+					return lValue;
+				}
+				catch(...) {
+					if(!lPending) {
+						WriteGuard lGuard(lSegment.mLock);
+						lPending = lSegment.mPending[inKey];
+						lSegment.mPending.erase(inKey);
+					}
+					if(!lPending->isReady()) lPending->setException(current_exception());
+					throw;
+				}
+			}
+			
+			//! Return number of segments.
+			size_t getSegmentCount(void) const {return mMask+1;}
+			
+			//! Insert key \c inKey with value \c inValue if the key is not already in map; return false if it was.
+			bool insert(const Key& inKey, const Value& inValue) {
+				Segment& lSegment = getSegment(inKey);
+				WriteGuard lGuard(lSegment.mLock);
+				if(lSegment.mMap.find(inKey) != lSegment.mMap.end()) return false;
+				assign(lSegment, inKey, inValue);
+				return true;
+			}
+			
+			//! Set value of key \c inKey to \c inValue, inserting the key if it is not already in map.
+			void set(const Key& inKey, const Value& inValue) {
+				Segment& lSegment = getSegment(inKey);
+				WriteGuard lGuard(lSegment.mLock);
+				assign(lSegment, inKey, inValue);
+			}
+			
+			//! Return (momentary) number of elements, locking one segment at a time.
+			size_t size(void) const {
+				size_t lSize = 0;
+				for(size_t i = 0; i <= mMask; ++i) {
+					ReadGuard lGuard(mSegments[i].mLock);
+					lSize += mSegments[i].mMap.size();
+				}
+				return lSize;
+			}
+			
+			protected:
+			//! Element of map: value, and referenced mark of the CLOCK eviction.
+			struct Element {
+				Value mValue; //!< Value of element.
+				mutable atomic<bool> mReferenced; //!< Element was read since the last sweep.
+				
+				//! Construct element with value \c inValue.
+				explicit Element(const Value& inValue) : mValue(inValue), mReferenced(false) {}
+				//! Mark element as referenced (the store is skipped if already marked, so that readers do not dirty its cache line).
+				void touch(void) const {if(!mReferenced.load(memory_order_relaxed)) mReferenced.store(true, memory_order_relaxed);}
+			};
+			
+			typedef unordered_map<Key, Element, Hash, Equal> Map; //!< Hash table of a segment.
+			typedef unordered_map<Key, shared_ptr<FutureState<Value> >, Hash, Equal> PendingMap; //!< Values being computed in a segment.
+			
+			//! Segment of map, with its own lock.
+			struct Segment {
+				mutable RWLock mLock; //!< Lock of segment.
+				Map mMap; //!< Hash table of segment.
+				PendingMap mPending; //!< Values being computed by ConcurrentHashMap::getOrCompute.
+				size_t mHand; //!< Bucket index of the CLOCK hand.
+				char mPad[64]; //!< Keep locks of segments on distinct cache lines.
+				
+				//! Construct empty segment with adaptive lock.
+				Segment(void) : mLock(Mutex::eAdaptive), mHand(0) {}
+			};
+			
+			//! Shared lock of a segment, released on scope exit.
+			struct ReadGuard {
+				RWLock& mLock; //!< Locked lock.
+				//! Lock \c inLock in shared mode.
+				explicit ReadGuard(RWLock& inLock) : mLock(inLock) {mLock.lockShared();}
+				//! Release shared lock.
+				~ReadGuard(void) {mLock.unlockShared();}
+			};
+			
+			//! Exclusive lock of a segment, released on scope exit.
+			struct WriteGuard {
+				RWLock& mLock; //!< Locked lock.
+				//! Lock \c inLock in exclusive mode.
+				explicit WriteGuard(RWLock& inLock) : mLock(inLock) {mLock.lock();}
+				//! Release exclusive lock.
+				~WriteGuard(void) {mLock.unlock();}
+			};
+			
+			Segment* mSegments; //!< Array of segments.
+			size_t mMask; //!< Number of segments minus one.
+			size_t mMaxSize; //!< Maximum number of elements (0 if unbounded).
+			size_t mSegmentSize; //!< Maximum number of elements of a segment (0 if unbounded).
+			Hash mHash; //!< Hash function.
+			
+			//! Set value of key \c inKey to \c inValue in locked segment \c ioSegment, evicting an element if the segment is full.
+			void assign(Segment& ioSegment, const Key& inKey, const Value& inValue) {
+				typename Map::iterator lIter = ioSegment.mMap.find(inKey);
+				if(lIter != ioSegment.mMap.end()) {
+					lIter->second.mValue = inValue;
+					return;
+				}
+				if(mSegmentSize > 0 && ioSegment.mMap.size() >= mSegmentSize) evict(ioSegment);
+				ioSegment.mMap.emplace(piecewise_construct, forward_as_tuple(inKey), forward_as_tuple(inValue));
+			}
+			
+			/*! \brief Evict one element of locked segment \c ioSegment (CLOCK algorithm).
+			
+			The hand sweeps the buckets of the segment, clearing the referenced marks, and the first unmarked element is evicted. Since marks are cleared along the way, at most two sweeps are needed.
+			*/
+			void evict(Segment& ioSegment) {
+				Map& lMap = ioSegment.mMap;
+				if(lMap.empty()) return;
+				for(;;) {
+					size_t lBucket = ioSegment.mHand % lMap.bucket_count();
+					for(typename Map::local_iterator lIter = lMap.begin(lBucket); lIter != lMap.end(lBucket); ++lIter) {
+						if(lIter->second.mReferenced.load(memory_order_relaxed)) lIter->second.mReferenced.store(false, memory_order_relaxed);
+						else {
+							lMap.erase(lMap.find(lIter->first));
+							return;
+						}
+					}
+					ioSegment.mHand = lBucket+1;
+				}
+			}
+			
+			//! Return segment of key \c inKey (the hash is mixed, so that the segment does not depend on the same bits as the bucket).
+			Segment& getSegment(const Key& inKey) const {
+				size_t lHash = mHash(inKey);
+				lHash ^= lHash >> 15;
+				lHash *= (size_t)0x9E3779B97F4A7C15ULL;
+				return mSegments[(lHash >> (sizeof(size_t)*8-16)) & mMask];
+			}
+			
+			private:
+			//! restrict (disable) copy constructor.
+			ConcurrentHashMap(const ConcurrentHashMap&);
+			//! restrict (disable) assignment operator.
+			void operator=(const ConcurrentHashMap&);
+		};
+		
+	} // end of Threading namespace
+	
+} // end of PACC namespace
+
+#endif // PACC_Threading_ConcurrentHashMap_hpp_
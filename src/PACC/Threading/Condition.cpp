@@ -47,6 +47,7 @@
  */
 
 #include "PACC/Threading/Condition.hpp"
+#include "PACC/Threading/LockProfiler.hpp"
 #include "PACC/config.hpp"
 
 #ifdef PACC_THREADS_WIN32
@@ -73,11 +74,11 @@ typedef struct {
 
 using namespace PACC;
 
-/*! \brief Allocate native structure and create condition. 
+/*! \brief Allocate native structure and create condition, with embedded mutex of locking mode \c inMode. 
 
 Any error raises a Threading::Exception.
 */
-Threading::Condition::Condition(void)
+Threading::Condition::Condition(Mode inMode) : Mutex(inMode)
 {
 	pthread_cond_t* lCondition = new pthread_cond_t;
 #ifdef PACC_THREADS_WIN32
@@ -210,6 +211,15 @@ bool Threading::Condition::wait(double inMaxTime) const
 {
 	bool lReturn;
 	pthread_cond_t* lCondition = (pthread_cond_t*) mCondition;
+#ifdef PACC_LOCK_PROFILING
+	// the mutex is not held while waiting: close the current hold period
+	unsigned long long lStart = 0;
+	if(mProfile) {
+		lStart = LockProfiler::getCount();
+		mProfile->addHold(lStart-mHoldStart);
+		mHoldStart = lStart;
+	}
+#endif
 #ifdef PACC_THREADS_WIN32
 	EnterCriticalSection(&lCondition->mLock);
 	// increment number of waiters
@@ -265,6 +275,12 @@ bool Threading::Condition::wait(double inMaxTime) const
 		unlock();
 		throw Exception(eOtherError, "Condition::wait() invalid condition!");
 	}
+#endif
+#ifdef PACC_LOCK_PROFILING
+	if(mProfile) {
+		mHoldStart = LockProfiler::getCount();
+		mProfile->addConditionWait(mHoldStart-lStart);
+	}
 #endif
 	return lReturn;
 }
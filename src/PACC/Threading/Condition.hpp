@@ -48,11 +48,13 @@ namespace PACC {
 		
 		This class incapsulates a cross-platform POSIX condition with classic Condition::broadcast, Condition::signal, and Condition::wait methods. It should be compatible with any flavour of Unix that supports POSIX threads. It is also compatible with any version of Windows that support the SignalObjectAndWait method (introduced with NT4). 
 		
+		The embedded mutex can be adaptive (see Mutex::Mode); a thread that returns from Condition::wait relocks it without spinning. When lock profiling is enabled, a named condition (see Mutex::setName) also records the number and duration of its waits, which are excluded from the hold time of its mutex (see class LockProfiler).
+		
 		This class has been tested under Linux, MacOS X and Windows 2000/XP.
 		*/
 		class Condition : public Mutex {
 			public:
-			Condition(void);
+			Condition(Mode inMode=eBlocking);
 			~Condition(void);
 			
 			void broadcast(void) const;
@@ -0,0 +1,147 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/EventCount.hpp
+ * \brief Class definition for the event count.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#ifndef PACC_Threading_EventCount_hpp_
+#define PACC_Threading_EventCount_hpp_
+
+#include "PACC/Threading/Futex.hpp"
+
+namespace PACC { 
+	
+	namespace Threading {
+		
+		/*! \brief Event count for parking threads that wait on a lock-free condition.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		An event count lets threads block until some condition, evaluated without any lock (e.g. "a lock-free queue is not empty"), becomes true. A waiting thread uses the following protocol:
+		\code
+for(;;) {
+	if(tryToConsume()) break;
+	unsigned int lKey = lEvent.prepareWait();
+	if(tryToConsume()) {lEvent.cancelWait(); break;}
+	lEvent.wait(lKey);
+}
+		\endcode
+		while a thread that makes the condition true simply calls EventCount::notifyOne (or EventCount::notifyAll) afterwards. Because waiters register themselves before checking the condition a second time, no notification can be lost. A notification that finds no registered waiter, or only waiters that have already been notified but are not running yet, costs a single atomic load: it does not lock anything and does not make any system call. At most 65535 threads can wait on the same event count.
+		*/
+		class EventCount {
+			public:
+			//! Construct event count without any waiter.
+			EventCount(void) : mEpoch(0), mCounts(0) {}
+			
+			//! Cancel a wait prepared with EventCount::prepareWait.
+			void cancelWait(void) {leave();}
+			
+			//! Return the number of registered waiters.
+			unsigned int getWaiters(void) const {return mCounts.load(memory_order_relaxed) & 0xFFFF;}
+			
+			//! Wake up all registered waiters.
+			void notifyAll(void) {
+				atomic_thread_fence(memory_order_seq_cst);
+				unsigned int lCounts = mCounts.load(memory_order_relaxed);
+				do {
+					if((lCounts & 0xFFFF) <= (lCounts >> 16)) return;
+				} while(!mCounts.compare_exchange_weak(lCounts, (lCounts & 0xFFFF) | (lCounts << 16), memory_order_relaxed));
+				mEpoch.fetch_add(1, memory_order_seq_cst);
+				Futex::wakeAll(mEpoch);
+			}
+			
+			/*! \brief Wake up at most \c inCount registered waiters that have not already been notified.
+			
+			All waiters are awakened with a single system call.
+			*/
+			void notify(unsigned int inCount) {
+				atomic_thread_fence(memory_order_seq_cst);
+				unsigned int lCounts = mCounts.load(memory_order_relaxed);
+				unsigned int lWake;
+				do {
+					if((lCounts & 0xFFFF) <= (lCounts >> 16) || inCount == 0) return;
+					lWake = (lCounts & 0xFFFF) - (lCounts >> 16);
+					if(lWake > inCount) lWake = inCount;
+				} while(!mCounts.compare_exchange_weak(lCounts, lCounts + (lWake << 16), memory_order_relaxed));
+				mEpoch.fetch_add(1, memory_order_seq_cst);
+				if(lWake == 1) Futex::wakeOne(mEpoch);
+				else Futex::wake(mEpoch, lWake);
+			}
+			
+			//! Wake up one registered waiter, if any waiter has not already been notified.
+			void notifyOne(void) {notify(1);}
+			
+			//! Register the calling thread as a waiter, and return the key to pass to EventCount::wait.
+			unsigned int prepareWait(void) {
+				mCounts.fetch_add(1, memory_order_seq_cst);
+				atomic_thread_fence(memory_order_seq_cst);
+				return mEpoch.load(memory_order_acquire);
+			}
+			
+			/*! \brief Wait up to \c inMaxTime seconds for a notification posterior to EventCount::prepareWait.
+			\return False if timed out, true otherwise.
+			
+			The calling thread is unregistered before returning. A negative or null time out (default) means that the method should wait indefinitely. Like Futex::wait, this method may return spuriously; the caller should always check its condition again.
+			*/
+			bool wait(unsigned int inKey, double inMaxTime=0) {
+				bool lReturn = true;
+				if(mEpoch.load(memory_order_acquire) == inKey) lReturn = Futex::wait(mEpoch, inKey, inMaxTime);
+				leave();
+				return lReturn;
+			}
+			
+			protected:
+			atomic<unsigned int> mEpoch; //!< Notification counter (futex word).
+			atomic<unsigned int> mCounts; //!< Number of registered waiters (low 16 bits) and of pending notifications (high 16 bits).
+			
+			//! Unregister a waiter, consuming one pending notification if any.
+			void leave(void) {
+				unsigned int lCounts = mCounts.load(memory_order_relaxed);
+				unsigned int lNew;
+				do {
+					unsigned int lNotified = lCounts >> 16;
+					lNew = ((lCounts & 0xFFFF) - 1) | ((lNotified > 0 ? lNotified-1 : 0) << 16);
+				} while(!mCounts.compare_exchange_weak(lCounts, lNew, memory_order_seq_cst));
+			}
+			
+			private:
+			//! restrict (disable) copy constructor.
+			EventCount(const EventCount&);
+			//! restrict (disable) assignment operator.
+			void operator=(const EventCount&);
+		};
+		
+	} // end of Threading namespace
+	
+} // end of PACC namespace
+
+#endif // PACC_Threading_EventCount_hpp_
@@ -89,6 +89,7 @@ string Threading::Exception::getMessage() const throw()
 		case eMutexNotOwned: lMessage << "MutexNotOwned"; break;
 		case eWouldDeadLock: lMessage << "WouldDeadLock"; break;
 		case eRunning: lMessage << "Running"; break;
+		case eCanceled: lMessage << "Canceled"; break;
 		default: lMessage << "OtherError"; break;
 	}
 	if(mNativeCode) lMessage << " (" << mNativeCode << "): ";
@@ -50,7 +50,8 @@ namespace PACC {
 			eMutexNotOwned, //!< Mutex not own by calling thread
 			eWouldDeadLock, //!< Operation would produce a dead lock.
 			eRunning, //!< Thread is already running
-			eOtherError //!< Any other OS specific error.
+			eOtherError, //!< Any other OS specific error.
+			eCanceled //!< Operation was canceled (see class CancellationSource).
 		};
 		
 		/*!
@@ -0,0 +1,143 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/Futex.cpp
+ * \brief Class methods for the portable futex.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#include "PACC/Threading/Futex.hpp"
+#include "PACC/Threading/Condition.hpp"
+#include "PACC/config.hpp"
+
+#ifdef PACC_FUTEX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <errno.h>
+#include <climits>
+#include <cmath>
+#include <ctime>
+#else
+#include <cstddef>
+#endif
+
+using namespace std;
+using namespace PACC;
+
+#ifndef PACC_FUTEX
+namespace {
+	
+	//! Number of conditions in the fallback table.
+	const unsigned int cBuckets = 64;
+	
+	//! Fallback table of conditions for platforms without futexes.
+	Threading::Condition gBuckets[cBuckets];
+	
+	//! Return condition of word \c inWord.
+	Threading::Condition& getBucket(const void* inWord) {
+		size_t lHash = (size_t) inWord;
+		return gBuckets[(lHash >> 4) % cBuckets];
+	}
+	
+}
+#endif
+
+/*! \brief Wait up to \c inMaxTime seconds while word \c inWord holds value \c inExpected.
+\return False if timed out, true otherwise.
+
+The method returns immediately if the word does not hold the expected value. Otherwise, it blocks until another thread calls Futex::wakeOne or Futex::wakeAll on this word, or until time out. A negative or null time out (default) means that the method should wait indefinitely. Spurious wake ups are possible.
+*/
+bool Threading::Futex::wait(const atomic<unsigned int>& inWord, unsigned int inExpected, double inMaxTime)
+{
+#ifdef PACC_FUTEX
+	struct timespec lSpec;
+	struct timespec* lTimeOut = 0;
+	if(inMaxTime > 0) {
+		lSpec.tv_sec = (time_t) inMaxTime;
+		lSpec.tv_nsec = (long) ((inMaxTime - floor(inMaxTime)) * 1000000000);
+		lTimeOut = &lSpec;
+	}
+	long lRes = ::syscall(SYS_futex, (const unsigned int*) &inWord, FUTEX_WAIT_PRIVATE, inExpected, lTimeOut, 0, 0);
+	return !(lRes == -1 && errno == ETIMEDOUT);
+#else
+	Condition& lBucket = getBucket(&inWord);
+	bool lReturn = true;
+	lBucket.lock();
+	if(inWord.load() == inExpected) lReturn = lBucket.wait(inMaxTime);
+	lBucket.unlock();
+	return lReturn;
+#endif
+}
+
+/*! \brief Wake up at most \c inCount threads waiting on word \c inWord.
+
+On platforms without futexes, all waiting threads of the same table entry are awakened (see Futex::wakeOne).
+*/
+void Threading::Futex::wake(const atomic<unsigned int>& inWord, unsigned int inCount)
+{
+#ifdef PACC_FUTEX
+	::syscall(SYS_futex, (const unsigned int*) &inWord, FUTEX_WAKE_PRIVATE, inCount < INT_MAX ? (int) inCount : INT_MAX, 0, 0, 0);
+#else
+	Condition& lBucket = getBucket(&inWord);
+	lBucket.lock();
+	lBucket.broadcast();
+	lBucket.unlock();
+#endif
+}
+
+//! Wake up all threads waiting on word \c inWord.
+void Threading::Futex::wakeAll(const atomic<unsigned int>& inWord)
+{
+#ifdef PACC_FUTEX
+	::syscall(SYS_futex, (const unsigned int*) &inWord, FUTEX_WAKE_PRIVATE, INT_MAX, 0, 0, 0);
+#else
+	Condition& lBucket = getBucket(&inWord);
+	lBucket.lock();
+	lBucket.broadcast();
+	lBucket.unlock();
+#endif
+}
+
+/*! \brief Wake up at least one thread waiting on word \c inWord.
+
+On platforms without futexes, the table of conditions is shared by many words, so that all waiting threads of the same entry are awakened.
+*/
+void Threading::Futex::wakeOne(const atomic<unsigned int>& inWord)
+{
+#ifdef PACC_FUTEX
+	::syscall(SYS_futex, (const unsigned int*) &inWord, FUTEX_WAKE_PRIVATE, 1, 0, 0, 0);
+#else
+	Condition& lBucket = getBucket(&inWord);
+	lBucket.lock();
+	lBucket.broadcast();
+	lBucket.unlock();
+#endif
+}
@@ -0,0 +1,69 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/Futex.hpp
+ * \brief Class definition for the portable futex.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#ifndef PACC_Threading_Futex_hpp_
+#define PACC_Threading_Futex_hpp_
+
+#include <atomic>
+
+namespace PACC { 
+	
+	using namespace std;
+	
+	namespace Threading {
+		
+		/*! \brief Portable futex (wait on the value of an atomic word).
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		This class provides the two primitive operations on which lock-free synchronization objects can build their blocking slow path: Futex::wait blocks the calling thread as long as an atomic word holds an expected value, and Futex::wakeOne or Futex::wakeAll wake up threads blocked on a word. As with POSIX conditions, a waiting thread may wake up spuriously, so that the word should always be checked again after Futex::wait returns.
+		
+		Under Linux, this class maps directly onto the futex system call, and none of its operations allocate or lock anything in user space. On other platforms, it falls back to a fixed table of Condition objects indexed by the address of the word. In both cases, a thread that modifies a word and then calls Futex::wakeOne or Futex::wakeAll can never miss a thread that was about to wait on the previous value.
+		
+		The waking operations always cost a system call (or a mutex); callers are expected to keep track of their waiters and to skip them when no thread is waiting (see for instance class EventCount).
+		*/
+		class Futex {
+			public:
+			static bool wait(const atomic<unsigned int>& inWord, unsigned int inExpected, double inMaxTime=0);
+			static void wake(const atomic<unsigned int>& inWord, unsigned int inCount);
+			static void wakeAll(const atomic<unsigned int>& inWord);
+			static void wakeOne(const atomic<unsigned int>& inWord);
+		};
+		
+	} // end of Threading namespace
+	
+} // end of PACC namespace
+
+#endif // PACC_Threading_Futex_hpp_
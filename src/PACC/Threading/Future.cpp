@@ -0,0 +1,120 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/Future.cpp
+ * \brief Class methods for futures of thread pool results.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#include "PACC/Threading/Future.hpp"
+#include "PACC/Threading/Futex.hpp"
+#include "PACC/Threading/ThreadPool.hpp"
+
+using namespace PACC;
+
+namespace {
+	
+	//! Sentinel that closes the callback list of a ready state.
+	class ClosedCallback : public Threading::FutureCallback {
+		public:
+		void invoke(void) {}
+	};
+	
+	ClosedCallback gClosed;
+	
+}
+
+/*! \brief Add callback \c inCallback to this state.
+
+If the state is already ready, the callback is invoked immediately by the calling thread. Otherwise, it will be invoked by the thread that makes the state ready.
+*/
+void Threading::FutureStateBase::addCallback(FutureCallback* inCallback)
+{
+	FutureCallback* lHead = mCallbacks.load(memory_order_acquire);
+	for(;;) {
+		if(lHead == &gClosed) {
+			inCallback->invoke();
+			return;
+		}
+		inCallback->mNext = lHead;
+		if(mCallbacks.compare_exchange_weak(lHead, inCallback, memory_order_release, memory_order_acquire)) return;
+	}
+}
+
+//! Push detached task \c inTask onto the thread pool of this state.
+void Threading::FutureStateBase::schedule(Task* inTask) const
+{
+	mPool->pushDetached(inTask);
+}
+
+//! Set exception \c inException and make state ready.
+void Threading::FutureStateBase::setException(const exception_ptr& inException)
+{
+	mException = inException;
+	setReady();
+}
+
+/*! \brief Make state ready.
+
+The ready flag is raised first, so that waiting threads are awakened, and the callbacks are then invoked in the order in which they were added.
+*/
+void Threading::FutureStateBase::setReady(void)
+{
+	if(mReady.exchange(eReady, memory_order_acq_rel) & eWaiters) Futex::wakeAll(mReady);
+	// close callback list, and invoke callbacks in order of addition
+	FutureCallback* lList = mCallbacks.exchange(&gClosed, memory_order_acq_rel);
+	FutureCallback* lReversed = 0;
+	while(lList) {
+		FutureCallback* lNext = lList->mNext;
+		lList->mNext = lReversed;
+		lReversed = lList;
+		lList = lNext;
+	}
+	while(lReversed) {
+		FutureCallback* lNext = lReversed->mNext;
+		lReversed->invoke();
+		lReversed = lNext;
+	}
+}
+
+//! Block calling thread until state is ready.
+void Threading::FutureStateBase::wait(void) const
+{
+	unsigned int lReady = mReady.load(memory_order_acquire);
+	while(!(lReady & eReady)) {
+		if(!(lReady & eWaiters)) {
+			// set waiter flag before blocking
+			if(!mReady.compare_exchange_weak(lReady, lReady | eWaiters, memory_order_acquire)) continue;
+			lReady |= eWaiters;
+		}
+		Futex::wait(mReady, lReady);
+		lReady = mReady.load(memory_order_acquire);
+	}
+}
@@ -0,0 +1,447 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/Future.hpp
+ * \brief Class definition for futures of thread pool results.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#ifndef PACC_Threading_Future_hpp_
+#define PACC_Threading_Future_hpp_
+
+#include "PACC/Threading/Task.hpp"
+#include "PACC/Threading/Exception.hpp"
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace PACC { 
+	
+	using namespace std;
+	
+	namespace Threading {
+		
+		class ThreadPool;
+		
+		/*! \brief Callback invoked when a future becomes ready.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		Callbacks are chained in an intrusive list, and each one is invoked exactly once by the thread that makes the future ready. A callback is responsible for its own deletion.
+		*/
+		class FutureCallback {
+			public:
+			FutureCallback(void) : mNext(0) {}
+			virtual ~FutureCallback(void) {}
+			
+			//! Invoke callback (the future is ready).
+			virtual void invoke(void) = 0;
+			
+			protected:
+			FutureCallback* mNext; //!< Next callback in list.
+			
+			friend class FutureStateBase;
+		};
+		
+		/*! \brief Shared state of a future, without its value.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		This class holds the ready flag, the exception and the list of callbacks of a future. The ready flag is an atomic word on which threads block using class Futex, and callbacks are pushed onto a lock-free list that is closed when the future becomes ready. Once ready, a state never changes again.
+		*/
+		class FutureStateBase {
+			public:
+			//! Construct pending state for continuations scheduled on thread pool \c inPool.
+			explicit FutureStateBase(ThreadPool* inPool) : mPool(inPool), mReady(0), mCallbacks(0) {}
+			virtual ~FutureStateBase(void) {}
+			
+			//! Return whether state is ready.
+			bool isReady(void) const {return (mReady.load(memory_order_acquire) & eReady) != 0;}
+			//! Return whether state holds an exception (state must be ready).
+			bool hasException(void) const {return (bool)mException;}
+			//! Return exception of state (state must be ready).
+			const exception_ptr& getException(void) const {return mException;}
+			//! Return thread pool of continuations.
+			ThreadPool* getPool(void) const {return mPool;}
+			
+			void addCallback(FutureCallback* inCallback);
+			void schedule(Task* inTask) const;
+			void setException(const exception_ptr& inException);
+			void wait(void) const;
+			
+			protected:
+			//! Bits of the ready word.
+			enum {
+				eReady = 1, //!< State is ready.
+				eWaiters = 2 //!< Some thread is blocked waiting for state.
+			};
+			
+			ThreadPool* mPool; //!< Thread pool of continuations.
+			mutable atomic<unsigned int> mReady; //!< Ready word.
+			atomic<FutureCallback*> mCallbacks; //!< List of pending callbacks.
+			exception_ptr mException; //!< Exception thrown by the producer, if any.
+			
+			void setReady(void);
+		};
+		
+		/*! \brief Shared state of a future of type \c T.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		The value is constructed in place when it is set, so that type \c T need not be default constructible.
+		*/
+		template <class T>
+		class FutureState : public FutureStateBase {
+			public:
+			//! Type returned by FutureState::get.
+			typedef const T& Reference;
+			
+			//! Construct pending state for continuations scheduled on thread pool \c inPool.
+			explicit FutureState(ThreadPool* inPool) : FutureStateBase(inPool), mHasValue(false) {}
+			//! Delete state and its value.
+			~FutureState(void) {if(mHasValue) reinterpret_cast<T*>(&mStorage)->~T();}
+			
+			//! Return value of state; throw the exception of state if any (state must be ready).
+			Reference get(void) const {
+				if(mException) rethrow_exception(mException);
+				return *reinterpret_cast<const T*>(&mStorage);
+			}
+			
+			//! Set value \c inValue and make state ready.
+			template <class U>
+			void setValue(U&& inValue) {
+				new(&mStorage) T(std::forward<U>(inValue));
+				mHasValue = true;
+				setReady();
+			}
+			
+			protected:
+			typename aligned_storage<sizeof(T), alignment_of<T>::value>::type mStorage; //!< Storage of value.
+			bool mHasValue; //!< Value was constructed flag.
+		};
+		
+		/*! \brief Shared state of a future without value.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		*/
+		template <>
+		class FutureState<void> : public FutureStateBase {
+			public:
+			//! Type returned by FutureState::get.
+			typedef void Reference;
+			
+			//! Construct pending state for continuations scheduled on thread pool \c inPool.
+			explicit FutureState(ThreadPool* inPool) : FutureStateBase(inPool) {}
+			
+			//! Throw the exception of state if any (state must be ready).
+			void get(void) const {if(mException) rethrow_exception(mException);}
+			
+			//! Make state ready.
+			void setValue(void) {setReady();}
+		};
+		
+		/*! \brief Set the result of nullary function \c inFunction into state \c ioState.
+		
+		Any exception thrown by the function is stored into the state instead.
+		*/
+		template <class T, class Function>
+		void setFutureResult(FutureState<T>& ioState, Function& inFunction)
+		{
+			try {ioState.setValue(inFunction());}
+			catch(...) {ioState.setException(current_exception());}
+		}
+		
+		//! Set the result of nullary function \c inFunction into state \c ioState (void specialization).
+		template <class Function>
+		void setFutureResult(FutureState<void>& ioState, Function& inFunction)
+		{
+			try {inFunction(); ioState.setValue();}
+			catch(...) {ioState.setException(current_exception());}
+		}
+		
+		//! Call continuation \c inFunction with the value of ready state \c inState.
+		template <class T, class Function>
+		auto callContinuation(Function& inFunction, const FutureState<T>& inState) -> decltype(inFunction(inState.get()))
+		{
+			return inFunction(inState.get());
+		}
+		
+		//! Call continuation \c inFunction after ready state \c inState (void specialization).
+		template <class Function>
+		auto callContinuation(Function& inFunction, const FutureState<void>&) -> decltype(inFunction())
+		{
+			return inFunction();
+		}
+		
+		/*! \brief Detached task that runs a function and sets its result into a future state.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		This task is created by ThreadPool::submit, and is deleted by the thread pool after it has run.
+		*/
+		template <class T, class Function>
+		class FutureTask : public Task {
+			public:
+			//! Construct task for function \c inFunction and result state \c inResult.
+			FutureTask(const shared_ptr<FutureState<T> >& inResult, Function&& inFunction)
+			: mResult(inResult), mFunction(std::move(inFunction)) {}
+			
+			//! Run function and set result.
+			void main(void) {setFutureResult(*mResult, mFunction);}
+			
+			//! Set a Threading::Exception with code Threading::eCanceled as result, without running the function.
+			void skip(void) {
+				mResult->setException(make_exception_ptr(Exception(eCanceled, "FutureTask::skip() task canceled before it started")));
+			}
+			
+			protected:
+			shared_ptr<FutureState<T> > mResult; //!< Result state.
+			Function mFunction; //!< Function to run.
+		};
+		
+		/*! \brief Continuation of a future.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		This object is both a callback of the antecedent future and a detached task: when the antecedent becomes ready, it is pushed onto the thread pool of the antecedent, which runs it and then deletes it. If the antecedent holds an exception, the continuation function is not called and the exception is propagated to the result.
+		*/
+		template <class T, class U, class Function>
+		class ContinuationTask : public Task, public FutureCallback {
+			public:
+			//! Construct continuation \c inFunction of state \c inAntecedent, with result state \c inResult.
+			ContinuationTask(const shared_ptr<FutureState<T> >& inAntecedent, const shared_ptr<FutureState<U> >& inResult, Function&& inFunction)
+			: mAntecedent(inAntecedent), mResult(inResult), mFunction(std::move(inFunction)) {}
+			
+			//! Schedule continuation on the thread pool.
+			void invoke(void) {mAntecedent->schedule(this);}
+			
+			//! Run continuation and set result.
+			void main(void) {
+				if(mAntecedent->hasException()) mResult->setException(mAntecedent->getException());
+				else {
+					auto lCall = [this]() {return callContinuation(mFunction, *mAntecedent);};
+					setFutureResult(*mResult, lCall);
+				}
+			}
+			
+			protected:
+			shared_ptr<FutureState<T> > mAntecedent; //!< Antecedent state.
+			shared_ptr<FutureState<U> > mResult; //!< Result state.
+			Function mFunction; //!< Continuation function.
+		};
+		
+		/*! \brief Future result of an asynchronous computation.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		A future is returned by method ThreadPool::submit, and gives access to the value returned by the submitted function (or to the exception that it has thrown). Futures are cheap to copy, since all copies share the same state. Here is a simple usage example:
+		\code
+ThreadPool lPool(4);
+Future<int> lAnswer = lPool.submit([]() {return 6*7;});
+Future<string> lText = lAnswer.then([](int inValue) {return to_string(inValue);});
+cout << lText.get() << endl;
+		\endcode
+		
+		Method Future::get blocks the calling thread until the value is ready. Continuations attached with method Future::then do not block any thread: they are pushed onto the thread pool as soon as the future becomes ready. Functions whenAll and whenAny combine several futures into one.
+		*/
+		template <class T>
+		class Future {
+			public:
+			//! Construct invalid future (without state).
+			Future(void) {}
+			//! Construct future for shared state \c inState.
+			explicit Future(const shared_ptr<FutureState<T> >& inState) : mState(inState) {}
+			
+			//! Return shared state of future.
+			const shared_ptr<FutureState<T> >& getState(void) const {return mState;}
+			
+			//! Return whether future has a state.
+			bool isValid(void) const {return (bool)mState;}
+			
+			//! Return whether future is ready (i.e. whether Future::get would not block).
+			bool isReady(void) const {checkValid(); return mState->isReady();}
+			
+			/*! \brief Wait for future and return its value.
+			
+			If the function that computes the future has thrown an exception, this exception is thrown again.
+			*/
+			typename FutureState<T>::Reference get(void) const {wait(); return mState->get();}
+			
+			//! Wait for future to become ready.
+			void wait(void) const {checkValid(); mState->wait();}
+			
+			/*! \brief Attach continuation \c inFunction to this future.
+			\return Future of the value returned by the continuation.
+			
+			The continuation is called with the value of this future as argument (without argument for a future of type \c void), and is executed by the thread pool of this future once this future is ready. If this future holds an exception, the continuation is not called and the returned future holds the same exception.
+			*/
+			template <class Function>
+			auto then(Function inFunction) const -> Future<decltype(callContinuation(inFunction, declval<const FutureState<T>&>()))> {
+				typedef decltype(callContinuation(inFunction, declval<const FutureState<T>&>())) U;
+				checkValid();
+				if(!mState->getPool()) throw Exception(eOtherError, "Future::then: future has no thread pool");
+				shared_ptr<FutureState<U> > lResult = make_shared<FutureState<U> >(mState->getPool());
+				mState->addCallback(new ContinuationTask<T, U, Function>(mState, lResult, std::move(inFunction)));
+				return Future<U>(lResult);
+			}
+			
+			protected:
+			shared_ptr<FutureState<T> > mState; //!< Shared state.
+			
+			//! Throw exception if future is invalid.
+			void checkValid(void) const {
+				if(!mState) throw Exception(eOtherError, "Future: invalid future (no state)");
+			}
+		};
+		
+		/*! \brief Joint state of function whenAll.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		*/
+		template <class T, class R>
+		class WhenAllJoint {
+			public:
+			//! Construct joint state of futures \c inFutures; the count includes one extra reference for the caller.
+			WhenAllJoint(const vector<Future<T> >& inFutures, const shared_ptr<FutureState<R> >& inResult)
+			: mFutures(inFutures), mResult(inResult), mCount(inFutures.size()+1) {}
+			
+			//! Count one more ready future, and set result when all are ready.
+			void count(void) {
+				if(mCount.fetch_sub(1, memory_order_acq_rel) != 1) return;
+				for(size_t i = 0; i < mFutures.size(); ++i) {
+					if(mFutures[i].getState()->hasException()) {
+						mResult->setException(mFutures[i].getState()->getException());
+						return;
+					}
+				}
+				setResult(*mResult);
+			}
+			
+			protected:
+			vector<Future<T> > mFutures; //!< Input futures.
+			shared_ptr<FutureState<R> > mResult; //!< Result state.
+			atomic<size_t> mCount; //!< Number of futures not ready yet.
+			
+			//! Set vector of values as result.
+			template <class V>
+			void setResult(FutureState<V>& ioResult) {
+				V lValues;
+				lValues.reserve(mFutures.size());
+				for(size_t i = 0; i < mFutures.size(); ++i) lValues.push_back(mFutures[i].getState()->get());
+				ioResult.setValue(std::move(lValues));
+			}
+			//! Set void result.
+			void setResult(FutureState<void>& ioResult) {ioResult.setValue();}
+		};
+		
+		/*! \brief Joint state of function whenAny.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		*/
+		class WhenAnyJoint {
+			public:
+			//! Construct joint state for result state \c inResult.
+			explicit WhenAnyJoint(const shared_ptr<FutureState<size_t> >& inResult) : mResult(inResult), mDone(false) {}
+			
+			//! Set index \c inIndex as result, unless another future was ready first.
+			void count(size_t inIndex) {if(!mDone.exchange(true, memory_order_acq_rel)) mResult->setValue(inIndex);}
+			
+			protected:
+			shared_ptr<FutureState<size_t> > mResult; //!< Result state.
+			atomic<bool> mDone; //!< Result is set flag.
+		};
+		
+		/*! \brief Callback that notifies a joint state of whenAll or whenAny.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		*/
+		template <class Joint>
+		class JointCallback : public FutureCallback {
+			public:
+			//! Construct callback for input \c inIndex of joint state \c inJoint.
+			JointCallback(const shared_ptr<Joint>& inJoint, size_t inIndex) : mJoint(inJoint), mIndex(inIndex) {}
+			
+			//! Notify joint state, and delete callback.
+			void invoke(void) {notify(*mJoint); delete this;}
+			
+			protected:
+			shared_ptr<Joint> mJoint; //!< Joint state.
+			size_t mIndex; //!< Index of input future.
+			
+			//! Notify joint state of whenAny.
+			void notify(WhenAnyJoint& ioJoint) {ioJoint.count(mIndex);}
+			//! Notify joint state of whenAll.
+			template <class J>
+			void notify(J& ioJoint) {ioJoint.count();}
+		};
+		
+		/*! \brief Return a future that becomes ready when all futures \c inFutures are ready.
+		
+		For futures of type \c T, the returned future holds the vector of their values (in the same order). For futures of type \c void, it holds nothing. If any input future holds an exception, the returned future holds the exception of the first such input. The returned future inherits the thread pool of the first input (it has no thread pool if \c inFutures is empty, and thus accepts no continuation). The joint state is updated by the threads that make the inputs ready; no thread is blocked.
+		*/
+		template <class T>
+		Future<typename conditional<is_void<T>::value, void, vector<T> >::type> whenAll(const vector<Future<T> >& inFutures)
+		{
+			typedef typename conditional<is_void<T>::value, void, vector<T> >::type R;
+			shared_ptr<FutureState<R> > lResult = make_shared<FutureState<R> >(inFutures.empty() ? 0 : inFutures.front().getState()->getPool());
+			shared_ptr<WhenAllJoint<T, R> > lJoint = make_shared<WhenAllJoint<T, R> >(inFutures, lResult);
+			for(size_t i = 0; i < inFutures.size(); ++i) {
+				inFutures[i].getState()->addCallback(new JointCallback<WhenAllJoint<T, R> >(lJoint, i));
+			}
+			// release the extra count held during registration
+			lJoint->count();
+			return Future<R>(lResult);
+		}
+		
+		/*! \brief Return a future that becomes ready when any of futures \c inFutures is ready.
+		
+		The returned future holds the index of the first input that became ready (whether it holds a value or an exception). It inherits the thread pool of the first input. An exception is thrown if \c inFutures is empty.
+		*/
+		template <class T>
+		Future<size_t> whenAny(const vector<Future<T> >& inFutures)
+		{
+			if(inFutures.empty()) throw Exception(eOtherError, "whenAny: empty vector of futures");
+			shared_ptr<FutureState<size_t> > lResult = make_shared<FutureState<size_t> >(inFutures.front().getState()->getPool());
+			shared_ptr<WhenAnyJoint> lJoint = make_shared<WhenAnyJoint>(lResult);
+			for(size_t i = 0; i < inFutures.size() && !lResult->isReady(); ++i) {
+				inFutures[i].getState()->addCallback(new JointCallback<WhenAnyJoint>(lJoint, i));
+			}
+			return Future<size_t>(lResult);
+		}
+		
+	} // end of Threading namespace
+	
+} // end of PACC namespace
+
+#endif // PACC_Threading_Future_hpp_
@@ -0,0 +1,99 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/Latch.cpp
+ * \brief Class methods for the one-shot count down latch.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#include "PACC/Threading/Latch.hpp"
+#include "PACC/Threading/ThreadPool.hpp"
+#include "PACC/Threading/Topology.hpp"
+#include "PACC/Util/Timer.hpp"
+
+using namespace std;
+using namespace PACC;
+
+/*! \brief Construct latch with count \c inCount.
+
+A null count constructs an open latch. Waiting threads spin for at most 1000 iterations, or never spin on single processor systems.
+*/
+Threading::Latch::Latch(unsigned int inCount) : mCount(inCount), mMaxSpin(0)
+{
+	if(Topology::getCPUCount() > 1) mMaxSpin = 1000;
+}
+
+/*! \brief Decrement count by \c inCount, and open the latch if it reaches zero.
+
+Counting down by more than the current count raises a Threading::Exception (and leaves the count unchanged).
+*/
+void Threading::Latch::countDown(unsigned int inCount)
+{
+	if(inCount == 0) return;
+	unsigned int lCount = mCount.load(memory_order_relaxed);
+	do {
+		if(inCount > lCount) throw Exception(eOtherError, "Latch::countDown() count would become negative");
+	} while(!mCount.compare_exchange_weak(lCount, lCount-inCount, memory_order_acq_rel, memory_order_relaxed));
+	if(lCount == inCount) mEvent.notifyAll();
+}
+
+/*! \brief Wait up to \c inMaxTime seconds for the latch to open.
+\return True if the latch is open, false if timed out.
+
+A negative or null time out (default) means that the method should wait indefinitely. A slave of a thread pool executes pending tasks while it waits, and can therefore return later than the time out.
+*/
+bool Threading::Latch::wait(double inMaxTime)
+{
+	if(tryWait()) return true;
+	for(unsigned int i = 0; i < mMaxSpin; ++i) {
+		Thread::pause();
+		if(tryWait()) return true;
+	}
+	SlaveThread* lSlave = SlaveThread::getCurrent();
+	Timer lTimer;
+	for(;;) {
+		if(tryWait()) return true;
+		double lRemaining = 0;
+		if(inMaxTime > 0) {
+			lRemaining = inMaxTime - lTimer.getValue();
+			if(lRemaining <= 0) return false;
+		}
+		// help the pool of the calling slave, if any
+		if(lSlave && lSlave->getPool()->runPending()) continue;
+		unsigned int lKey = mEvent.prepareWait();
+		if(tryWait()) {
+			mEvent.cancelWait();
+			return true;
+		}
+		// a parked slave checks its pool again every millisecond
+		if(lSlave && (lRemaining == 0 || lRemaining > 0.001)) lRemaining = 0.001;
+		mEvent.wait(lKey, lRemaining);
+	}
+}
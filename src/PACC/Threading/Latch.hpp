@@ -0,0 +1,82 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/Latch.hpp
+ * \brief Class definition for the one-shot count down latch.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#ifndef PACC_Threading_Latch_hpp_
+#define PACC_Threading_Latch_hpp_
+
+#include "PACC/Threading/EventCount.hpp"
+
+namespace PACC { 
+	
+	namespace Threading {
+		
+		/*! \brief One-shot count down latch (count down event).
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		A latch is initialized with a count (see constructor) that threads decrement with Latch::countDown. Threads that call Latch::wait block until the count reaches zero; from then on, the latch stays open and Latch::wait returns immediately. Contrary to a Barrier, the counting threads do not need to wait, and the waiting threads do not need to count: a latch typically lets one thread wait for the completion of a set of tasks, or lets a set of threads start at the same time.
+		
+		Counting down is a single atomic operation, and only the thread that opens the latch wakes up the waiting threads, if any. Waiting threads spin for a bounded number of iterations (on multiprocessor systems), and then park on an EventCount. As with class Barrier, a waiting slave of a thread pool executes the pending tasks of its pool (see ThreadPool::runPending) before parking, and checks its pool again every millisecond while parked.
+		*/
+		class Latch {
+			public:
+			explicit Latch(unsigned int inCount);
+			
+			void countDown(unsigned int inCount=1);
+			//! Count down by \c inCount, and wait for the latch to open.
+			void countDownAndWait(unsigned int inCount=1) {countDown(inCount); wait();}
+			//! Return current count (0 if the latch is open).
+			unsigned int getCount(void) const {return mCount.load(memory_order_acquire);}
+			//! Return true if the latch is open (count is null), without blocking.
+			bool tryWait(void) const {return mCount.load(memory_order_acquire) == 0;}
+			bool wait(double inMaxTime=0);
+			
+			protected:
+			atomic<unsigned int> mCount; //!< Remaining count.
+			unsigned int mMaxSpin; //!< Maximum number of spin iterations before helping or parking.
+			EventCount mEvent; //!< Event count on which waiting threads park.
+			
+			private:
+			//! restrict (disable) copy constructor.
+			Latch(const Latch&);
+			//! restrict (disable) assignment operator.
+			void operator=(const Latch&);
+		};
+		
+	} // end of Threading namespace
+	
+} // end of PACC namespace
+
+#endif // PACC_Threading_Latch_hpp_
@@ -0,0 +1,184 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/LockProfiler.cpp
+ * \brief Class methods for the lock contention profiler.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#include "PACC/Threading/LockProfiler.hpp"
+#include "PACC/Threading/Mutex.hpp"
+#include "PACC/Util/Timer.hpp"
+#include "PACC/config.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <map>
+
+using namespace std;
+using namespace PACC;
+
+namespace {
+	
+	//! Registry of lock profiles.
+	struct Registry {
+		Threading::Mutex mMutex; //!< Mutex that protects the profiles (never profiled itself).
+		map<string, Threading::LockProfile*> mProfiles; //!< Profiles indexed by name.
+		Timer mTimer; //!< Timer used for all time measurements.
+	};
+	
+	//! Return the registry (constructed on first use, and never destroyed, so that named locks can have static storage).
+	Registry& getRegistry(void)
+	{
+		static Registry* lRegistry = new Registry;
+		return *lRegistry;
+	}
+	
+	//! Order records by key \c mKey.
+	struct RecordOrder {
+		Threading::LockProfiler::SortKey mKey; //!< Sort key.
+		
+		RecordOrder(Threading::LockProfiler::SortKey inKey) : mKey(inKey) {}
+		bool operator()(const Threading::LockProfiler::Record& inLeft, const Threading::LockProfiler::Record& inRight) const {
+			switch(mKey) {
+				case Threading::LockProfiler::eAcquisitions: return inLeft.mAcquisitions > inRight.mAcquisitions;
+				case Threading::LockProfiler::eContentions: return inLeft.mContentions > inRight.mContentions;
+				case Threading::LockProfiler::eWaitTime: return inLeft.mWaitTime > inRight.mWaitTime;
+				case Threading::LockProfiler::eMaxWaitTime: return inLeft.mMaxWaitTime > inRight.mMaxWaitTime;
+				case Threading::LockProfiler::eHoldTime: return inLeft.mHoldTime > inRight.mHoldTime;
+				case Threading::LockProfiler::eConditionWaitTime: return inLeft.mConditionWaitTime > inRight.mConditionWaitTime;
+				default: return inLeft.mName < inRight.mName;
+			}
+		}
+	};
+	
+}
+
+//! Reset all counters of profile to zero.
+void Threading::LockProfile::reset(void)
+{
+	mAcquisitions = 0;
+	mContentions = 0;
+	mWait = 0;
+	mMaxWait = 0;
+	mHold = 0;
+	mMaxHold = 0;
+	mConditionWaits = 0;
+	mConditionWait = 0;
+}
+
+//! Return current count of the profiler timer (see Timer::getCount).
+unsigned long long Threading::LockProfiler::getCount(void)
+{
+	return getRegistry().mTimer.getCount();
+}
+
+/*! \brief Return profile of name \c inName (created if it does not exist).
+
+Profiles are never deleted, so that the returned pointer stays valid for the whole execution.
+*/
+Threading::LockProfile* Threading::LockProfiler::getProfile(const string& inName)
+{
+	Registry& lRegistry = getRegistry();
+	lRegistry.mMutex.lock();
+	LockProfile*& lProfile = lRegistry.mProfiles[inName];
+	if(lProfile == 0) lProfile = new LockProfile(inName);
+	lRegistry.mMutex.unlock();
+	return lProfile;
+}
+
+/*! \brief Return statistics of all profiles, sorted by key \c inKey.
+
+Counters are read one at a time while the locks are in use, so a snapshot is not atomic. Profiles without any acquisition are omitted.
+*/
+vector<Threading::LockProfiler::Record> Threading::LockProfiler::getSnapshot(SortKey inKey)
+{
+	Registry& lRegistry = getRegistry();
+	double lPeriod = lRegistry.mTimer.getCountPeriod();
+	vector<Record> lRecords;
+	lRegistry.mMutex.lock();
+	for(map<string, LockProfile*>::const_iterator lIter = lRegistry.mProfiles.begin(); lIter != lRegistry.mProfiles.end(); ++lIter) {
+		const LockProfile& lProfile = *lIter->second;
+		Record lRecord;
+		lRecord.mName = lProfile.mName;
+		lRecord.mAcquisitions = lProfile.mAcquisitions.load(memory_order_relaxed);
+		if(lRecord.mAcquisitions == 0) continue;
+		lRecord.mContentions = lProfile.mContentions.load(memory_order_relaxed);
+		lRecord.mWaitTime = lProfile.mWait.load(memory_order_relaxed) * lPeriod;
+		lRecord.mMaxWaitTime = lProfile.mMaxWait.load(memory_order_relaxed) * lPeriod;
+		lRecord.mHoldTime = lProfile.mHold.load(memory_order_relaxed) * lPeriod;
+		lRecord.mMaxHoldTime = lProfile.mMaxHold.load(memory_order_relaxed) * lPeriod;
+		lRecord.mConditionWaits = lProfile.mConditionWaits.load(memory_order_relaxed);
+		lRecord.mConditionWaitTime = lProfile.mConditionWait.load(memory_order_relaxed) * lPeriod;
+		lRecords.push_back(lRecord);
+	}
+	lRegistry.mMutex.unlock();
+	stable_sort(lRecords.begin(), lRecords.end(), RecordOrder(inKey));
+	return lRecords;
+}
+
+//! Return true if lock profiling was enabled at compile time (see class LockProfiler).
+bool Threading::LockProfiler::isEnabled(void)
+{
+#ifdef PACC_LOCK_PROFILING
+	return true;
+#else
+	return false;
+#endif
+}
+
+//! Reset the counters of all profiles to zero.
+void Threading::LockProfiler::reset(void)
+{
+	Registry& lRegistry = getRegistry();
+	lRegistry.mMutex.lock();
+	for(map<string, LockProfile*>::iterator lIter = lRegistry.mProfiles.begin(); lIter != lRegistry.mProfiles.end(); ++lIter) lIter->second->reset();
+	lRegistry.mMutex.unlock();
+}
+
+/*! \brief Write snapshot sorted by key \c inKey as a table into stream \c outStream.
+
+Times are written in milliseconds, and the contention rate in percent of acquisitions.
+*/
+void Threading::LockProfiler::write(ostream& outStream, SortKey inKey)
+{
+	vector<Record> lRecords = getSnapshot(inKey);
+	size_t lWidth = 4;
+	for(size_t i = 0; i < lRecords.size(); ++i) lWidth = max(lWidth, lRecords[i].mName.size());
+	ios::fmtflags lFlags = outStream.flags();
+	streamsize lPrecision = outStream.precision();
+	outStream << left << setw(lWidth) << "name" << right << setw(14) << "acquisitions" << setw(12) << "contended" << setw(8) << "rate%" << setw(12) << "wait(ms)" << setw(12) << "maxwait" << setw(12) << "hold(ms)" << setw(12) << "maxhold" << setw(12) << "condwaits" << setw(12) << "cond(ms)" << endl;
+	outStream << fixed << setprecision(3);
+	for(size_t i = 0; i < lRecords.size(); ++i) {
+		const Record& lRecord = lRecords[i];
+		outStream << left << setw(lWidth) << lRecord.mName << right << setw(14) << lRecord.mAcquisitions << setw(12) << lRecord.mContentions << setw(8) << setprecision(1) << 100.0*lRecord.mContentions/lRecord.mAcquisitions << setprecision(3) << setw(12) << lRecord.mWaitTime*1000 << setw(12) << lRecord.mMaxWaitTime*1000 << setw(12) << lRecord.mHoldTime*1000 << setw(12) << lRecord.mMaxHoldTime*1000 << setw(12) << lRecord.mConditionWaits << setw(12) << lRecord.mConditionWaitTime*1000 << endl;
+	}
+	outStream.flags(lFlags);
+	outStream.precision(lPrecision);
+}
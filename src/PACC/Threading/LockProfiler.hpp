@@ -0,0 +1,157 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/LockProfiler.hpp
+ * \brief Class definition for the lock contention profiler.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#ifndef PACC_Threading_LockProfiler_hpp_
+#define PACC_Threading_LockProfiler_hpp_
+
+#include <atomic>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace PACC { 
+	
+	namespace Threading {
+		
+		/*! \brief Accumulated contention counters of the locks that share a name.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		Profiles are created and owned by class LockProfiler; they are updated by named Mutex and Condition objects when lock profiling is enabled. All counters are atomic, and times are expressed in Timer counts.
+		*/
+		class LockProfile {
+			public:
+			//! Construct profile of name \c inName, with null counters.
+			explicit LockProfile(const std::string& inName) : mName(inName) {reset();}
+			
+			//! Record an acquisition that waited \c inWait counts (0 if uncontended).
+			void addAcquisition(unsigned long long inWait) {
+				mAcquisitions.fetch_add(1, std::memory_order_relaxed);
+				if(inWait == 0) return;
+				mContentions.fetch_add(1, std::memory_order_relaxed);
+				mWait.fetch_add(inWait, std::memory_order_relaxed);
+				updateMax(mMaxWait, inWait);
+			}
+			//! Record a condition wait of \c inWait counts.
+			void addConditionWait(unsigned long long inWait) {
+				mConditionWaits.fetch_add(1, std::memory_order_relaxed);
+				mConditionWait.fetch_add(inWait, std::memory_order_relaxed);
+			}
+			//! Record a hold period of \c inHold counts.
+			void addHold(unsigned long long inHold) {
+				mHold.fetch_add(inHold, std::memory_order_relaxed);
+				updateMax(mMaxHold, inHold);
+			}
+			//! Return name of profile.
+			const std::string& getName(void) const {return mName;}
+			void reset(void);
+			
+			protected:
+			std::string mName; //!< Name shared by the profiled locks.
+			std::atomic<unsigned long long> mAcquisitions; //!< Number of acquisitions.
+			std::atomic<unsigned long long> mContentions; //!< Number of acquisitions that had to wait.
+			std::atomic<unsigned long long> mWait; //!< Total wait time for acquisitions.
+			std::atomic<unsigned long long> mMaxWait; //!< Longest wait time for an acquisition.
+			std::atomic<unsigned long long> mHold; //!< Total hold time.
+			std::atomic<unsigned long long> mMaxHold; //!< Longest hold time.
+			std::atomic<unsigned long long> mConditionWaits; //!< Number of condition waits.
+			std::atomic<unsigned long long> mConditionWait; //!< Total time spent waiting on conditions.
+			
+			//! Raise \c ioMax to \c inValue if it is larger.
+			static void updateMax(std::atomic<unsigned long long>& ioMax, unsigned long long inValue) {
+				unsigned long long lMax = ioMax.load(std::memory_order_relaxed);
+				while(inValue > lMax && !ioMax.compare_exchange_weak(lMax, inValue, std::memory_order_relaxed));
+			}
+			
+			friend class LockProfiler;
+			
+			private:
+			//! restrict (disable) copy constructor.
+			LockProfile(const LockProfile&);
+			//! restrict (disable) assignment operator.
+			void operator=(const LockProfile&);
+		};
+		
+		/*! \brief Lock contention profiler.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		Lock profiling is enabled at compile time, with the CMake option PACC_USE_LOCK_PROFILING (which defines PACC_LOCK_PROFILING in PACC/config.hpp). It is then opt-in for every lock: only the Mutex and Condition objects that were given a name (see Mutex::setName) are profiled, and all locks that share the same name are accumulated in the same LockProfile. The library names the locks of its own classes after them (e.g. "ThreadPool" or "TCPServer").
+		
+		For each name, the profiler records the number of acquisitions, the number of contended acquisitions (those for which Mutex::lock had to spin or block), the total and maximum wait time of contended acquisitions, the total and maximum hold time, and the number and total time of condition waits (see Condition::wait), which are excluded from the hold time. Method LockProfiler::getSnapshot returns these statistics sorted by decreasing order of a given key, and method LockProfiler::write prints them as a table:
+		\code
+Threading::LockProfiler::write(cout, Threading::LockProfiler::eWaitTime);
+		\endcode
+		When profiling is disabled, the Mutex and Condition classes do not reference the profiler at all, so that there is no overhead; snapshots are then empty.
+		*/
+		class LockProfiler {
+			public:
+			//! Sort keys of snapshots.
+			enum SortKey {
+				eName, //!< Sort by increasing name.
+				eAcquisitions, //!< Sort by decreasing number of acquisitions.
+				eContentions, //!< Sort by decreasing number of contended acquisitions.
+				eWaitTime, //!< Sort by decreasing total wait time.
+				eMaxWaitTime, //!< Sort by decreasing maximum wait time.
+				eHoldTime, //!< Sort by decreasing total hold time.
+				eConditionWaitTime //!< Sort by decreasing total condition wait time.
+			};
+			
+			//! Statistics of a profile.
+			struct Record {
+				std::string mName; //!< Name of profiled locks.
+				unsigned long long mAcquisitions; //!< Number of acquisitions.
+				unsigned long long mContentions; //!< Number of contended acquisitions.
+				double mWaitTime; //!< Total wait time of contended acquisitions (in seconds).
+				double mMaxWaitTime; //!< Maximum wait time of an acquisition (in seconds).
+				double mHoldTime; //!< Total hold time (in seconds).
+				double mMaxHoldTime; //!< Maximum hold time (in seconds).
+				unsigned long long mConditionWaits; //!< Number of condition waits.
+				double mConditionWaitTime; //!< Total condition wait time (in seconds).
+			};
+			
+			static unsigned long long getCount(void);
+			static LockProfile* getProfile(const std::string& inName);
+			static std::vector<Record> getSnapshot(SortKey inKey=eWaitTime);
+			static bool isEnabled(void);
+			static void reset(void);
+			static void write(std::ostream& outStream, SortKey inKey=eWaitTime);
+		};
+		
+	} // end of Threading namespace
+	
+} // end of PACC namespace
+
+#endif // PACC_Threading_LockProfiler_hpp_
@@ -0,0 +1,176 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/MPMCQueue.hpp
+ * \brief Class definition for the bounded lock-free multi-producer multi-consumer queue.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#ifndef PACC_Threading_MPMCQueue_hpp_
+#define PACC_Threading_MPMCQueue_hpp_
+
+#include <atomic>
+#include <cstddef>
+
+namespace PACC { 
+	
+	using namespace std;
+	
+	namespace Threading {
+		
+		/*! \brief Bounded lock-free multi-producer multi-consumer FIFO queue.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		This class implements the bounded queue of Dmitry Vyukov: a circular array of cells, each tagged with a sequence number that tells producers and consumers whether the cell is free or full for the current lap. Any number of threads can call MPMCQueue::push and MPMCQueue::pop concurrently; each operation costs a single compare-and-swap when uncontended, and neither of them ever blocks. Method MPMCQueue::push returns false when the queue is full, and MPMCQueue::pop returns false when it is empty.
+		
+		Elements are copied in and out of the cells, so that type \c T should be cheap to copy (e.g. a pointer).
+		*/
+		template <class T>
+		class MPMCQueue {
+			public:
+			//! Construct empty queue of capacity \c inCapacity (rounded up to a power of two).
+			MPMCQueue(size_t inCapacity=1024) : mHead(0), mTail(0) {
+				size_t lCapacity = 2;
+				while(lCapacity < inCapacity) lCapacity *= 2;
+				mMask = lCapacity-1;
+				mCells = new Cell[lCapacity];
+				for(size_t i = 0; i < lCapacity; ++i) mCells[i].mSequence.store(i, memory_order_relaxed);
+			}
+			//! Delete queue.
+			~MPMCQueue(void) {delete[] mCells;}
+			
+			//! Return whether the queue is (momentarily) empty.
+			bool empty(void) const {return mHead.load(memory_order_relaxed) >= mTail.load(memory_order_relaxed);}
+			//! Return the capacity of the queue.
+			size_t getCapacity(void) const {return mMask+1;}
+			//! Return the (momentary) number of elements in the queue.
+			size_t size(void) const {
+				size_t lHead = mHead.load(memory_order_relaxed), lTail = mTail.load(memory_order_relaxed);
+				return lTail > lHead ? lTail-lHead : 0;
+			}
+			
+			//! Remove element at the head of the queue into \c outValue; return false if the queue is empty.
+			bool pop(T& outValue) {
+				size_t lPos = mHead.load(memory_order_relaxed);
+				for(;;) {
+					Cell& lCell = mCells[lPos & mMask];
+					size_t lSequence = lCell.mSequence.load(memory_order_acquire);
+					ptrdiff_t lDiff = (ptrdiff_t) lSequence - (ptrdiff_t) (lPos+1);
+					if(lDiff == 0) {
+						if(mHead.compare_exchange_weak(lPos, lPos+1, memory_order_relaxed)) {
+							outValue = lCell.mValue;
+							lCell.mSequence.store(lPos+mMask+1, memory_order_release);
+							return true;
+						}
+					}
+					else if(lDiff < 0) return false;
+					else lPos = mHead.load(memory_order_relaxed);
+				}
+			}
+			
+			//! Remove up to \c inMaxCount elements at the head of the queue into array \c outValues; return the number of removed elements.
+			size_t pop(T* outValues, size_t inMaxCount) {
+				size_t lCount = 0;
+				while(lCount < inMaxCount && pop(outValues[lCount])) ++lCount;
+				return lCount;
+			}
+			
+			//! Append element \c inValue at the tail of the queue; return false if the queue is full.
+			bool push(const T& inValue) {
+				size_t lPos = mTail.load(memory_order_relaxed);
+				for(;;) {
+					Cell& lCell = mCells[lPos & mMask];
+					size_t lSequence = lCell.mSequence.load(memory_order_acquire);
+					ptrdiff_t lDiff = (ptrdiff_t) lSequence - (ptrdiff_t) lPos;
+					if(lDiff == 0) {
+						if(mTail.compare_exchange_weak(lPos, lPos+1, memory_order_relaxed)) {
+							lCell.mValue = inValue;
+							lCell.mSequence.store(lPos+1, memory_order_release);
+							return true;
+						}
+					}
+					else if(lDiff < 0) return false;
+					else lPos = mTail.load(memory_order_relaxed);
+				}
+			}
+			
+			/*! \brief Append the \c inCount elements of array \c inValues at the tail of the queue; return false if the queue does not have room for all of them.
+			
+			The elements are reserved with a single compare-and-swap, and are either all pushed or none of them. A cell that a consumer is still reading from the previous lap is waited for (this lasts at most the time of a copy). Consumers cannot pop the elements of the batch before they are written.
+			*/
+			bool push(const T* inValues, size_t inCount) {
+				if(inCount > mMask+1) return false;
+				size_t lPos = mTail.load(memory_order_relaxed);
+				for(;;) {
+					size_t lHead = mHead.load(memory_order_acquire);
+					if(lHead > lPos) {
+						lPos = mTail.load(memory_order_relaxed);
+						continue;
+					}
+					if(lPos + inCount - lHead > mMask+1) return false;
+					if(mTail.compare_exchange_weak(lPos, lPos+inCount, memory_order_relaxed)) break;
+				}
+				for(size_t i = 0; i < inCount; ++i) {
+					Cell& lCell = mCells[(lPos+i) & mMask];
+					while(lCell.mSequence.load(memory_order_acquire) != lPos+i);
+					lCell.mValue = inValues[i];
+					lCell.mSequence.store(lPos+i+1, memory_order_release);
+				}
+				return true;
+			}
+			
+			protected:
+			//! Cell of the circular array.
+			struct Cell {
+				atomic<size_t> mSequence; //!< Sequence number of cell.
+				T mValue; //!< Stored element.
+			};
+			
+			Cell* mCells; //!< Circular array of cells.
+			size_t mMask; //!< Capacity minus one.
+			char mPad1[64]; //!< Keep head on its own cache line.
+			atomic<size_t> mHead; //!< Position of next element to pop.
+			char mPad2[64]; //!< Keep tail on its own cache line.
+			atomic<size_t> mTail; //!< Position of next element to push.
+			char mPad3[64]; //!< Keep tail on its own cache line.
+			
+			private:
+			//! restrict (disable) copy constructor.
+			MPMCQueue(const MPMCQueue&);
+			//! restrict (disable) assignment operator.
+			void operator=(const MPMCQueue&);
+		};
+		
+	} // end of Threading namespace
+	
+} // end of PACC namespace
+
+#endif // PACC_Threading_MPMCQueue_hpp_
@@ -47,6 +47,9 @@
  */
 
 #include "PACC/Threading/Mutex.hpp"
+#include "PACC/Threading/LockProfiler.hpp"
+#include "PACC/Threading/Thread.hpp"
+#include "PACC/Threading/Topology.hpp"
 #include "PACC/config.hpp"
 
 #ifdef PACC_THREADS_WIN32
@@ -59,12 +62,19 @@ typedef HANDLE pthread_mutex_t;
 
 using namespace PACC;
 
-/*! \brief Allocate native structure and create mutex. 
+/*! \brief Allocate native structure and create mutex using locking mode \c inMode.
 
-Any error raised a Threading:Exception.
+An adaptive mutex spins for at most 1000 iterations before blocking, or never spins on single processor systems. Any error raised a Threading:Exception.
 */
-Threading::Mutex::Mutex(void)
+Threading::Mutex::Mutex(Mode inMode) : mMode(inMode), mMaxSpin(0), mSpin(0)
+#ifdef PACC_LOCK_PROFILING
+, mProfile(0), mHoldStart(0)
+#endif
 {
+	if(inMode == eAdaptive && Topology::getCPUCount() > 1) {
+		mMaxSpin = 1000;
+		mSpin = 50;
+	}
 	pthread_mutex_t* lMutex = new pthread_mutex_t;
 #ifdef PACC_THREADS_WIN32
 	if((*lMutex = ::CreateMutex(0, 0, 0)) == 0)
@@ -95,9 +105,29 @@ Threading::Mutex::~Mutex(void)
 
 /*! \brief Lock the mutex.
 
-A thread should never lock a mutex twice consecutively (without calling method Mutex::unlock). Any error will raise a Threading::Exception.
+A thread should never lock a mutex twice consecutively (without calling method Mutex::unlock). An adaptive mutex first spins (see Mutex::spin), and then blocks. Any error will raise a Threading::Exception.
 */
 void Threading::Mutex::lock(void) const
+{
+#ifdef PACC_LOCK_PROFILING
+	if(mProfile) {
+		if(tryLockNative()) {
+			mHoldStart = LockProfiler::getCount();
+			mProfile->addAcquisition(0);
+			return;
+		}
+		unsigned long long lStart = LockProfiler::getCount();
+		if(mMaxSpin == 0 || !spin()) lockNative();
+		mHoldStart = LockProfiler::getCount();
+		mProfile->addAcquisition(mHoldStart > lStart ? mHoldStart-lStart : 1);
+		return;
+	}
+#endif
+	if(mMaxSpin == 0 || !spin()) lockNative();
+}
+
+//! Lock the native mutex (block if already locked).
+void Threading::Mutex::lockNative(void) const
 {
 	pthread_mutex_t* lMutex = (pthread_mutex_t*) mMutex;
 #ifdef PACC_THREADS_WIN32
@@ -108,6 +138,39 @@ void Threading::Mutex::lock(void) const
 			throw Exception(eWouldDeadLock, "Mutex::lock() can't lock!");
 }
 
+#ifdef PACC_LOCK_PROFILING
+/*! \brief Set profiling name of mutex to \c inName (see class LockProfiler).
+
+The mutex is then profiled along with all other locks of the same name. A null name stops profiling. This method should be called before the mutex is used.
+*/
+void Threading::Mutex::setName(const char* inName)
+{
+	mProfile = (inName ? LockProfiler::getProfile(inName) : 0);
+}
+#endif
+
+/*! \brief Spin for a bounded number of iterations, trying to lock the mutex.
+\return True if the mutex was acquired, false otherwise.
+
+An adaptive mutex spins for up to twice its current spin estimate (bounded by its maximum). The estimate moves by 1/8 towards the number of iterations that this attempt needed (or the bound, if it failed).
+*/
+bool Threading::Mutex::spin(void) const
+{
+	if(tryLockNative()) return true;
+	int lSpin = mSpin.load(std::memory_order_relaxed);
+	int lLimit = 2*lSpin+10;
+	if(lLimit > (int) mMaxSpin) lLimit = mMaxSpin;
+	for(int i = 1; i <= lLimit; ++i) {
+		Thread::pause();
+		if(tryLockNative()) {
+			mSpin.store(lSpin + (i-lSpin)/8, std::memory_order_relaxed);
+			return true;
+		}
+	}
+	mSpin.store(lSpin + (lLimit-lSpin)/8, std::memory_order_relaxed);
+	return false;
+}
+
 /*! \brief Try to lock the mutex without blocking.
 
 Return's true if successful; false otherwise.
@@ -115,6 +178,19 @@ Return's true if successful; false otherwise.
 Any error will raise a Threading::Exception.
 */
 bool Threading::Mutex::tryLock(void) const
+{
+	if(!tryLockNative()) return false;
+#ifdef PACC_LOCK_PROFILING
+	if(mProfile) {
+		mHoldStart = LockProfiler::getCount();
+		mProfile->addAcquisition(0);
+	}
+#endif
+	return true;
+}
+
+//! Try to lock the native mutex without blocking (see Mutex::tryLock).
+bool Threading::Mutex::tryLockNative(void) const
 {
 	pthread_mutex_t* lMutex = (pthread_mutex_t*) mMutex;
 #ifdef PACC_THREADS_WIN32
@@ -137,6 +213,9 @@ A thread should never unlock a mutex twice consecutively (without calling method
 */
 void Threading::Mutex::unlock(void) const
 {
+#ifdef PACC_LOCK_PROFILING
+	if(mProfile) mProfile->addHold(LockProfiler::getCount()-mHoldStart);
+#endif
 	pthread_mutex_t* lMutex = (pthread_mutex_t*) mMutex;
 #ifdef PACC_THREADS_WIN32
 	if(::ReleaseMutex(*lMutex) == 0)
@@ -37,30 +37,63 @@
 #define PACC_Threading_Mutex_hpp_
 
 #include "PACC/Threading/Exception.hpp"
+#include "PACC/config.hpp"
+#include <atomic>
 
 namespace PACC { 
 	
 	namespace Threading {
 		
+		class LockProfile;
+		
 		/*! \brief Mutual exclusion for thread synchronization.
 		\author Marc Parizeau, Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
 		\ingroup Threading
 		
 		This class incapsulates a mutex with classic Mutex::lock, Mutex::unlock, and Mutex::tryLock methods. A thread that already has acquired the mutex should not lock it again because this could lead to a deadlock. A thread should only unlock a mutex that is has lock previously (the mutex is not recursive). Otherwise the behavior of the mutex is undetermined (OS specific). 
 		
+		An adaptive mutex (see Mutex::Mode) spins for a while before blocking in Mutex::lock, which avoids the cost of parking and waking up a thread when the mutex is held for short periods. The spin count adapts to the recent history of the mutex: it grows when spinning succeeds, and shrinks when the thread ends up blocking anyway. On single processor systems, an adaptive mutex never spins. A Condition can also be made adaptive, since it embeds its own mutex.
+		
+		When lock profiling is enabled at compile time, a mutex that was given a name (see Mutex::setName) records its acquisitions, wait times and hold times (see class LockProfiler). Otherwise, naming a mutex has no effect, and profiling costs nothing.
+		
 		This class should be compatible with any Unix that supports POSIX threads, as well as any version of Windows. It has been tested under Linux, MacOS X and Windows 2000/XP.
 		*/
 		class Mutex {
 			public:
-			Mutex(void);
+			//! Locking modes.
+			enum Mode {
+				eBlocking, //!< Block immediately when the mutex is held.
+				eAdaptive //!< Spin for a bounded (adaptive) number of iterations before blocking.
+			};
+			
+			Mutex(Mode inMode=eBlocking);
 			~Mutex(void);
 			
+			//! Return locking mode of mutex (as requested at construction, even if the mutex never spins on this system).
+			Mode getMode(void) const {return mMode;}
 			void lock(void) const;
+#ifdef PACC_LOCK_PROFILING
+			void setName(const char* inName);
+#else
+			//! Set profiling name of mutex (no effect, since lock profiling is disabled).
+			void setName(const char*) {}
+#endif
 			bool tryLock(void) const;
 			void unlock(void) const;
 			
 			protected:
 			void* mMutex; //!< Opaque structure of native mutex
+			Mode mMode; //!< Locking mode.
+			unsigned int mMaxSpin; //!< Maximum number of spin iterations (0 if blocking).
+			mutable std::atomic<int> mSpin; //!< Running estimate of the number of spin iterations needed to acquire the mutex.
+#ifdef PACC_LOCK_PROFILING
+			LockProfile* mProfile; //!< Profile of named mutex (null if unnamed).
+			mutable unsigned long long mHoldStart; //!< Profiler count at which the mutex was acquired.
+#endif
+			
+			void lockNative(void) const;
+			bool spin(void) const;
+			bool tryLockNative(void) const;
 			
 			private:
 			//! restrict (disable) copy constructor.
@@ -0,0 +1,349 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/Parallel.hpp
+ * \brief Definition of data-parallel algorithms over the thread pool.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#ifndef PACC_Threading_Parallel_hpp_
+#define PACC_Threading_Parallel_hpp_
+
+#include "PACC/Threading/ThreadPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <iterator>
+#include <vector>
+
+namespace PACC { 
+	
+	using namespace std;
+	
+	namespace Threading {
+		
+		/*! \brief Shared state of a parallel algorithm.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		This class holds the thread pool of a parallel algorithm, and the first exception thrown by any of its subranges. Once an exception has been recorded, the remaining subranges are skipped; the exception is then thrown again in the calling thread, after all subtasks have completed.
+		*/
+		class ParallelContext {
+			public:
+			//! Construct context for thread pool \c inPool.
+			explicit ParallelContext(ThreadPool& inPool) : mPool(inPool), mFailed(false) {}
+			
+			//! Record current exception, unless an exception was already recorded.
+			void fail(void) {if(!mFailed.exchange(true)) mException = current_exception();}
+			//! Return whether an exception was recorded.
+			bool hasFailed(void) const {return mFailed.load(memory_order_relaxed);}
+			//! Throw recorded exception, if any.
+			void rethrow(void) const {if(mFailed.load()) rethrow_exception(mException);}
+			
+			//! Return grain size \c inGrain, or a grain that yields about 8 subranges per thread if \c inGrain is 0, for \c inSize elements.
+			size_t getGrain(size_t inSize, size_t inGrain, size_t inMinimum=1) const {
+				if(inGrain > 0) return inGrain;
+				size_t lGrain = inSize / (8*(mPool.getMaxSlaves()+1));
+				return lGrain < inMinimum ? inMinimum : lGrain;
+			}
+			
+			ThreadPool& mPool; //!< Thread pool.
+			
+			protected:
+			atomic<bool> mFailed; //!< Exception was recorded flag.
+			exception_ptr mException; //!< First recorded exception.
+		};
+		
+		template <class Index, class Function>
+		void parallelForRange(ParallelContext& ioContext, Function& inFunction, Index inBegin, Index inEnd, Index inGrain);
+		
+		/*! \brief Task for the right half of a subrange of function parallelFor.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		*/
+		template <class Index, class Function>
+		class ParallelForTask : public Task {
+			public:
+			//! Construct task for subrange [\c inBegin, \c inEnd).
+			ParallelForTask(ParallelContext& ioContext, Function& inFunction, Index inBegin, Index inEnd, Index inGrain)
+			: mContext(ioContext), mFunction(inFunction), mBegin(inBegin), mEnd(inEnd), mGrain(inGrain) {}
+			
+			//! Process subrange.
+			void main(void) {parallelForRange(mContext, mFunction, mBegin, mEnd, mGrain);}
+			
+			protected:
+			ParallelContext& mContext; //!< Shared state.
+			Function& mFunction; //!< Loop body.
+			Index mBegin; //!< Beginning of subrange.
+			Index mEnd; //!< End of subrange.
+			Index mGrain; //!< Grain size.
+		};
+		
+		/*! \brief Process subrange [\c inBegin, \c inEnd) of function parallelFor.
+		
+		Subranges larger than the grain are split recursively in two halves: the right half is pushed onto the thread pool, the left half is processed by the calling thread, which then helps the pool until the right half is completed (see ThreadPool::waitHelping). In work-stealing mode, idle slaves thus steal the largest remaining halves first.
+		*/
+		template <class Index, class Function>
+		void parallelForRange(ParallelContext& ioContext, Function& inFunction, Index inBegin, Index inEnd, Index inGrain)
+		{
+			if(inEnd - inBegin <= inGrain) {
+				if(ioContext.hasFailed()) return;
+				try {inFunction(inBegin, inEnd);}
+				catch(...) {ioContext.fail();}
+				return;
+			}
+			Index lMiddle = inBegin + (inEnd - inBegin) / 2;
+			ParallelForTask<Index, Function> lRight(ioContext, inFunction, lMiddle, inEnd, inGrain);
+			ioContext.mPool.push(lRight);
+			parallelForRange(ioContext, inFunction, inBegin, lMiddle, inGrain);
+			ioContext.mPool.waitHelping(lRight);
+		}
+		
+		/*! \brief Apply function \c inFunction to range [\c inBegin, \c inEnd) in parallel.
+		
+		The range of indices is split recursively into subranges of at most \c inGrain indices, and function \c inFunction is called once for every subrange, with the bounds of the subrange as arguments:
+		\code
+parallelFor(lPool, 0, lSize, 0, [&](int inBegin, int inEnd) {
+	for(int i = inBegin; i < inEnd; ++i) lOut[i] = 2*lIn[i];
+});
+		\endcode
+		If argument \c inGrain is 0, a grain yielding about 8 subranges per thread is used. The calling thread takes part in the computation. If the function throws an exception, the remaining subranges are skipped, and the exception is thrown again by this function.
+		*/
+		template <class Index, class Function>
+		void parallelFor(ThreadPool& inPool, Index inBegin, Index inEnd, Index inGrain, Function inFunction)
+		{
+			if(inEnd <= inBegin) return;
+			ParallelContext lContext(inPool);
+			Index lGrain = lContext.getGrain(inEnd - inBegin, inGrain);
+			parallelForRange(lContext, inFunction, inBegin, inEnd, lGrain);
+			lContext.rethrow();
+		}
+		
+		template <class Index, class T, class Function, class Combine>
+		T parallelReduceRange(ParallelContext& ioContext, const T& inIdentity, Function& inFunction, Combine& inCombine, Index inBegin, Index inEnd, Index inGrain);
+		
+		/*! \brief Task for the right half of a subrange of function parallelReduce.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		*/
+		template <class Index, class T, class Function, class Combine>
+		class ParallelReduceTask : public Task {
+			public:
+			//! Construct task for subrange [\c inBegin, \c inEnd).
+			ParallelReduceTask(ParallelContext& ioContext, const T& inIdentity, Function& inFunction, Combine& inCombine, Index inBegin, Index inEnd, Index inGrain)
+			: mContext(ioContext), mIdentity(inIdentity), mFunction(inFunction), mCombine(inCombine), mBegin(inBegin), mEnd(inEnd), mGrain(inGrain), mResult(inIdentity) {}
+			
+			//! Reduce subrange.
+			void main(void) {mResult = parallelReduceRange(mContext, mIdentity, mFunction, mCombine, mBegin, mEnd, mGrain);}
+			
+			//! Return result of reduction.
+			const T& getResult(void) const {return mResult;}
+			
+			protected:
+			ParallelContext& mContext; //!< Shared state.
+			const T& mIdentity; //!< Identity element.
+			Function& mFunction; //!< Reduction of a subrange.
+			Combine& mCombine; //!< Combination of two partial results.
+			Index mBegin; //!< Beginning of subrange.
+			Index mEnd; //!< End of subrange.
+			Index mGrain; //!< Grain size.
+			T mResult; //!< Result of reduction.
+		};
+		
+		//! Reduce subrange [\c inBegin, \c inEnd) of function parallelReduce (see function parallelForRange for the splitting strategy).
+		template <class Index, class T, class Function, class Combine>
+		T parallelReduceRange(ParallelContext& ioContext, const T& inIdentity, Function& inFunction, Combine& inCombine, Index inBegin, Index inEnd, Index inGrain)
+		{
+			if(inEnd - inBegin <= inGrain) {
+				if(ioContext.hasFailed()) return inIdentity;
+				try {return inFunction(inBegin, inEnd);}
+				catch(...) {ioContext.fail();}
+				return inIdentity;
+			}
+			Index lMiddle = inBegin + (inEnd - inBegin) / 2;
+			ParallelReduceTask<Index, T, Function, Combine> lRight(ioContext, inIdentity, inFunction, inCombine, lMiddle, inEnd, inGrain);
+			ioContext.mPool.push(lRight);
+			T lLeft = parallelReduceRange(ioContext, inIdentity, inFunction, inCombine, inBegin, lMiddle, inGrain);
+			ioContext.mPool.waitHelping(lRight);
+			if(ioContext.hasFailed()) return inIdentity;
+			try {return inCombine(lLeft, lRight.getResult());}
+			catch(...) {ioContext.fail();}
+			return inIdentity;
+		}
+		
+		/*! \brief Reduce range [\c inBegin, \c inEnd) in parallel.
+		\return Combination of the results of all subranges.
+		
+		The range is split as for function parallelFor. Function \c inFunction is called for every subrange with the bounds of the subrange as arguments, and returns the partial result of this subrange. Partial results are then combined pairwise using function \c inCombine, which must be associative. Value \c inIdentity is returned for an empty range. For instance, the sum of a vector can be computed as follows:
+		\code
+double lSum = parallelReduce(lPool, size_t(0), lData.size(), size_t(0), 0.,
+	[&](size_t inBegin, size_t inEnd) {return accumulate(lData.begin()+inBegin, lData.begin()+inEnd, 0.);},
+	plus<double>());
+		\endcode
+		Since the splitting of the range only depends on its size, the grain and the number of threads, the result is deterministic even for operations that are not exactly associative (e.g. floating point additions).
+		*/
+		template <class Index, class T, class Function, class Combine>
+		T parallelReduce(ThreadPool& inPool, Index inBegin, Index inEnd, Index inGrain, const T& inIdentity, Function inFunction, Combine inCombine)
+		{
+			if(inEnd <= inBegin) return inIdentity;
+			ParallelContext lContext(inPool);
+			Index lGrain = lContext.getGrain(inEnd - inBegin, inGrain);
+			T lResult = parallelReduceRange(lContext, inIdentity, inFunction, inCombine, inBegin, inEnd, lGrain);
+			lContext.rethrow();
+			return lResult;
+		}
+		
+		/*! \brief Compute inclusive prefix combination of range [\c inFirst, \c inLast) in parallel.
+		\return End of output range.
+		
+		Element \c i of the output range receives the combination of \c inIdentity with the input elements 0 to \c i, using associative function \c inCombine (e.g. plus<T>() for a prefix sum). The output range may be the input range itself. Both ranges must be random access.
+		
+		The range is divided into blocks of \c inGrain elements (automatic if 0). A first parallel pass reduces every block; the block totals are then scanned sequentially, and a second parallel pass scans every block, starting from the total of the preceding blocks. This requires about twice the operations of a sequential scan.
+		*/
+		template <class InputIterator, class OutputIterator, class T, class Combine>
+		OutputIterator parallelScan(ThreadPool& inPool, InputIterator inFirst, InputIterator inLast, OutputIterator outFirst, const T& inIdentity, Combine inCombine, size_t inGrain=0)
+		{
+			size_t lSize = inLast - inFirst;
+			if(lSize == 0) return outFirst;
+			ParallelContext lContext(inPool);
+			size_t lGrain = lContext.getGrain(lSize, inGrain, 1024);
+			size_t lBlocks = (lSize + lGrain - 1) / lGrain;
+			// reduce blocks (except the last one)
+			vector<T> lOffsets(lBlocks, inIdentity);
+			parallelFor(inPool, size_t(0), lBlocks-1, size_t(1), [&](size_t inBegin, size_t inEnd) {
+				for(size_t b = inBegin; b < inEnd; ++b) {
+					T lTotal = inIdentity;
+					for(size_t i = b*lGrain; i < (b+1)*lGrain; ++i) lTotal = inCombine(lTotal, inFirst[i]);
+					lOffsets[b+1] = lTotal;
+				}
+			});
+			// exclusive scan of block totals
+			for(size_t b = 1; b < lBlocks; ++b) lOffsets[b] = inCombine(lOffsets[b-1], lOffsets[b]);
+			// scan blocks
+			parallelFor(inPool, size_t(0), lBlocks, size_t(1), [&](size_t inBegin, size_t inEnd) {
+				for(size_t b = inBegin; b < inEnd; ++b) {
+					T lTotal = lOffsets[b];
+					size_t lEnd = min((b+1)*lGrain, lSize);
+					for(size_t i = b*lGrain; i < lEnd; ++i) outFirst[i] = lTotal = inCombine(lTotal, inFirst[i]);
+				}
+			});
+			return outFirst + lSize;
+		}
+		
+		template <class RandomIterator, class Compare>
+		void parallelSortRange(ParallelContext& ioContext, RandomIterator inFirst, RandomIterator inLast, Compare& inCompare, size_t inGrain, unsigned int inDepth);
+		
+		/*! \brief Task for a partition of function parallelSort.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		*/
+		template <class RandomIterator, class Compare>
+		class ParallelSortTask : public Task {
+			public:
+			//! Construct task for range [\c inFirst, \c inLast).
+			ParallelSortTask(ParallelContext& ioContext, RandomIterator inFirst, RandomIterator inLast, Compare& inCompare, size_t inGrain, unsigned int inDepth)
+			: mContext(ioContext), mFirst(inFirst), mLast(inLast), mCompare(inCompare), mGrain(inGrain), mDepth(inDepth) {}
+			
+			//! Sort range.
+			void main(void) {parallelSortRange(mContext, mFirst, mLast, mCompare, mGrain, mDepth);}
+			
+			protected:
+			ParallelContext& mContext; //!< Shared state.
+			RandomIterator mFirst; //!< Beginning of range.
+			RandomIterator mLast; //!< End of range.
+			Compare& mCompare; //!< Comparison function.
+			size_t mGrain; //!< Grain size.
+			unsigned int mDepth; //!< Remaining recursion depth.
+		};
+		
+		/*! \brief Sort range [\c inFirst, \c inLast) of function parallelSort.
+		
+		The range is partitioned in three parts (less than, equivalent to and greater than a median of three pivot); the first part is pushed onto the thread pool, and the last one is sorted by the calling thread, which then helps the pool until the first part is sorted. Ranges of at most \c inGrain elements, or that reach the maximum recursion depth (e.g. for adversarial inputs), are sorted using std::sort.
+		*/
+		template <class RandomIterator, class Compare>
+		void parallelSortRange(ParallelContext& ioContext, RandomIterator inFirst, RandomIterator inLast, Compare& inCompare, size_t inGrain, unsigned int inDepth)
+		{
+			if(ioContext.hasFailed()) return;
+			try {
+				if(size_t(inLast - inFirst) <= inGrain || inDepth == 0) {
+					std::sort(inFirst, inLast, inCompare);
+					return;
+				}
+				// median of three pivot
+				RandomIterator lMiddle = inFirst + (inLast - inFirst) / 2;
+				RandomIterator lPivot = lMiddle;
+				if(inCompare(*inFirst, *lMiddle)) {
+					if(inCompare(*lMiddle, *(inLast-1))) lPivot = lMiddle;
+					else lPivot = inCompare(*inFirst, *(inLast-1)) ? inLast-1 : inFirst;
+				}
+				else {
+					if(inCompare(*inFirst, *(inLast-1))) lPivot = inFirst;
+					else lPivot = inCompare(*lMiddle, *(inLast-1)) ? inLast-1 : lMiddle;
+				}
+				typename iterator_traits<RandomIterator>::value_type lValue = *lPivot;
+				RandomIterator lLess = std::partition(inFirst, inLast, [&](const typename iterator_traits<RandomIterator>::value_type& inX) {return inCompare(inX, lValue);});
+				RandomIterator lGreater = std::partition(lLess, inLast, [&](const typename iterator_traits<RandomIterator>::value_type& inX) {return !inCompare(lValue, inX);});
+				ParallelSortTask<RandomIterator, Compare> lLeft(ioContext, inFirst, lLess, inCompare, inGrain, inDepth-1);
+				ioContext.mPool.push(lLeft);
+				parallelSortRange(ioContext, lGreater, inLast, inCompare, inGrain, inDepth-1);
+				ioContext.mPool.waitHelping(lLeft);
+			}
+			catch(...) {ioContext.fail();}
+		}
+		
+		/*! \brief Sort range [\c inFirst, \c inLast) in parallel, using comparison function \c inCompare.
+		
+		This function implements a parallel quicksort: partitions larger than \c inGrain elements (automatic if 0) are sorted in parallel, and smaller ones using std::sort. The sort is not stable. Since each partitioning step is sequential, the speedup is bounded by the logarithm of the number of partitions; this function is best suited for large ranges with an expensive comparison function.
+		*/
+		template <class RandomIterator, class Compare>
+		void parallelSort(ThreadPool& inPool, RandomIterator inFirst, RandomIterator inLast, Compare inCompare, size_t inGrain=0)
+		{
+			size_t lSize = inLast - inFirst;
+			if(lSize < 2) return;
+			ParallelContext lContext(inPool);
+			unsigned int lDepth = 0;
+			for(size_t lCount = lSize; lCount > 1; lCount >>= 1) lDepth += 2;
+			parallelSortRange(lContext, inFirst, inLast, inCompare, lContext.getGrain(lSize, inGrain, 2048), lDepth);
+			lContext.rethrow();
+		}
+		
+		//! Sort range [\c inFirst, \c inLast) in parallel, using operator <.
+		template <class RandomIterator>
+		void parallelSort(ThreadPool& inPool, RandomIterator inFirst, RandomIterator inLast)
+		{
+			parallelSort(inPool, inFirst, inLast, less<typename iterator_traits<RandomIterator>::value_type>());
+		}
+		
+	} // end of Threading namespace
+	
+} // end of PACC namespace
+
+#endif // PACC_Threading_Parallel_hpp_
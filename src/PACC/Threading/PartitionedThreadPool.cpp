@@ -0,0 +1,88 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/PartitionedThreadPool.cpp
+ * \brief Class methods for the NUMA partitioned thread pool.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#include "PACC/Threading/PartitionedThreadPool.hpp"
+#include "PACC/Threading/Exception.hpp"
+#include "PACC/Threading/Topology.hpp"
+
+using namespace std;
+using namespace PACC;
+
+/*!
+One thread pool is allocated for every node of the machine topology, with its slave threads pinned to the processors of that node. Argument \c inSlavesPerNode sets the number of slave threads of every pool; value 0 allocates one slave thread per processor of the node. Argument \c inScheduling selects the scheduling mode of all pools (see class ThreadPool).
+*/
+Threading::PartitionedThreadPool::PartitionedThreadPool(unsigned int inSlavesPerNode, ThreadPool::Scheduling inScheduling)
+{
+	for(unsigned int i = 0; i < Topology::getNodeCount(); ++i) {
+		const vector<unsigned int>& lCPUs = Topology::getNodeCPUs(i);
+		unsigned int lSlaves = inSlavesPerNode > 0 ? inSlavesPerNode : (unsigned int) lCPUs.size();
+		// pinning is not possible without affinity support
+		mPartitions.push_back(new ThreadPool(lSlaves, inScheduling, Thread::isAffinitySupported() ? lCPUs : vector<unsigned int>()));
+	}
+}
+
+/*!
+The destructor of every pool waits for its slave threads to terminate.
+*/
+Threading::PartitionedThreadPool::~PartitionedThreadPool(void)
+{
+	for(unsigned int i = 0; i < mPartitions.size(); ++i) delete mPartitions[i];
+}
+
+/*!
+The function \c inAllocator is executed by a slave thread of partition \c inNode, and this method returns when it has completed. Memory that it writes to first (e.g. a container that it resizes) is thus allocated on node \c inNode. An exception thrown by \c inAllocator is rethrown by this method.
+*/
+void Threading::PartitionedThreadPool::firstTouch(unsigned int inNode, const function<void()>& inAllocator)
+{
+	getPartition(inNode).submit(inAllocator).get();
+}
+
+/*!
+Throws an exception if index \c inNode is invalid.
+*/
+const vector<unsigned int>& Threading::PartitionedThreadPool::getCPUs(unsigned int inNode) const
+{
+	if(inNode >= mPartitions.size()) throw Exception(eOtherError, "PartitionedThreadPool::getCPUs() invalid node index");
+	return Topology::getNodeCPUs(inNode);
+}
+
+/*!
+Throws an exception if index \c inNode is invalid.
+*/
+Threading::ThreadPool& Threading::PartitionedThreadPool::getPartition(unsigned int inNode)
+{
+	if(inNode >= mPartitions.size()) throw Exception(eOtherError, "PartitionedThreadPool::getPartition() invalid node index");
+	return *mPartitions[inNode];
+}
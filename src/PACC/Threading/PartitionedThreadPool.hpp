@@ -0,0 +1,88 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/PartitionedThreadPool.hpp
+ * \brief Class definition for the NUMA partitioned thread pool.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#ifndef PACC_Threading_PartitionedThreadPool_hpp_
+#define PACC_Threading_PartitionedThreadPool_hpp_
+
+#include "PACC/Threading/ThreadPool.hpp"
+#include <functional>
+#include <vector>
+
+namespace PACC { 
+	
+	using namespace std;
+	
+	namespace Threading {
+		
+		/*! \brief Set of thread pools, one per NUMA node.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		This class allocates one ThreadPool for every node of the machine topology (see class Topology), and pins the slave threads of each pool to the processors of its node. Tasks pushed onto a partition thus execute close to the memory of that node.
+		
+		Under most operating systems, a memory page is physically allocated on the node of the thread that first writes to it ("first touch" policy). Method PartitionedThreadPool::firstTouch runs an allocation function on a slave thread of a given node, so that the data it initializes resides on that node. For instance:
+		\code
+		Threading::PartitionedThreadPool lPools;
+		Matrix lMatrix;
+		lPools.firstTouch(lNode, [&]() {lMatrix.resize(1000, 1000);});
+		lPools.getPartition(lNode).push(lTask); // task that processes lMatrix
+		\endcode
+		*/
+		class PartitionedThreadPool {
+			public:
+			PartitionedThreadPool(unsigned int inSlavesPerNode=0, ThreadPool::Scheduling inScheduling=ThreadPool::eFIFO);
+			~PartitionedThreadPool(void);
+			
+			void firstTouch(unsigned int inNode, const function<void()>& inAllocator);
+			const vector<unsigned int>& getCPUs(unsigned int inNode) const;
+			ThreadPool& getPartition(unsigned int inNode);
+			//! Return number of partitions (NUMA nodes).
+			unsigned int size(void) const {return (unsigned int) mPartitions.size();}
+			
+			protected:
+			vector<ThreadPool*> mPartitions; //!< Thread pool of every node.
+			
+			private:
+			//! restrict (disable) copy constructor.
+			PartitionedThreadPool(const PartitionedThreadPool&);
+			//! restrict (disable) assignment operator.
+			void operator=(const PartitionedThreadPool&);
+		};
+		
+	} // end of Threading namespace
+	
+} // end of PACC namespace
+
+#endif // PACC_Threading_PartitionedThreadPool_hpp_
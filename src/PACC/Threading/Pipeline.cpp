@@ -0,0 +1,277 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/Pipeline.cpp
+ * \brief Class methods for the staged parallel pipeline.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#include "PACC/Threading/Pipeline.hpp"
+#include "PACC/Threading/Latch.hpp"
+
+using namespace std;
+using namespace PACC;
+
+/*! \brief Task that runs the source, or moves a token through the stages of a pipeline.
+\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+\ingroup Threading
+*/
+class Threading::Pipeline::PipelineTask : public Task {
+	public:
+	//! Construct task that moves token \c inToken from stage \c inStage of pipeline \c inPipeline (or runs the source if the token is null).
+	PipelineTask(Pipeline* inPipeline, Token* inToken, size_t inStage) : mPipeline(inPipeline), mToken(inToken), mStage(inStage) {}
+	
+	//! Run the source, or resume the token at its reserved stage.
+	void main(void) {
+		if(mToken) mPipeline->process(mToken, mStage, true);
+		else mPipeline->produce();
+	}
+	
+	protected:
+	Pipeline* mPipeline; //!< Parent pipeline.
+	Token* mToken; //!< Token to move (null for the source).
+	size_t mStage; //!< Stage reserved for the token.
+};
+
+/*! \brief Construct empty pipeline that runs on thread pool \c inPool, with at most \c inTokens items in flight.
+
+A null number of tokens raises a Threading::Exception.
+*/
+Threading::Pipeline::Pipeline(ThreadPool& inPool, unsigned int inTokens) : mPool(inPool), mSourceStage(eSerialInOrder, std::function<void(Token&)>()), mTokens(inTokens), mNextSequence(0), mInFlight(0), mSourceDone(true), mSourceStalled(false), mCancelled(false), mDone(0)
+{
+	if(inTokens == 0) throw Exception(eOtherError, "Pipeline::Pipeline() invalid number of tokens");
+}
+
+//! Delete pipeline and its stages (the pipeline must not be running).
+Threading::Pipeline::~Pipeline(void)
+{
+	for(size_t i = 0; i < mStages.size(); ++i) delete mStages[i];
+}
+
+//! Append stage of mode \c inMode with type-erased function \c inFunction.
+void Threading::Pipeline::addStage(Mode inMode, const std::function<void(Token&)>& inFunction)
+{
+	mStages.push_back(new Stage(inMode, inFunction));
+}
+
+/*! \brief Call the function of stage \c ioStage on token \c ioToken, and update the stage counters.
+\return False if the pipeline is cancelled (the function is not called), true otherwise.
+
+An exception thrown by the function cancels the pipeline (see Pipeline::fail); the item is then not counted as processed, although its processing time is.
+*/
+bool Threading::Pipeline::execute(Stage& ioStage, Token& ioToken)
+{
+	if(mCancelled.load(memory_order_relaxed)) return false;
+	unsigned long long lStart = mTimer.getCount();
+	bool lProcessed = true;
+	try {
+		ioStage.mFunction(ioToken);
+	}
+	catch(...) {
+		fail();
+		lProcessed = false;
+	}
+	ioStage.mBusyCount.fetch_add(mTimer.getCount()-lStart, memory_order_relaxed);
+	if(lProcessed) ioStage.mItems.fetch_add(1, memory_order_relaxed);
+	return true;
+}
+
+//! Record the current exception (if it is the first one), and cancel the pipeline.
+void Threading::Pipeline::fail(void)
+{
+	mMutex.lock();
+	if(!mException) mException = current_exception();
+	mCancelled = true;
+	mMutex.unlock();
+}
+
+/*! \brief Release token \c inToken after the last stage.
+
+The source is restarted if it was stalled for lack of tokens. The run ends when the source has stopped and the last token is released.
+*/
+void Threading::Pipeline::finish(Token* inToken)
+{
+	inToken->destroy();
+	mMutex.lock();
+	mFree.push_back(inToken);
+	--mInFlight;
+	bool lRestart = mSourceStalled && !mSourceDone;
+	if(lRestart) mSourceStalled = false;
+	// the latch is opened under the lock, so that it outlives the call (see Pipeline::run)
+	if(mSourceDone && mInFlight == 0) mDone->countDown();
+	mMutex.unlock();
+	if(lRestart) spawn(0, 0);
+}
+
+//! Return statistics of source (for \c inStage = 0) or stage \c inStage (starting at 1) for the last run.
+const Threading::Pipeline::Statistics& Threading::Pipeline::getStatistics(size_t inStage) const
+{
+	if(inStage > mStages.size()) throw Exception(eOtherError, "Pipeline::getStatistics() invalid stage");
+	return inStage == 0 ? mSourceStage.mStatistics : mStages[inStage-1]->mStatistics;
+}
+
+/*! \brief Move token \c inToken through the stages, starting at stage \c inStage.
+
+A parallel stage is run immediately. A serial stage is run if it is free and, for an in-order stage, if the token holds the next item; otherwise, the token is parked in the stage, and this method returns. When a serial stage completes an item, it reserves itself for the next parked item that it can accept, if any, and spawns a task to resume it (see Pipeline::spawn), while the calling thread continues with its own token. If argument \c inReserved is true, stage \c inStage is already reserved for this token.
+*/
+void Threading::Pipeline::process(Token* inToken, size_t inStage, bool inReserved)
+{
+	for(size_t i = inStage; i < mStages.size(); ++i) {
+		Stage& lStage = *mStages[i];
+		if(lStage.mMode == eParallel) {
+			execute(lStage, *inToken);
+			continue;
+		}
+		if(!inReserved || i != inStage) {
+			lStage.mMutex.lock();
+			if(lStage.mBusy || (lStage.mMode == eSerialInOrder && inToken->mSequence != lStage.mNext)) {
+				// park token until the stage can accept it
+				lStage.mPending[inToken->mSequence] = inToken;
+				if(lStage.mPending.size() > lStage.mMaxPending) lStage.mMaxPending = lStage.mPending.size();
+				lStage.mMutex.unlock();
+				return;
+			}
+			lStage.mBusy = true;
+			lStage.mMutex.unlock();
+		}
+		execute(lStage, *inToken);
+		// release stage, and reserve it for the next parked token, if any
+		Token* lNext = 0;
+		lStage.mMutex.lock();
+		lStage.mBusy = false;
+		if(lStage.mMode == eSerialInOrder) ++lStage.mNext;
+		map<unsigned long, Token*>::iterator lIter = (lStage.mMode == eSerialInOrder ? lStage.mPending.find(lStage.mNext) : lStage.mPending.begin());
+		if(lIter != lStage.mPending.end()) {
+			lNext = lIter->second;
+			lStage.mPending.erase(lIter);
+			lStage.mBusy = true;
+		}
+		lStage.mMutex.unlock();
+		if(lNext) spawn(lNext, i);
+	}
+	finish(inToken);
+}
+
+/*! \brief Run the source once (serially), and move the new item through the stages.
+
+A task for the next call of the source is spawned before the item is processed, if a token is free; otherwise, the source stalls until a token is released (see Pipeline::finish).
+*/
+void Threading::Pipeline::produce(void)
+{
+	mMutex.lock();
+	Token* lToken = mFree.back();
+	mFree.pop_back();
+	++mInFlight;
+	mMutex.unlock();
+	Control lControl;
+	if(mCancelled.load(memory_order_relaxed)) lControl.stop();
+	else {
+		unsigned long long lStart = mTimer.getCount();
+		try {
+			mSource(*lToken, lControl);
+		}
+		catch(...) {
+			fail();
+			lControl.stop();
+		}
+		mSourceStage.mBusyCount.fetch_add(mTimer.getCount()-lStart, memory_order_relaxed);
+	}
+	if(lControl.isStopped()) {
+		lToken->destroy();
+		mMutex.lock();
+		mFree.push_back(lToken);
+		--mInFlight;
+		mSourceDone = true;
+		if(mInFlight == 0) mDone->countDown();
+		mMutex.unlock();
+		return;
+	}
+	mSourceStage.mItems.fetch_add(1, memory_order_relaxed);
+	lToken->mSequence = mNextSequence++;
+	mMutex.lock();
+	bool lContinue = !mFree.empty();
+	if(!lContinue) mSourceStalled = true;
+	mMutex.unlock();
+	if(lContinue) spawn(0, 0);
+	process(lToken, 0, false);
+}
+
+/*! \brief Run the pipeline until the source stops and all items have gone through the sink.
+
+The calling thread waits for the end of the run (see Latch::wait); if it is a slave of the thread pool, it executes pending tasks in the meantime. The first exception thrown by the source or by a stage is thrown again. Running a pipeline without source or stage raises a Threading::Exception.
+*/
+void Threading::Pipeline::run(void)
+{
+	if(!mSource || mStages.empty()) throw Exception(eOtherError, "Pipeline::run() pipeline needs a source and at least one stage");
+	// reset state
+	mFree.clear();
+	for(size_t i = 0; i < mTokens.size(); ++i) mFree.push_back(&mTokens[i]);
+	mNextSequence = 0;
+	mInFlight = 0;
+	mSourceDone = false;
+	mSourceStalled = false;
+	mCancelled = false;
+	mException = exception_ptr();
+	mSourceStage.reset();
+	for(size_t i = 0; i < mStages.size(); ++i) mStages[i]->reset();
+	Latch lDone(1);
+	mDone = &lDone;
+	Timer lTimer;
+	spawn(0, 0);
+	lDone.wait();
+	double lElapsed = lTimer.getValue();
+	// wait for the thread that opened the latch to release the lock, before the latch goes out of scope
+	mMutex.lock();
+	mDone = 0;
+	mMutex.unlock();
+	// compute statistics
+	for(size_t i = 0; i <= mStages.size(); ++i) {
+		Stage& lStage = (i == 0 ? mSourceStage : *mStages[i-1]);
+		Statistics& lStatistics = lStage.mStatistics;
+		lStatistics.mItems = lStage.mItems.load();
+		lStatistics.mBusyTime = lStage.mBusyCount.load() * mTimer.getCountPeriod();
+		lStatistics.mThroughput = lElapsed > 0 ? lStatistics.mItems / lElapsed : 0;
+		lStatistics.mOccupancy = lElapsed > 0 ? lStatistics.mBusyTime / lElapsed : 0;
+		lStatistics.mMaxPending = lStage.mMaxPending;
+	}
+	if(mException) rethrow_exception(mException);
+}
+
+//! Set source of the pipeline to type-erased function \c inFunction.
+void Threading::Pipeline::setSource(const std::function<void(Token&, Control&)>& inFunction)
+{
+	mSource = inFunction;
+}
+
+//! Spawn a task that resumes token \c inToken at its reserved stage \c inStage, or that runs the source if the token is null.
+void Threading::Pipeline::spawn(Token* inToken, size_t inStage)
+{
+	mPool.pushDetached(new PipelineTask(this, inToken, inStage));
+}
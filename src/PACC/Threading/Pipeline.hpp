@@ -0,0 +1,256 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/Pipeline.hpp
+ * \brief Class definition for the staged parallel pipeline.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#ifndef PACC_Threading_Pipeline_hpp_
+#define PACC_Threading_Pipeline_hpp_
+
+#include "PACC/Threading/Mutex.hpp"
+#include "PACC/Threading/ThreadPool.hpp"
+#include "PACC/Util/Timer.hpp"
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <map>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace PACC { 
+	
+	using namespace std;
+	
+	namespace Threading {
+		
+		class Latch;
+		
+		/*! \brief Staged pipeline running on a thread pool.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		A pipeline chains a source (see Pipeline::addSource), any number of intermediate stages (see Pipeline::addStage), and a sink (see Pipeline::addSink). The source produces items one at a time until it calls Pipeline::Control::stop; each item then flows through every stage, in order. Every stage has a Pipeline::Mode:
+		- eSerialInOrder: one item at a time, in the order in which the source produced them;
+		- eSerialOutOfOrder: one item at a time, in any order;
+		- eParallel: any number of items at the same time.
+		
+		The source is always serial. All stages run as tasks of a shared thread pool, and no thread is dedicated to any stage. The number of items in flight is bounded by the number of tokens (see constructor): the source stalls when all tokens are in use, and resumes when the sink releases one. This bounds the memory used by the pipeline, and plays the role of the bounded buffers between stages. Here is a typical usage:
+		\code
+Threading::Pipeline lPipeline(lPool, 32);
+lPipeline.addSource<string>([&](Threading::Pipeline::Control& ioControl) {
+	string lMessage;
+	if(!lSocket.receiveMessage(lMessage)) ioControl.stop();
+	return lMessage;
+});
+lPipeline.addStage<string, Matrix>(Threading::Pipeline::eParallel, [](string inMessage) {return parseAndCompute(inMessage);});
+lPipeline.addSink<Matrix>(Threading::Pipeline::eSerialInOrder, [&](Matrix inResult) {lSocket.sendMessage(serialize(inResult));});
+lPipeline.run();
+		\endcode
+		The input type of each stage must be the output type of the previous one. Items of at most 64 bytes are stored within the tokens; larger items are allocated on the heap.
+		
+		If the source or a stage throws an exception, the source is stopped, the items in flight are drained without calling the remaining stages, and the first exception is thrown again by Pipeline::run. The statistics of each stage (see Pipeline::getStatistics) are reset by every run.
+		*/
+		class Pipeline {
+			public:
+			//! Execution modes of stages.
+			enum Mode {
+				eSerialInOrder, //!< One item at a time, in source order.
+				eSerialOutOfOrder, //!< One item at a time, in any order.
+				eParallel //!< Any number of items at a time.
+			};
+			
+			/*! \brief Flow control of a pipeline source.
+			\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+			\ingroup Threading
+			*/
+			class Control {
+				public:
+				//! Construct running control.
+				Control(void) : mStopped(false) {}
+				//! Return whether the source has stopped.
+				bool isStopped(void) const {return mStopped;}
+				//! Stop the source; the item that it returns is discarded.
+				void stop(void) {mStopped = true;}
+				
+				protected:
+				bool mStopped; //!< Source has stopped flag.
+			};
+			
+			/*! \brief Statistics of a pipeline stage for the last run.
+			\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+			\ingroup Threading
+			*/
+			struct Statistics {
+				unsigned long mItems; //!< Number of processed items (excluding the items on which the stage failed).
+				double mBusyTime; //!< Total processing time (in seconds, summed over all threads).
+				double mThroughput; //!< Processed items per second of run time.
+				double mOccupancy; //!< Average number of items being processed (busy time over run time).
+				size_t mMaxPending; //!< Maximum number of items waiting for a serial stage.
+			};
+			
+			Pipeline(ThreadPool& inPool, unsigned int inTokens);
+			~Pipeline(void);
+			
+			/*! \brief Set source of the pipeline to function \c inFunction, which returns items of type \c Out.
+			
+			The function is called with a Pipeline::Control argument, and returns a new item on each call, until it stops the control. Calls are serial.
+			*/
+			template <class Out, class Function>
+			void addSource(Function inFunction) {
+				setSource([inFunction](Token& ioToken, Control& ioControl) mutable {
+					Out lOut = inFunction(ioControl);
+					if(!ioControl.isStopped()) ioToken.store(std::move(lOut));
+				});
+			}
+			
+			//! Append stage of mode \c inMode that transforms items of type \c In into items of type \c Out, using function \c inFunction.
+			template <class In, class Out, class Function>
+			void addStage(Mode inMode, Function inFunction) {
+				addStage(inMode, std::function<void(Token&)>([inFunction](Token& ioToken) mutable {
+					Out lOut = inFunction(std::move(*static_cast<In*>(ioToken.mItem)));
+					ioToken.destroy();
+					ioToken.store(std::move(lOut));
+				}));
+			}
+			
+			//! Append sink of mode \c inMode that consumes items of type \c In, using function \c inFunction.
+			template <class In, class Function>
+			void addSink(Mode inMode, Function inFunction) {
+				addStage(inMode, std::function<void(Token&)>([inFunction](Token& ioToken) mutable {
+					inFunction(std::move(*static_cast<In*>(ioToken.mItem)));
+					ioToken.destroy();
+				}));
+			}
+			
+			//! Return number of stages (excluding the source).
+			size_t getStageCount(void) const {return mStages.size();}
+			//! Return statistics of source (for \c inStage = 0) or stage \c inStage (starting at 1) for the last run.
+			const Statistics& getStatistics(size_t inStage) const;
+			//! Return number of tokens (maximum number of items in flight).
+			unsigned int getTokens(void) const {return (unsigned int) mTokens.size();}
+			
+			void run(void);
+			
+			protected:
+			/*! \brief Token of a pipeline, which carries one item through the stages.
+			\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+			\ingroup Threading
+			*/
+			struct Token {
+				unsigned long mSequence; //!< Sequence number of item (source order).
+				void* mItem; //!< Current item (null if none).
+				void (*mDestroy)(Token&); //!< Destructor of current item.
+				typename aligned_storage<64>::type mBuffer; //!< Storage of small items.
+				
+				//! Construct empty token.
+				Token(void) : mSequence(0), mItem(0), mDestroy(0) {}
+				//! Destroy item, if any.
+				void destroy(void) {
+					if(mItem) mDestroy(*this);
+					mItem = 0;
+				}
+				//! Store item \c inValue into token (the token must be empty).
+				template <class T>
+				void store(T&& inValue) {
+					typedef typename decay<T>::type Value;
+					if(sizeof(Value) <= sizeof(mBuffer) && alignof(Value) <= alignof(typename aligned_storage<64>::type)) {
+						mItem = new(&mBuffer) Value(std::forward<T>(inValue));
+						mDestroy = [](Token& ioToken) {static_cast<Value*>(ioToken.mItem)->~Value();};
+					} else {
+						mItem = new Value(std::forward<T>(inValue));
+						mDestroy = [](Token& ioToken) {delete static_cast<Value*>(ioToken.mItem);};
+					}
+				}
+			};
+			
+			/*! \brief Stage of a pipeline.
+			\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+			\ingroup Threading
+			*/
+			struct Stage {
+				Mode mMode; //!< Execution mode.
+				std::function<void(Token&)> mFunction; //!< Processing function.
+				Mutex mMutex; //!< Mutex of serial state.
+				bool mBusy; //!< An item is being processed, or reserved (serial stages).
+				unsigned long mNext; //!< Sequence number of next item (in-order stages).
+				map<unsigned long, Token*> mPending; //!< Items waiting for the stage, by sequence number (serial stages).
+				size_t mMaxPending; //!< Maximum number of waiting items.
+				atomic<unsigned long> mItems; //!< Number of successfully processed items.
+				atomic<unsigned long long> mBusyCount; //!< Total processing time (in timer counts).
+				Statistics mStatistics; //!< Statistics of last run.
+				
+				//! Construct stage of mode \c inMode with function \c inFunction.
+				Stage(Mode inMode, const std::function<void(Token&)>& inFunction) : mMode(inMode), mFunction(inFunction) {reset();}
+				//! Reset state and counters.
+				void reset(void) {mBusy = false; mNext = 0; mPending.clear(); mMaxPending = 0; mItems = 0; mBusyCount = 0;}
+			};
+			
+			class PipelineTask;
+			
+			ThreadPool& mPool; //!< Thread pool on which stages run.
+			std::function<void(Token&, Control&)> mSource; //!< Source function.
+			Stage mSourceStage; //!< Counters of the source.
+			vector<Stage*> mStages; //!< Stages after the source.
+			vector<Token> mTokens; //!< Tokens.
+			vector<Token*> mFree; //!< Free tokens (protected by the mutex).
+			Mutex mMutex; //!< Mutex of the token state.
+			unsigned long mNextSequence; //!< Sequence number of next item (source only).
+			unsigned int mInFlight; //!< Number of tokens in use (protected by the mutex).
+			bool mSourceDone; //!< Source has stopped flag (protected by the mutex).
+			bool mSourceStalled; //!< Source waits for a free token flag (protected by the mutex).
+			atomic<bool> mCancelled; //!< An exception was thrown flag.
+			exception_ptr mException; //!< First exception thrown (protected by the mutex).
+			Latch* mDone; //!< Latch opened at the end of the run.
+			Timer mTimer; //!< Timer of stage processing.
+			
+			void addStage(Mode inMode, const std::function<void(Token&)>& inFunction);
+			bool execute(Stage& ioStage, Token& ioToken);
+			void fail(void);
+			void finish(Token* inToken);
+			void process(Token* inToken, size_t inStage, bool inReserved);
+			void produce(void);
+			void setSource(const std::function<void(Token&, Control&)>& inFunction);
+			void spawn(Token* inToken, size_t inStage);
+			
+			private:
+			//! restrict (disable) copy constructor.
+			Pipeline(const Pipeline&);
+			//! restrict (disable) assignment operator.
+			void operator=(const Pipeline&);
+		};
+		
+	} // end of Threading namespace
+	
+} // end of PACC namespace
+
+#endif // PACC_Threading_Pipeline_hpp_
@@ -0,0 +1,171 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/RWLock.cpp
+ * \brief Class methods for the reader-writer lock.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#include "PACC/Threading/RWLock.hpp"
+#include "PACC/Threading/Thread.hpp"
+#include "PACC/Threading/Topology.hpp"
+
+using namespace std;
+using namespace PACC;
+
+/*!
+An adaptive lock spins for at most 100 iterations before parking, or never spins on single processor systems.
+*/
+Threading::RWLock::RWLock(Mutex::Mode inMode) : mState(0), mCondition(inMode), mWaitingWriters(0), mMaxSpin(0)
+{
+	if(inMode == Mutex::eAdaptive && Topology::getCPUCount() > 1) mMaxSpin = 100;
+}
+
+/*! \brief Lock in exclusive mode.
+
+The calling thread blocks until no other thread holds the lock, in either mode. A thread should never lock twice consecutively (without calling method RWLock::unlock).
+*/
+void Threading::RWLock::lock(void)
+{
+	unsigned int lState = mState.load(memory_order_relaxed);
+	if((lState & ~(unsigned int) eReaderWaiting) == 0 && mState.compare_exchange_weak(lState, lState | eWriter, memory_order_acquire)) return;
+	lockSlow();
+}
+
+/*! \brief Lock in shared mode.
+
+The calling thread blocks while a writer holds the lock, or waits for it (writer preference). A thread should never lock twice consecutively (without calling method RWLock::unlockShared), since a writer may be waiting in between.
+*/
+void Threading::RWLock::lockShared(void)
+{
+	unsigned int lState = mState.load(memory_order_relaxed);
+	if((lState & (eWriter | eWriterWaiting)) == 0 && mState.compare_exchange_weak(lState, lState + eReader, memory_order_acquire)) return;
+	lockSharedSlow();
+}
+
+//! Spin (if adaptive) and park until the lock is acquired in exclusive mode.
+void Threading::RWLock::lockSlow(void)
+{
+	for(unsigned int i = 0; i < mMaxSpin; ++i) {
+		Thread::pause();
+		unsigned int lState = mState.load(memory_order_relaxed);
+		if((lState & eWriter) == 0 && lState < eReader && mState.compare_exchange_weak(lState, lState | eWriter, memory_order_acquire)) return;
+	}
+	mCondition.lock();
+	++mWaitingWriters;
+	for(;;) {
+		// the flag must be set before the last check, so that the unlocking thread wakes us up
+		unsigned int lState = mState.fetch_or(eWriterWaiting) | eWriterWaiting;
+		if((lState & eWriter) == 0 && lState < eReader) {
+			if(mState.compare_exchange_strong(lState, lState | eWriter, memory_order_acquire)) break;
+			continue;
+		}
+		mCondition.wait();
+	}
+	if(--mWaitingWriters == 0) mState.fetch_and(~(unsigned int) eWriterWaiting);
+	mCondition.unlock();
+}
+
+//! Spin (if adaptive) and park until the lock is acquired in shared mode.
+void Threading::RWLock::lockSharedSlow(void)
+{
+	for(unsigned int i = 0; i < mMaxSpin; ++i) {
+		Thread::pause();
+		unsigned int lState = mState.load(memory_order_relaxed);
+		if((lState & (eWriter | eWriterWaiting)) == 0 && mState.compare_exchange_weak(lState, lState + eReader, memory_order_acquire)) return;
+	}
+	mCondition.lock();
+	for(;;) {
+		// the flag must be set before the last check, so that the unlocking thread wakes us up
+		unsigned int lState = mState.fetch_or(eReaderWaiting) | eReaderWaiting;
+		if((lState & (eWriter | eWriterWaiting)) == 0) {
+			if(mState.compare_exchange_strong(lState, lState + eReader, memory_order_acquire)) break;
+			continue;
+		}
+		mCondition.wait();
+	}
+	mCondition.unlock();
+}
+
+/*! \brief Try to lock in exclusive mode without blocking.
+
+Return true if successful; false otherwise.
+*/
+bool Threading::RWLock::tryLock(void)
+{
+	unsigned int lState = mState.load(memory_order_relaxed);
+	while((lState & eWriter) == 0 && lState < eReader) {
+		if(mState.compare_exchange_weak(lState, lState | eWriter, memory_order_acquire)) return true;
+	}
+	return false;
+}
+
+/*! \brief Try to lock in shared mode without blocking.
+
+Return true if successful; false otherwise (a writer holds the lock, or waits for it).
+*/
+bool Threading::RWLock::tryLockShared(void)
+{
+	unsigned int lState = mState.load(memory_order_relaxed);
+	while((lState & (eWriter | eWriterWaiting)) == 0) {
+		if(mState.compare_exchange_weak(lState, lState + eReader, memory_order_acquire)) return true;
+	}
+	return false;
+}
+
+/*! \brief Unlock from exclusive mode.
+
+Parked threads are woken up, if any. A thread should only unlock a lock that it holds in exclusive mode.
+*/
+void Threading::RWLock::unlock(void)
+{
+	unsigned int lState = mState.fetch_and(~(unsigned int) eWriter, memory_order_release);
+	if(lState & (eWriterWaiting | eReaderWaiting)) wake();
+}
+
+/*! \brief Unlock from shared mode.
+
+The last reader wakes up the parked writers, if any. A thread should only unlock a lock that it holds in shared mode.
+*/
+void Threading::RWLock::unlockShared(void)
+{
+	unsigned int lState = mState.fetch_sub(eReader, memory_order_release) - eReader;
+	if(lState < eReader && (lState & eWriterWaiting)) wake();
+}
+
+//! Wake up all parked threads.
+void Threading::RWLock::wake(void)
+{
+	mCondition.lock();
+	// parked readers set the flag again if they must keep waiting
+	mState.fetch_and(~(unsigned int) eReaderWaiting);
+	mCondition.broadcast();
+	mCondition.unlock();
+}
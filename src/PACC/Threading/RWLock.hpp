@@ -0,0 +1,98 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/RWLock.hpp
+ * \brief Class definition for the reader-writer lock.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#ifndef PACC_Threading_RWLock_hpp_
+#define PACC_Threading_RWLock_hpp_
+
+#include "PACC/Threading/Condition.hpp"
+#include <atomic>
+
+namespace PACC { 
+	
+	namespace Threading {
+		
+		/*! \brief Reader-writer (shared-exclusive) lock with writer preference.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		This class allows any number of threads to hold the lock in shared mode (see RWLock::lockShared), or a single thread to hold it in exclusive mode (see RWLock::lock). It should be used to protect data that is read often and seldom modified: readers do not serialize each other, except for a single atomic operation on lock and unlock.
+		
+		Writers have preference: once a writer waits for the lock, new readers block until it has acquired and released it. Writers can therefore not starve, but a continuous flow of writers can starve readers. The lock is not recursive, and cannot be upgraded from shared to exclusive mode.
+		
+		Uncontended operations never block nor make system calls. Contended threads park on an embedded Condition. An adaptive lock (see Mutex::Mode) first spins for a bounded number of iterations, which avoids parking when the lock is held for short periods.
+		
+		This class does not contain any OS dependant code. However, it is built over class Condition which may not be fully cross-platform (see documentation of this class for more details).
+		*/
+		class RWLock {
+			public:
+			RWLock(Mutex::Mode inMode=Mutex::eBlocking);
+			
+			void lock(void);
+			void lockShared(void);
+			bool tryLock(void);
+			bool tryLockShared(void);
+			void unlock(void);
+			void unlockShared(void);
+			
+			protected:
+			//! Bits of the lock state.
+			enum State {
+				eWriter = 1, //!< A writer holds the lock.
+				eWriterWaiting = 2, //!< At least one writer is parked.
+				eReaderWaiting = 4, //!< At least one reader may be parked.
+				eReader = 8 //!< Unit of the reader count (upper bits).
+			};
+			
+			std::atomic<unsigned int> mState; //!< Lock state (reader count and flags).
+			Condition mCondition; //!< Condition on which contended threads are parked.
+			unsigned int mWaitingWriters; //!< Number of parked writers (protected by the condition).
+			unsigned int mMaxSpin; //!< Maximum number of spin iterations before parking (0 if blocking).
+			
+			void lockSlow(void);
+			void lockSharedSlow(void);
+			void wake(void);
+			
+			private:
+			//! restrict (disable) copy constructor.
+			RWLock(const RWLock&);
+			//! restrict (disable) assignment operator.
+			void operator=(const RWLock&);
+		};
+		
+	} // end of Threading namespace
+	
+} // end of PACC namespace
+
+#endif // PACC_Threading_RWLock_hpp_
@@ -0,0 +1,148 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/SPSCQueue.hpp
+ * \brief Class definition for the bounded lock-free single-producer single-consumer queue.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#ifndef PACC_Threading_SPSCQueue_hpp_
+#define PACC_Threading_SPSCQueue_hpp_
+
+#include <atomic>
+#include <cstddef>
+
+namespace PACC { 
+	
+	using namespace std;
+	
+	namespace Threading {
+		
+		/*! \brief Bounded lock-free single-producer single-consumer FIFO queue.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		This class implements a circular array shared by exactly one producer thread, which calls SPSCQueue::push, and one consumer thread, which calls SPSCQueue::pop. Neither operation uses any read-modify-write instruction: each side owns one index, publishes it with a release store, and keeps a private copy of the other side's index, which it reloads only when the queue looks full (or empty). An uncontended push or pop therefore touches a single shared cache line. Method SPSCQueue::push returns false when the queue is full, and SPSCQueue::pop returns false when it is empty.
+		
+		The interface mirrors class MPMCQueue, so that both can be used interchangeably (e.g. see class Channel). Elements are copied in and out of the array, so that type \c T should be cheap to copy (e.g. a pointer).
+		*/
+		template <class T>
+		class SPSCQueue {
+			public:
+			//! Construct empty queue of capacity \c inCapacity (rounded up to a power of two).
+			SPSCQueue(size_t inCapacity=1024) : mHead(0), mTailCache(0), mTail(0), mHeadCache(0) {
+				size_t lCapacity = 2;
+				while(lCapacity < inCapacity) lCapacity *= 2;
+				mMask = lCapacity-1;
+				mValues = new T[lCapacity];
+			}
+			//! Delete queue.
+			~SPSCQueue(void) {delete[] mValues;}
+			
+			//! Return whether the queue is (momentarily) empty.
+			bool empty(void) const {return mHead.load(memory_order_relaxed) >= mTail.load(memory_order_relaxed);}
+			//! Return the capacity of the queue.
+			size_t getCapacity(void) const {return mMask+1;}
+			//! Return the (momentary) number of elements in the queue.
+			size_t size(void) const {
+				size_t lHead = mHead.load(memory_order_relaxed), lTail = mTail.load(memory_order_relaxed);
+				return lTail > lHead ? lTail-lHead : 0;
+			}
+			
+			//! Remove element at the head of the queue into \c outValue; return false if the queue is empty (consumer only).
+			bool pop(T& outValue) {
+				size_t lHead = mHead.load(memory_order_relaxed);
+				if(lHead == mTailCache) {
+					mTailCache = mTail.load(memory_order_acquire);
+					if(lHead == mTailCache) return false;
+				}
+				outValue = mValues[lHead & mMask];
+				mHead.store(lHead+1, memory_order_release);
+				return true;
+			}
+			
+			//! Remove up to \c inMaxCount elements at the head of the queue into array \c outValues; return the number of removed elements (consumer only).
+			size_t pop(T* outValues, size_t inMaxCount) {
+				size_t lHead = mHead.load(memory_order_relaxed);
+				if(mTailCache - lHead < inMaxCount) mTailCache = mTail.load(memory_order_acquire);
+				size_t lCount = mTailCache - lHead;
+				if(lCount > inMaxCount) lCount = inMaxCount;
+				for(size_t i = 0; i < lCount; ++i) outValues[i] = mValues[(lHead+i) & mMask];
+				if(lCount > 0) mHead.store(lHead+lCount, memory_order_release);
+				return lCount;
+			}
+			
+			//! Append element \c inValue at the tail of the queue; return false if the queue is full (producer only).
+			bool push(const T& inValue) {
+				size_t lTail = mTail.load(memory_order_relaxed);
+				if(lTail - mHeadCache > mMask) {
+					mHeadCache = mHead.load(memory_order_acquire);
+					if(lTail - mHeadCache > mMask) return false;
+				}
+				mValues[lTail & mMask] = inValue;
+				mTail.store(lTail+1, memory_order_release);
+				return true;
+			}
+			
+			//! Append the \c inCount elements of array \c inValues at the tail of the queue; return false if the queue does not have room for all of them (producer only).
+			bool push(const T* inValues, size_t inCount) {
+				size_t lTail = mTail.load(memory_order_relaxed);
+				if(lTail + inCount - mHeadCache > mMask+1) {
+					mHeadCache = mHead.load(memory_order_acquire);
+					if(lTail + inCount - mHeadCache > mMask+1) return false;
+				}
+				for(size_t i = 0; i < inCount; ++i) mValues[(lTail+i) & mMask] = inValues[i];
+				mTail.store(lTail+inCount, memory_order_release);
+				return true;
+			}
+			
+			protected:
+			T* mValues; //!< Circular array of elements.
+			size_t mMask; //!< Capacity minus one.
+			char mPad1[64]; //!< Keep consumer indices on their own cache line.
+			atomic<size_t> mHead; //!< Position of next element to pop (written by consumer).
+			size_t mTailCache; //!< Last tail seen by consumer.
+			char mPad2[64]; //!< Keep producer indices on their own cache line.
+			atomic<size_t> mTail; //!< Position of next element to push (written by producer).
+			size_t mHeadCache; //!< Last head seen by producer.
+			char mPad3[64]; //!< Keep producer indices on their own cache line.
+			
+			private:
+			//! restrict (disable) copy constructor.
+			SPSCQueue(const SPSCQueue&);
+			//! restrict (disable) assignment operator.
+			void operator=(const SPSCQueue&);
+		};
+		
+	} // end of Threading namespace
+	
+} // end of PACC namespace
+
+#endif // PACC_Threading_SPSCQueue_hpp_
@@ -0,0 +1,272 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/ScheduledExecutor.cpp
+ * \brief Class methods for the delayed and periodic task scheduler.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#include "PACC/Threading/ScheduledExecutor.hpp"
+#include "PACC/Threading/Exception.hpp"
+
+using namespace std;
+using namespace PACC;
+
+/*! \brief Construct scheduler of tasks for thread pool \c inPool, with ticks of \c inResolution seconds.
+
+The scheduler thread is started immediately. Throws a Threading::Exception if the resolution is not positive.
+*/
+Threading::ScheduledExecutor::ScheduledExecutor(ThreadPool& inPool, double inResolution) : mPool(inPool), mResolution(inResolution), mCurrent(0), mWakeup(0), mNextHandle(1), mShutdown(false), mTicker(0)
+{
+	if(inResolution <= 0) throw Exception(eOtherError, "ScheduledExecutor::ScheduledExecutor() resolution must be positive");
+	setName("ScheduledExecutor");
+	for(unsigned int i = 0; i < eLevels; ++i) {
+		for(unsigned int j = 0; j < eSlots; ++j) mSlots[i][j].mPrevious = mSlots[i][j].mNext = &mSlots[i][j];
+	}
+	mTicker = new Ticker(this);
+}
+
+/*! \brief Delete scheduler.
+
+The scheduler thread is terminated, and the tasks that are still scheduled are discarded. Occurrences that were already pushed onto the thread pool are not affected.
+*/
+Threading::ScheduledExecutor::~ScheduledExecutor(void)
+{
+	lock();
+	mShutdown = true;
+	signal();
+	unlock();
+	delete mTicker;
+	for(unordered_map<unsigned long, Entry*>::iterator lIter = mEntries.begin(); lIter != mEntries.end(); ++lIter) delete lIter->second;
+}
+
+//! Schedule a new entry for task \c inTask or function \c inFunction (see ScheduledExecutor::scheduleAtFixedRate).
+unsigned long Threading::ScheduledExecutor::add(Task* inTask, const function<void()>& inFunction, double inDelay, double inPeriod)
+{
+	if(inDelay < 0) throw Exception(eOtherError, "ScheduledExecutor::schedule() delay must not be negative");
+	Entry* lEntry = new Entry;
+	lEntry->mTask = inTask;
+	if(!inTask) lEntry->mFunction = inFunction;
+	lEntry->mPeriod = inPeriod;
+	lEntry->mFired = false;
+	lock();
+	// the entry may fire as soon as the mutex is unlocked
+	unsigned long lHandle = lEntry->mHandle = mNextHandle++;
+	if(mNextHandle == 0) mNextHandle = 1;
+	double lNow = mTimer.getValue();
+	// the wheel does not advance while it is empty: catch up to the current tick first
+	if(mEntries.empty()) advance((unsigned long long) floor(lNow / mResolution));
+	lEntry->mDue = lNow + inDelay;
+	lEntry->mExpiry = getTick(lEntry->mDue);
+	insert(lEntry);
+	mEntries[lEntry->mHandle] = lEntry;
+	// wake up the scheduler thread if it sleeps past the new entry
+	if(mWakeup == 0 || lEntry->mExpiry < mWakeup) signal();
+	unlock();
+	return lHandle;
+}
+
+/*! \brief Advance the timing wheel up to tick \c inTick, firing all entries that are due.
+
+The scheduler mutex must be locked. For every tick, the slots of the upper levels that start at this tick are cascaded into the lower levels, and then the entries of the level 0 slot of the tick are fired.
+*/
+void Threading::ScheduledExecutor::advance(unsigned long long inTick)
+{
+	if(mEntries.empty()) {
+		// nothing to fire or to cascade
+		if(inTick > mCurrent) mCurrent = inTick;
+		return;
+	}
+	while(mCurrent < inTick) {
+		unsigned long long lTick = ++mCurrent;
+		// cascade upper levels
+		for(unsigned int i = 1; i < eLevels && (lTick & ((1ULL << (eBits*i)) - 1)) == 0; ++i) {
+			Entry& lSlot = mSlots[i][(lTick >> (eBits*i)) & (eSlots-1)];
+			Entry* lEntry = lSlot.mNext;
+			lSlot.mPrevious = lSlot.mNext = &lSlot;
+			while(lEntry != &lSlot) {
+				Entry* lNext = lEntry->mNext;
+				insert(lEntry);
+				lEntry = lNext;
+			}
+		}
+		// fire the entries of this tick
+		Entry& lSlot = mSlots[0][lTick & (eSlots-1)];
+		while(lSlot.mNext != &lSlot) {
+			Entry* lEntry = lSlot.mNext;
+			unlink(lEntry);
+			fire(lEntry);
+		}
+	}
+}
+
+/*! \brief Cancel scheduled task \c inHandle.
+\return True if the task was cancelled, false if the handle is invalid (e.g. a one-shot task that has already fired).
+
+Occurrences of the task that were already pushed onto the thread pool still execute.
+*/
+bool Threading::ScheduledExecutor::cancel(unsigned long inHandle)
+{
+	lock();
+	unordered_map<unsigned long, Entry*>::iterator lIter = mEntries.find(inHandle);
+	if(lIter == mEntries.end()) {
+		unlock();
+		return false;
+	}
+	Entry* lEntry = lIter->second;
+	unlink(lEntry);
+	mEntries.erase(lIter);
+	unlock();
+	delete lEntry;
+	return true;
+}
+
+/*! \brief Push due entry \c inEntry onto the thread pool, and reschedule it if it is periodic.
+
+The scheduler mutex must be locked. An occurrence of a task is skipped if its previous occurrence has not completed, and the next occurrence of a periodic entry is the first one that is still in the future.
+*/
+void Threading::ScheduledExecutor::fire(Entry* inEntry)
+{
+	if(!inEntry->mTask) mPool.submit(inEntry->mFunction);
+	else if(!inEntry->mFired || inEntry->mTask->isCompleted()) mPool.push(*inEntry->mTask);
+	inEntry->mFired = true;
+	if(inEntry->mPeriod > 0) {
+		do {
+			inEntry->mDue += inEntry->mPeriod;
+			inEntry->mExpiry = getTick(inEntry->mDue);
+		} while(inEntry->mExpiry <= mCurrent);
+		insert(inEntry);
+	}
+	else {
+		mEntries.erase(inEntry->mHandle);
+		delete inEntry;
+	}
+}
+
+/*! \brief Return the next tick at which the scheduler thread should wake up (0 if no entry is scheduled).
+
+This is the next tick of the current rotation of level 0 that has a due entry, or the end of this rotation if none has (upper levels are then cascaded).
+*/
+unsigned long long Threading::ScheduledExecutor::getNextTick(void) const
+{
+	if(mEntries.empty()) return 0;
+	unsigned long long lEnd = ((mCurrent >> eBits) + 1) << eBits;
+	for(unsigned long long lTick = mCurrent+1; lTick < lEnd; ++lTick) {
+		const Entry& lSlot = mSlots[0][lTick & (eSlots-1)];
+		if(lSlot.mNext != &lSlot) return lTick;
+	}
+	return lEnd;
+}
+
+/*! \brief Insert entry \c inEntry into the slot of its expiry tick.
+
+The scheduler mutex must be locked. The level is the lowest one that spans the delay until the expiry tick (an entry that is already due goes into the next tick). An entry beyond the range of the wheel goes into the last slot of the top level, and is inserted again when this slot is cascaded.
+*/
+void Threading::ScheduledExecutor::insert(Entry* inEntry)
+{
+	unsigned long long lExpiry = inEntry->mExpiry > mCurrent ? inEntry->mExpiry : mCurrent+1;
+	unsigned long long lDelta = lExpiry - mCurrent;
+	unsigned int lLevel = 0;
+	while(lLevel < eLevels-1 && lDelta >= (1ULL << (eBits*(lLevel+1)))) ++lLevel;
+	if(lDelta >= (1ULL << (eBits*eLevels))) lExpiry = mCurrent + (1ULL << (eBits*eLevels)) - 1;
+	Entry& lSlot = mSlots[lLevel][(lExpiry >> (eBits*lLevel)) & (eSlots-1)];
+	inEntry->mPrevious = lSlot.mPrevious;
+	inEntry->mNext = &lSlot;
+	lSlot.mPrevious->mNext = inEntry;
+	lSlot.mPrevious = inEntry;
+}
+
+/*! \brief Push task \c inTask onto the thread pool once, after \c inDelay seconds.
+\return Handle of the scheduled task (see ScheduledExecutor::cancel).
+
+The task must remain valid until it has completed, or until it is cancelled. Throws a Threading::Exception if the delay is negative.
+*/
+unsigned long Threading::ScheduledExecutor::schedule(Task& inTask, double inDelay)
+{
+	return add(&inTask, function<void()>(), inDelay, 0);
+}
+
+/*! \brief Execute function \c inFunction once on the thread pool, after \c inDelay seconds.
+\return Handle of the scheduled function (see ScheduledExecutor::cancel).
+
+The function is copied, and pushed as a detached task when due. Throws a Threading::Exception if the delay is negative.
+*/
+unsigned long Threading::ScheduledExecutor::schedule(const function<void()>& inFunction, double inDelay)
+{
+	return add(0, inFunction, inDelay, 0);
+}
+
+/*! \brief Push task \c inTask onto the thread pool every \c inPeriod seconds, starting after \c inDelay seconds.
+\return Handle of the scheduled task (see ScheduledExecutor::cancel).
+
+An occurrence is skipped if the previous one has not completed (see class ScheduledExecutor). The task must remain valid until it is cancelled and its last occurrence has completed. Throws a Threading::Exception if the delay is negative or if the period is not positive.
+*/
+unsigned long Threading::ScheduledExecutor::scheduleAtFixedRate(Task& inTask, double inDelay, double inPeriod)
+{
+	if(inPeriod <= 0) throw Exception(eOtherError, "ScheduledExecutor::scheduleAtFixedRate() period must be positive");
+	return add(&inTask, function<void()>(), inDelay, inPeriod);
+}
+
+/*! \brief Execute function \c inFunction on the thread pool every \c inPeriod seconds, starting after \c inDelay seconds.
+\return Handle of the scheduled function (see ScheduledExecutor::cancel).
+
+Every occurrence is pushed as a detached task; occurrences may thus overlap if the function takes longer than the period. Throws a Threading::Exception if the delay is negative or if the period is not positive.
+*/
+unsigned long Threading::ScheduledExecutor::scheduleAtFixedRate(const function<void()>& inFunction, double inDelay, double inPeriod)
+{
+	if(inPeriod <= 0) throw Exception(eOtherError, "ScheduledExecutor::scheduleAtFixedRate() period must be positive");
+	return add(0, inFunction, inDelay, inPeriod);
+}
+
+/*! \brief Advance the timing wheel until the scheduler is deleted (scheduler thread).
+
+The thread fires the due entries, and then sleeps until the next tick that has a due entry (or until the end of the current rotation of level 0), or indefinitely if no entry is scheduled. Scheduling an earlier entry wakes it up.
+*/
+void Threading::ScheduledExecutor::tick(void)
+{
+	lock();
+	while(!mShutdown) {
+		advance((unsigned long long) floor(mTimer.getValue() / mResolution));
+		mWakeup = getNextTick();
+		if(mWakeup == 0) Condition::wait();
+		else {
+			double lDelay = mWakeup * mResolution - mTimer.getValue();
+			if(lDelay > 0) Condition::wait(lDelay);
+		}
+	}
+	unlock();
+}
+
+//! Remove entry \c inEntry from the list of its slot.
+void Threading::ScheduledExecutor::unlink(Entry* inEntry)
+{
+	inEntry->mPrevious->mNext = inEntry->mNext;
+	inEntry->mNext->mPrevious = inEntry->mPrevious;
+}
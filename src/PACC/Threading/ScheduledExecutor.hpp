@@ -0,0 +1,167 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/ScheduledExecutor.hpp
+ * \brief Class definition for the delayed and periodic task scheduler.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#ifndef PACC_Threading_ScheduledExecutor_hpp_
+#define PACC_Threading_ScheduledExecutor_hpp_
+
+#include "PACC/Threading/Condition.hpp"
+#include "PACC/Threading/Thread.hpp"
+#include "PACC/Threading/ThreadPool.hpp"
+#include "PACC/Util/Timer.hpp"
+#include <cmath>
+#include <functional>
+#include <unordered_map>
+
+namespace PACC { 
+	
+	using namespace std;
+	
+	namespace Threading {
+		
+		/*! \brief Scheduler of delayed and periodic tasks.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		This class pushes tasks onto a ThreadPool after a delay (see ScheduledExecutor::schedule), or periodically at a fixed rate (see ScheduledExecutor::scheduleAtFixedRate). A single thread keeps track of all scheduled tasks, and sleeps until the next one is due, so that thousands of time outs and heartbeats cost neither a thread nor a poll each. For instance:
+		\code
+ThreadPool lPool(4);
+ScheduledExecutor lScheduler(lPool);
+unsigned long lTimeout = lScheduler.schedule([&]() {lConnection.close();}, 30);
+unsigned long lHeartbeat = lScheduler.scheduleAtFixedRate(lPingTask, 0, 1);
+...
+lScheduler.cancel(lTimeout); // connection was answered in time
+		\endcode
+		
+		Scheduled tasks are kept in a hierarchical timing wheel: time is divided into ticks of a fixed resolution (1 millisecond by default), and every level of the wheel holds 256 slots that each span 256 times more ticks than the slots of the level below. A task is inserted into the slot of its expiry tick, at the level that matches its delay, and moves down one level whenever the wheel completes a rotation of the level below (cascading). Both insertion and cancellation therefore take constant time, whatever the number of scheduled tasks; a task fires within one tick after its due time.
+		
+		Periodic tasks are scheduled at a fixed rate: the n-th occurrence is due at the initial delay plus n periods, regardless of the time spent executing the previous ones. An occurrence is skipped if the previous occurrence of the same Task object has not completed yet (since a task cannot be pushed twice), and occurrences that are late by more than a period are skipped as well. Scheduled functions are pushed as detached tasks (see ThreadPool::submit), and are never skipped for that reason.
+		
+		Cancelling a task only prevents its future occurrences: an occurrence that has already been pushed onto the pool is not removed, and must be waited for before the task is deleted.
+		*/
+		class ScheduledExecutor : public Condition {
+			public:
+			ScheduledExecutor(ThreadPool& inPool, double inResolution=0.001);
+			~ScheduledExecutor(void);
+			
+			bool cancel(unsigned long inHandle);
+			//! Return the number of scheduled tasks.
+			unsigned int getPending(void) const {lock(); unsigned int lPending = (unsigned int) mEntries.size(); unlock(); return lPending;}
+			//! Return the thread pool that executes the scheduled tasks.
+			ThreadPool& getPool(void) const {return mPool;}
+			//! Return the duration of a tick (in seconds).
+			double getResolution(void) const {return mResolution;}
+			
+			unsigned long schedule(Task& inTask, double inDelay);
+			unsigned long schedule(const function<void()>& inFunction, double inDelay);
+			unsigned long scheduleAtFixedRate(Task& inTask, double inDelay, double inPeriod);
+			unsigned long scheduleAtFixedRate(const function<void()>& inFunction, double inDelay, double inPeriod);
+			
+			protected:
+			//! Number of levels of the timing wheel.
+			enum {eLevels = 4};
+			//! Number of bits of the slot index (256 slots per level).
+			enum {eBits = 8};
+			//! Number of slots per level.
+			enum {eSlots = 1 << eBits};
+			
+			/*! \brief Scheduled task of the timing wheel.
+			\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+			\ingroup Threading
+			
+			Entries are linked in the (circular) list of their slot.
+			*/
+			struct Entry {
+				unsigned long mHandle; //!< Handle returned to the user.
+				Task* mTask; //!< Scheduled task (null for a function).
+				function<void()> mFunction; //!< Scheduled function (if mTask is null).
+				double mDue; //!< Time at which the entry is due (in seconds).
+				double mPeriod; //!< Period in seconds (0 for a one-shot entry).
+				unsigned long long mExpiry; //!< Tick at which the entry is due.
+				bool mFired; //!< The task has already been pushed once.
+				Entry* mPrevious; //!< Previous entry of the slot.
+				Entry* mNext; //!< Next entry of the slot.
+			};
+			
+			/*! \brief Thread that advances the timing wheel of a scheduler.
+			\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+			\ingroup Threading
+			*/
+			class Ticker : public Thread {
+				public:
+				//! Construct and start thread of scheduler \c inScheduler.
+				Ticker(ScheduledExecutor* inScheduler) : mScheduler(inScheduler) {run();}
+				//! Delete thread; wait for thread termination.
+				~Ticker(void) {wait(true);}
+				
+				protected:
+				ScheduledExecutor* mScheduler; //!< Parent scheduler.
+				
+				//! Advance the timing wheel of the scheduler until it is deleted.
+				void main(void) {mScheduler->tick();}
+			};
+			
+			ThreadPool& mPool; //!< Thread pool that executes the tasks.
+			double mResolution; //!< Duration of a tick (in seconds).
+			PACC::Timer mTimer; //!< Time base of the ticks.
+			Entry mSlots[eLevels][eSlots]; //!< Sentinels of the slot lists.
+			unordered_map<unsigned long, Entry*> mEntries; //!< Scheduled entries indexed by handle.
+			unsigned long long mCurrent; //!< Last processed tick.
+			unsigned long long mWakeup; //!< Tick at which the ticker thread will wake up (0 if it waits for a new entry).
+			unsigned long mNextHandle; //!< Handle of the next scheduled entry.
+			bool mShutdown; //!< Scheduler is being deleted flag.
+			Ticker* mTicker; //!< Thread that advances the wheel.
+			
+			unsigned long add(Task* inTask, const function<void()>& inFunction, double inDelay, double inPeriod);
+			void advance(unsigned long long inTick);
+			void fire(Entry* inEntry);
+			unsigned long long getNextTick(void) const;
+			//! Return the tick at which time \c inTime (in seconds) is due.
+			unsigned long long getTick(double inTime) const {return (unsigned long long) ceil(inTime / mResolution);}
+			void insert(Entry* inEntry);
+			static void unlink(Entry* inEntry);
+			void tick(void);
+			
+			private:
+			//! restrict (disable) copy constructor.
+			ScheduledExecutor(const ScheduledExecutor&);
+			//! restrict (disable) assignment operator.
+			void operator=(const ScheduledExecutor&);
+		};
+		
+	} // end of Threading namespace
+	
+} // end of PACC namespace
+
+#endif // PACC_Threading_ScheduledExecutor_hpp_
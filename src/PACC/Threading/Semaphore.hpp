@@ -49,6 +49,8 @@ namespace PACC {
 		
 		This class incapsulates a counting semaphore with classic Semaphore::post, Semaphore::tryWait, and Semaphore::wait methods. The semaphore is initialized with a count of \c inCount ressources (see constructor). A post increments the count while a wait decrements it. A count of 0 means that no more ressources are available. Subsequent calls to wait will block until future post releases some of the allocated ressources. When several threads have blocked because of exhausted ressources, the order in which they will be released is undetermined (FIFO should not be assumed).
 		
+		Every operation locks the embedded mutex. For semaphores that are acquired and released at high rates, class AtomicSemaphore has lock-free uncontended operations.
+		
 		This class does not contain any OS dependant code. However, it is built over classes Condition and Mutex which may not be fully cross-platform (see documentation of these classes for more details). 
 		*/
 		class Semaphore : public Condition {
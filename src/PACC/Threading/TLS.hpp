@@ -46,7 +46,7 @@ namespace PACC {
 		\author Marc Parizeau, Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
 		\ingroup Threading
 		
-		This class incapsulates the thread local storage mechanisms found in Windows or POSIX pthread.
+		This class incapsulates the thread local storage mechanisms found in Windows or POSIX pthread. It stores an untyped pointer per thread, and each access is a library call; see class ThreadLocal for typed values with lazy per-thread construction and faster access.
 		*/
 		class TLS {
 		 public:
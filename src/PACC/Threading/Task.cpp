@@ -0,0 +1,88 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/Task.cpp
+ * \brief Class methods for the abstract task of the portable thread pool.
+ * \author Marc Parizeau, Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#include "PACC/Threading/Task.hpp"
+#include "PACC/Threading/Futex.hpp"
+
+using namespace PACC;
+
+/*! \brief Execute task in the calling thread, and mark it as completed.
+
+If the cancellation token of the task is canceled, Task::skip is called instead of Task::main, and the task is flagged as skipped.
+*/
+void Threading::Task::run(void)
+{
+	setRunning();
+	if(mToken.isCanceled()) {
+		skip();
+		setCompleted(eSkipped);
+	}
+	else {
+		main();
+		setCompleted();
+	}
+}
+
+/*! \brief Mark task as completed with additional state flags \c inFlags, and wake up waiting threads if any.
+
+This method is called by the executing thread after Task::main returns. The task should not be accessed by this thread afterwards, since a waiting thread may delete it as soon as it is marked completed. A detached task has no waiter by definition, and is deleted right away.
+*/
+void Threading::Task::setCompleted(unsigned int inFlags)
+{
+	if(mState.load(memory_order_relaxed) & eDetached) {
+		mState.store(eCompleted | eDetached | inFlags, memory_order_relaxed);
+		delete this;
+		return;
+	}
+	if(mState.exchange(eCompleted | inFlags, memory_order_acq_rel) & eWaiters) Futex::wakeAll(mState);
+}
+
+/*! \brief Wait for task to complete.
+
+The calling thread returns immediately if the task is already completed. Otherwise, it flags the task as having waiters and blocks until completion. Argument \c inLock is ignored; it is only kept for compatibility with former versions where the task embedded its own condition.
+*/
+void Threading::Task::wait(bool) const
+{
+	unsigned int lState = mState.load(memory_order_acquire);
+	while((lState & eStateMask) != eCompleted) {
+		if(!(lState & eWaiters)) {
+			// set waiter flag before blocking
+			if(!mState.compare_exchange_weak(lState, lState | eWaiters, memory_order_acquire)) continue;
+			lState |= eWaiters;
+		}
+		Futex::wait(mState, lState);
+		lState = mState.load(memory_order_acquire);
+	}
+}
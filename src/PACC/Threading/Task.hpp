@@ -36,36 +36,53 @@
 #ifndef PACC_Threading_Task_hpp_
 #define PACC_Threading_Task_hpp_
 
-#include "PACC/Threading/Condition.hpp"
+#include "PACC/Threading/CancellationToken.hpp"
+#include "PACC/Util/ObjectPool.hpp"
+#include <atomic>
 
 namespace PACC {
 	
+	using namespace std;
+	
 	namespace Threading {
 		
 		/*! \brief %Task for thread pool execution.
 		\author Marc Parizeau, Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
 		\ingroup Threading
 		
-		This abstract class encapsulates a primitive task that can be executed by a ThreadPool. It must be subclassed in order to implement virtual method Task::main which defines the task's function. Once pushed onto a thread pool using method ThreadPool::push, the task will start executing as soon as a thread becomes available. A task cannot be canceled after it has started to run.
+		This abstract class encapsulates a primitive task that can be executed by a ThreadPool. It must be subclassed in order to implement virtual method Task::main which defines the task's function. Once pushed onto a thread pool using method ThreadPool::push, the task will start executing as soon as a thread becomes available.
+		
+		A task can carry a cancellation token (see Task::setCancellationToken). If the token is canceled before the task starts, the thread pool skips the task: it calls Task::skip instead of Task::main, and marks the task as completed (see Task::isSkipped). A task cannot be interrupted after it has started to run, but it can poll its token (see Task::isCanceled) and return early.
+		
+		The state of a task (pending, running or completed) is kept in a single atomic word. Starting and completing a task each cost a single atomic operation; a thread that calls Task::wait on a task that is not completed yet sets a waiter flag in this word and blocks on it (see class Futex), so that the slave thread only makes a system call to wake up waiters when there actually are some. A task does not allocate any native synchronization object, and tasks allocated with operator new (including the detached tasks of ThreadPool::submit and Future::then) come from a thread caching ObjectPool.
 		*/
-		class Task : public Condition {
+		class Task : public Pooled<Task> {
 			public: 
-			//! Construct default task: initialize to not running and not completed.
-			Task(void) : mRunning(false), mCompleted(false) {}
+			//! Construct default task: initialize to not running and not completed, with priority 0 and without deadline.
+			Task(void) : mState(ePending), mPriority(0), mDeadline(0), mEnqueued(0), mSequence(0), mKey(0) {}
 			//! Delete task: wait for task completion.
-			virtual ~Task(void) {lock(); while(!mCompleted) wait(); unlock();}
+			virtual ~Task(void) {wait();}
 			
-			/*! \brief Check wheter task is completed.
+			//! Check wheter task is completed.
+			bool isCompleted(void) const {return (mState.load(memory_order_acquire) & eStateMask) == eCompleted;}
 			
-			The embedded mutex should always be locked (using method Task::lock) prior to calling this method.
-			*/
-			bool isCompleted(void) const {return mCompleted;}
+			//! Check wheter task is running.
+			bool isRunning(void) const {return (mState.load(memory_order_acquire) & eStateMask) == eRunning;}
 			
-			/*! \brief Check wheter task is running.
+			//! Check whether the cancellation token of task was canceled (running tasks should poll this method to return early).
+			bool isCanceled(void) const {return mToken.isCanceled();}
 			
-			The embedded mutex should always be locked (using method Task::lock) prior to calling this method.
-			*/
-			bool isRunning(void) const {return mRunning;}
+			//! Check whether task was skipped, because its token was canceled before it started (see Task::setCancellationToken).
+			bool isSkipped(void) const {return (mState.load(memory_order_acquire) & eSkipped) != 0;}
+			
+			//! Return cancellation token of task (see Task::setCancellationToken).
+			const CancellationToken& getCancellationToken(void) const {return mToken;}
+			
+			//! Return deadline of task (see Task::setDeadline).
+			double getDeadline(void) const {return mDeadline;}
+			
+			//! Return priority of task (see Task::setPriority).
+			int getPriority(void) const {return mPriority;}
 			
 			/*! \brief Implements main procedure of task.
 			
@@ -73,24 +90,72 @@ namespace PACC {
 			*/
 			virtual void main(void) = 0;
 			
-			//! Reset internal task state to default (not running and not completed).
-			void reset(void) {lock(); mRunning = mCompleted = false; unlock();}
+			//! Reset internal task state to default (not running and not completed), keeping the waiter flag of threads that already wait for it.
+			void reset(void) {mState.fetch_and(eWaiters, memory_order_relaxed);}
+			
+			/*! \brief Set cancellation token of task to \c inToken.
+			
+			A task whose token is canceled before it starts is skipped by the thread pool (see class Task). The token should be set before pushing the task.
+			*/
+			void setCancellationToken(const CancellationToken& inToken) {mToken = inToken;}
+			
+			/*! \brief Set deadline of task to \c inDelay seconds after it is pushed (0 means no deadline).
+			
+			Deadlines are only used by thread pools in mode ThreadPool::eDeadline. The deadline should be set before pushing the task.
+			*/
+			void setDeadline(double inDelay) {mDeadline = inDelay;}
+			
+			/*! \brief Set priority of task to \c inPriority (larger values are served first).
 			
-			/*! \brief Wait for task to complete.
-				
-				If argument \c inLock is true (default), this method locks the embedded mutex prior to waiting on the condition, and unlocks the mutex prior to return. Otherwise, it assumes that the mutex is already locked and does not modify its state. This method should never be called with argument \c inLock=false without first locking the mutex using method Task::lock.
+			Priorities are only used by thread pools in mode ThreadPool::ePriority, and for their wait statistics (see ThreadPool::getWaitStatistics). The priority should be set before pushing the task.
 			*/
-			void wait(bool inLock=true) const {
-				if(inLock) lock();
-				while(!mCompleted) Condition::wait();
-				if(inLock) unlock();
-			}
+			void setPriority(int inPriority) {mPriority = inPriority;}
+			
+			/*! \brief Called instead of Task::main when task is skipped (see class Task).
+			
+			This method does nothing by default. It can be overloaded to release resources, or to report the cancellation to the consumers of the task result. It is called by the executing thread, and must not throw.
+			*/
+			virtual void skip(void) {}
+			
+			//! Lock task (this method is deprecated; it does nothing, since the state of a task no longer needs to be locked).
+			void lock(void) const {}
+			//! Unlock task (this method is deprecated; see Task::lock).
+			void unlock(void) const {}
+			
+			void wait(bool inLock=true) const;
 			
 			protected:
-			bool mRunning; //!< is running flag
-			bool mCompleted; //!< is completed flag
+			//! Bit fields of the state word.
+			enum State {
+				ePending = 0, //!< Task is not running and not completed.
+				eRunning = 1, //!< Task is running.
+				eCompleted = 2, //!< Task is completed.
+				eStateMask = 3, //!< Mask of the state bits.
+				eWaiters = 4, //!< Some thread is waiting for completion.
+				eDetached = 8, //!< Task is deleted by the thread pool upon completion.
+				eCounted = 16, //!< Task was counted as pending by the metrics of the thread pool.
+				eTimed = 32, //!< Task is timed by the metrics of the thread pool.
+				eSkipped = 64 //!< Task was skipped, because it was canceled before it started.
+			};
+			
+			mutable atomic<unsigned int> mState; //!< State word of task.
+			int mPriority; //!< Priority of task.
+			double mDeadline; //!< Deadline of task relative to its push (in seconds).
+			double mEnqueued; //!< Time of push (set by the thread pool).
+			unsigned long long mSequence; //!< Sequence number of push (set by the thread pool).
+			double mKey; //!< Scheduling key of task (set by the thread pool).
+			CancellationToken mToken; //!< Cancellation token of task.
+			
+			//! Mark task as running (called by the executing thread).
+			void setRunning(void) {mState.fetch_add(eRunning-ePending, memory_order_relaxed);}
+			void setCompleted(unsigned int inFlags=0);
+			void run(void);
+			//! Mark task as pending and owned by the thread pool (see ThreadPool::pushDetached).
+			void setDetached(void) {reset(); mState.fetch_or(eDetached, memory_order_relaxed);}
 			
 			friend class SlaveThread;
+			friend class TaskGraph;
+			friend class ThreadPool;
 		};
 		
 	} // end of Threading namespace 
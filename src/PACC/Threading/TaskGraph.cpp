@@ -0,0 +1,317 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/TaskGraph.cpp
+ * \brief Class methods for the task dependency graph.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#include "PACC/Threading/TaskGraph.hpp"
+#include "PACC/Threading/Futex.hpp"
+#include "PACC/Threading/ThreadPool.hpp"
+#include <algorithm>
+#include <iomanip>
+
+using namespace std;
+using namespace PACC;
+
+//! Construct empty graph.
+Threading::TaskGraph::TaskGraph(void) : mSorted(true), mPool(0), mRemaining(0), mFailed(false), mState(0), mStart(0), mStop(0)
+{}
+
+//! Delete graph; wait for completion of the current execution, if any (an exception thrown by a node is ignored).
+Threading::TaskGraph::~TaskGraph(void)
+{
+	join();
+	for(unsigned int i = 0; i < mNodes.size(); ++i) delete mNodes[i];
+}
+
+/*! \brief Add node for task \c inTask, with name \c inName.
+\return Index of new node.
+
+The task is not pushed onto the thread pool itself, but its state is updated as if it had been: it is reset when the graph starts executing, and marked completed once its Task::main method returns, so that it can be waited for with method Task::wait. The task must outlive the graph.
+*/
+unsigned int Threading::TaskGraph::addNode(Task& inTask, const string& inName)
+{
+	return insertNode(&inTask, function<void()>(), inName);
+}
+
+/*! \brief Add node for function \c inFunction, with name \c inName.
+\return Index of new node.
+*/
+unsigned int Threading::TaskGraph::addNode(const function<void()>& inFunction, const string& inName)
+{
+	return insertNode(0, inFunction, inName);
+}
+
+/*! \brief Make node \c inNode depend on node \c inPredecessor.
+
+Node \c inNode will only start once node \c inPredecessor has completed. An exception is thrown if either index is invalid, or if the graph is executing. Cycles are detected at the next execution.
+*/
+void Threading::TaskGraph::addDependency(unsigned int inNode, unsigned int inPredecessor)
+{
+	if(inNode >= mNodes.size() || inPredecessor >= mNodes.size()) throw Exception(eOtherError, "TaskGraph::addDependency() invalid node index");
+	if(isRunning()) throw Exception(eOtherError, "TaskGraph::addDependency() graph is executing");
+	mNodes[inPredecessor]->mSuccessors.push_back(inNode);
+	++mNodes[inNode]->mPredecessors;
+	mSorted = false;
+}
+
+//! Execute graph on thread pool \c inPool, and wait for its completion (see TaskGraph::wait).
+void Threading::TaskGraph::execute(ThreadPool& inPool)
+{
+	run(inPool);
+	wait();
+}
+
+//! Record current exception as the failure of the current execution, unless an exception was already recorded.
+void Threading::TaskGraph::fail(void)
+{
+	if(!mFailed.exchange(true, memory_order_acq_rel)) mException = current_exception();
+}
+
+/*! \brief Return duration of critical path of last execution (in seconds).
+
+The critical path is the chain of dependent nodes with the longest total duration; no schedule can complete the graph faster than this duration, whatever the number of slave threads. If argument \c outPath is not null, it receives the indices of the nodes of this path, in execution order.
+*/
+double Threading::TaskGraph::getCriticalPath(vector<unsigned int>* outPath) const
+{
+	// longest path in topological order
+	vector<double> lFinish(mNodes.size(), 0);
+	vector<unsigned int> lParent(mNodes.size(), (unsigned int)-1);
+	unsigned int lLast = (unsigned int)-1;
+	for(unsigned int i = 0; i < mOrder.size(); ++i) {
+		unsigned int lNode = mOrder[i];
+		lFinish[lNode] += getDuration(lNode);
+		if(lLast == (unsigned int)-1 || lFinish[lNode] >= lFinish[lLast]) lLast = lNode;
+		const vector<unsigned int>& lSuccessors = mNodes[lNode]->mSuccessors;
+		for(unsigned int j = 0; j < lSuccessors.size(); ++j) {
+			if(lParent[lSuccessors[j]] == (unsigned int)-1 || lFinish[lNode] > lFinish[lSuccessors[j]]) {
+				lFinish[lSuccessors[j]] = lFinish[lNode];
+				lParent[lSuccessors[j]] = lNode;
+			}
+		}
+	}
+	if(outPath) {
+		outPath->clear();
+		for(unsigned int lNode = lLast; lNode != (unsigned int)-1; lNode = lParent[lNode]) outPath->push_back(lNode);
+		reverse(outPath->begin(), outPath->end());
+	}
+	return lLast == (unsigned int)-1 ? 0 : lFinish[lLast];
+}
+
+//! Return duration of node \c inNode during last execution (in seconds).
+double Threading::TaskGraph::getDuration(unsigned int inNode) const
+{
+	return (mNodes[inNode]->mStop - mNodes[inNode]->mStart) * mTimer.getCountPeriod();
+}
+
+//! Return elapsed time of last execution (in seconds).
+double Threading::TaskGraph::getElapsed(void) const
+{
+	return (mStop - mStart) * mTimer.getCountPeriod();
+}
+
+//! Return start time of node \c inNode, relative to the start of last execution (in seconds).
+double Threading::TaskGraph::getStart(unsigned int inNode) const
+{
+	return (mNodes[inNode]->mStart - mStart) * mTimer.getCountPeriod();
+}
+
+//! Return total work of last execution, i.e. the sum of the durations of all nodes (in seconds).
+double Threading::TaskGraph::getWork(void) const
+{
+	double lWork = 0;
+	for(unsigned int i = 0; i < mNodes.size(); ++i) lWork += getDuration(i);
+	return lWork;
+}
+
+/*! \brief Wait for completion of the current execution, without throwing the exception of a node.
+
+A slave of a thread pool executes pending tasks of its pool while it waits, and checks its pool again every millisecond while blocked.
+*/
+void Threading::TaskGraph::join(void) const
+{
+	SlaveThread* lSlave = SlaveThread::getCurrent();
+	unsigned int lState = mState.load(memory_order_acquire);
+	while(lState & eRunning) {
+		// help the pool of the calling slave, if any
+		if(lSlave && lSlave->getPool()->runPending()) {
+			lState = mState.load(memory_order_acquire);
+			continue;
+		}
+		if(!(lState & eWaiters)) {
+			// set waiter flag before blocking
+			if(!mState.compare_exchange_weak(lState, lState | eWaiters, memory_order_acquire)) continue;
+			lState |= eWaiters;
+		}
+		Futex::wait(mState, lState, lSlave ? 0.001 : 0);
+		lState = mState.load(memory_order_acquire);
+	}
+}
+
+//! Insert new node for task \c inTask or function \c inFunction.
+unsigned int Threading::TaskGraph::insertNode(Task* inTask, const function<void()>& inFunction, const string& inName)
+{
+	if(isRunning()) throw Exception(eOtherError, "TaskGraph::addNode() graph is executing");
+	unsigned int lIndex = mNodes.size();
+	mNodes.push_back(new Node(this, lIndex, inTask, inFunction, inName));
+	mSorted = false;
+	return lIndex;
+}
+
+/*! \brief Release successors of completed node \c inNode.
+
+Successors that have no more pending predecessors are pushed onto the thread pool. If node \c inNode is the last one to complete, the execution is terminated and waiting threads are awakened.
+*/
+void Threading::TaskGraph::release(Node* inNode)
+{
+	for(unsigned int i = 0; i < inNode->mSuccessors.size(); ++i) {
+		Node* lSuccessor = mNodes[inNode->mSuccessors[i]];
+		if(lSuccessor->mPending.fetch_sub(1, memory_order_acq_rel) == 1) mPool->push(*lSuccessor);
+	}
+	if(mRemaining.fetch_sub(1, memory_order_acq_rel) == 1) {
+		mStop = mTimer.getCount();
+		if(mState.exchange(0, memory_order_acq_rel) & eWaiters) Futex::wakeAll(mState);
+	}
+}
+
+/*! \brief Start execution of graph on thread pool \c inPool.
+
+This method pushes all nodes without predecessors onto the thread pool, and returns immediately; use method TaskGraph::wait to wait for completion. An exception is thrown if the graph is already executing, or if it contains a cycle.
+*/
+void Threading::TaskGraph::run(ThreadPool& inPool)
+{
+	if(isRunning()) throw Exception(eOtherError, "TaskGraph::run() graph is already executing");
+	// make sure that nodes of previous execution are all completed
+	for(unsigned int i = 0; i < mNodes.size(); ++i) mNodes[i]->Task::wait();
+	if(!mSorted) sort();
+	mPool = &inPool;
+	mStart = mTimer.getCount();
+	if(mNodes.empty()) {
+		mStop = mStart;
+		return;
+	}
+	for(unsigned int i = 0; i < mNodes.size(); ++i) {
+		mNodes[i]->mPending.store(mNodes[i]->mPredecessors, memory_order_relaxed);
+		if(mNodes[i]->mTask) mNodes[i]->mTask->reset();
+	}
+	mRemaining.store(mNodes.size(), memory_order_relaxed);
+	mFailed.store(false, memory_order_relaxed);
+	mException = exception_ptr();
+	mState.store(eRunning, memory_order_release);
+	for(unsigned int i = 0; i < mRoots.size(); ++i) inPool.push(*mNodes[mRoots[i]]);
+}
+
+//! Compute roots and topological order of graph; throw exception if graph contains a cycle.
+void Threading::TaskGraph::sort(void)
+{
+	mRoots.clear();
+	mOrder.clear();
+	vector<unsigned int> lPending(mNodes.size());
+	for(unsigned int i = 0; i < mNodes.size(); ++i) {
+		lPending[i] = mNodes[i]->mPredecessors;
+		if(lPending[i] == 0) {
+			mRoots.push_back(i);
+			mOrder.push_back(i);
+		}
+	}
+	// Kahn's algorithm
+	for(unsigned int i = 0; i < mOrder.size(); ++i) {
+		const vector<unsigned int>& lSuccessors = mNodes[mOrder[i]]->mSuccessors;
+		for(unsigned int j = 0; j < lSuccessors.size(); ++j) {
+			if(--lPending[lSuccessors[j]] == 0) mOrder.push_back(lSuccessors[j]);
+		}
+	}
+	if(mOrder.size() != mNodes.size()) throw Exception(eOtherError, "TaskGraph::run() graph contains a cycle");
+	mSorted = true;
+}
+
+/*! \brief Wait for completion of the current execution, and throw again the first exception thrown by a node, if any.
+
+This method returns immediately if the graph is not executing. A slave of a thread pool executes pending tasks of its pool while it waits.
+*/
+void Threading::TaskGraph::wait(void) const
+{
+	join();
+	if(mFailed.load(memory_order_acquire)) rethrow_exception(mException);
+}
+
+/*! \brief Write timing of last execution into stream \c outStream.
+
+The report lists the start time and duration of every node, followed by the critical path, the total work and the resulting parallelism (total work over critical path duration).
+*/
+void Threading::TaskGraph::writeTiming(ostream& outStream) const
+{
+	vector<unsigned int> lPath;
+	double lCritical = getCriticalPath(&lPath);
+	double lWork = getWork();
+	outStream << "TaskGraph: " << mNodes.size() << " nodes, elapsed " << getElapsed() << " s" << endl;
+	for(unsigned int i = 0; i < mNodes.size(); ++i) {
+		outStream << "  node " << setw(4) << i << " " << setw(16) << left << mNodes[i]->mName << right;
+		outStream << " start " << setw(12) << getStart(i) << " s, duration " << setw(12) << getDuration(i) << " s" << endl;
+	}
+	outStream << "  critical path " << lCritical << " s:";
+	for(unsigned int i = 0; i < lPath.size(); ++i) {
+		outStream << (i == 0 ? " " : " -> ");
+		if(mNodes[lPath[i]]->mName.empty()) outStream << lPath[i];
+		else outStream << mNodes[lPath[i]]->mName;
+	}
+	outStream << endl;
+	outStream << "  total work " << lWork << " s, parallelism " << (lCritical > 0 ? lWork/lCritical : 0) << endl;
+}
+
+/*! \brief Run task or function of node, and release its successors.
+
+An exception thrown by the node is recorded into the graph (see TaskGraph::fail), and its task, if any, is marked completed. Once the execution has failed, the node is skipped. Successors are always released, so that the execution terminates.
+*/
+void Threading::TaskGraph::Node::main(void)
+{
+	mStart = mGraph->mTimer.getCount();
+	if(mGraph->mFailed.load(memory_order_acquire)) {
+		if(mTask) {
+			mTask->setRunning();
+			mTask->skip();
+			mTask->setCompleted(eSkipped);
+		}
+	}
+	else {
+		try {
+			if(mTask) mTask->run();
+			else mFunction();
+		}
+		catch(...) {
+			mGraph->fail();
+			if(mTask && !mTask->isCompleted()) mTask->setCompleted();
+		}
+	}
+	mStop = mGraph->mTimer.getCount();
+	mGraph->release(this);
+}
@@ -0,0 +1,164 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/TaskGraph.hpp
+ * \brief Class definition for the task dependency graph.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#ifndef PACC_Threading_TaskGraph_hpp_
+#define PACC_Threading_TaskGraph_hpp_
+
+#include "PACC/Threading/ThreadPool.hpp"
+#include "PACC/Util/Timer.hpp"
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace PACC { 
+	
+	using namespace std;
+	
+	namespace Threading {
+		
+		/*! \brief Directed acyclic graph of dependent tasks.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		This class executes a set of tasks on a ThreadPool while respecting dependencies between them. Each node of the graph is either a Task object (only its Task::main method is called) or a function without argument. A node is pushed onto the thread pool as soon as all of its predecessors are completed, by the thread that completes the last of them; there is therefore no barrier between "waves" of tasks. In work-stealing mode (see ThreadPool::eWorkStealing), released successors go onto the local deque of the releasing slave, which then usually runs them next.
+		
+		Once built, a graph can be executed any number of times: an execution only resets counters, and does not allocate anything. Here is a simple usage example:
+		\code
+TaskGraph lGraph;
+unsigned int lLoad = lGraph.addNode([&]() {load(lData);}, "load");
+unsigned int lLeft = lGraph.addNode([&]() {processLeft(lData);}, "left");
+unsigned int lRight = lGraph.addNode([&]() {processRight(lData);}, "right");
+unsigned int lSave = lGraph.addNode([&]() {save(lData);}, "save");
+lGraph.addDependency(lLeft, lLoad);
+lGraph.addDependency(lRight, lLoad);
+lGraph.addDependency(lSave, lLeft);
+lGraph.addDependency(lSave, lRight);
+lGraph.execute(lPool);
+lGraph.writeTiming(cout);
+		\endcode
+		
+		If a node throws an exception, the first one is recorded, and the nodes that have not started yet are skipped (a node Task is then marked as skipped, see Task::isSkipped); the exception is thrown again by TaskGraph::wait (or TaskGraph::execute) once the execution has terminated. A thread of the pool that waits for a graph executes pending tasks of its pool meanwhile, so that a graph can be executed from within a task of the same pool.
+		
+		The start and stop times of every node are recorded during execution, so that the critical path of the last execution (i.e. the chain of dependent nodes with the longest total duration) can be retrieved with method TaskGraph::getCriticalPath, or printed with method TaskGraph::writeTiming.
+		*/
+		class TaskGraph {
+			public:
+			TaskGraph(void);
+			~TaskGraph(void);
+			
+			unsigned int addNode(Task& inTask, const string& inName="");
+			unsigned int addNode(const function<void()>& inFunction, const string& inName="");
+			void addDependency(unsigned int inNode, unsigned int inPredecessor);
+			
+			//! Return number of nodes in graph.
+			unsigned int size(void) const {return mNodes.size();}
+			//! Return name of node \c inNode.
+			const string& getName(unsigned int inNode) const {return mNodes[inNode]->mName;}
+			//! Return whether graph is currently executing.
+			bool isRunning(void) const {return (mState.load(memory_order_acquire) & eRunning) != 0;}
+			
+			void execute(ThreadPool& inPool);
+			void run(ThreadPool& inPool);
+			void wait(void) const;
+			
+			double getCriticalPath(vector<unsigned int>* outPath=0) const;
+			double getDuration(unsigned int inNode) const;
+			double getElapsed(void) const;
+			double getStart(unsigned int inNode) const;
+			double getWork(void) const;
+			void writeTiming(ostream& outStream) const;
+			
+			protected:
+			//! Node of graph.
+			class Node : public Task {
+				public:
+				//! Construct node \c inIndex of graph \c inGraph (initially marked completed, since it has not been pushed).
+				Node(TaskGraph* inGraph, unsigned int inIndex, Task* inTask, const function<void()>& inFunction, const string& inName)
+				: mGraph(inGraph), mIndex(inIndex), mTask(inTask), mFunction(inFunction), mName(inName), mPredecessors(0), mPending(0), mStart(0), mStop(0) {mState.store(eCompleted);}
+				
+				void main(void);
+				
+				TaskGraph* mGraph; //!< Parent graph.
+				unsigned int mIndex; //!< Index of node in graph.
+				Task* mTask; //!< Task to run (if any).
+				function<void()> mFunction; //!< Function to run (if no task).
+				string mName; //!< Name of node.
+				vector<unsigned int> mSuccessors; //!< Indices of successor nodes.
+				unsigned int mPredecessors; //!< Number of predecessor nodes.
+				atomic<unsigned int> mPending; //!< Number of predecessors not completed yet (during execution).
+				unsigned long long mStart; //!< Timer count at start of last execution.
+				unsigned long long mStop; //!< Timer count at end of last execution.
+			};
+			
+			//! Bits of the execution state word.
+			enum {
+				eRunning = 1, //!< Graph is executing.
+				eWaiters = 2 //!< Some thread is blocked waiting for completion.
+			};
+			
+			vector<Node*> mNodes; //!< Nodes of graph.
+			vector<unsigned int> mRoots; //!< Nodes without predecessors.
+			vector<unsigned int> mOrder; //!< Topological order of nodes.
+			bool mSorted; //!< Roots and topological order are up to date.
+			ThreadPool* mPool; //!< Thread pool of current execution.
+			atomic<unsigned int> mRemaining; //!< Number of nodes not completed yet (during execution).
+			atomic<bool> mFailed; //!< Some node of the current execution has thrown an exception.
+			exception_ptr mException; //!< First exception thrown by a node of the current execution.
+			mutable atomic<unsigned int> mState; //!< Execution state word.
+			Timer mTimer; //!< Timer of executions.
+			unsigned long long mStart; //!< Timer count at start of last execution.
+			unsigned long long mStop; //!< Timer count at end of last execution.
+			
+			void fail(void);
+			unsigned int insertNode(Task* inTask, const function<void()>& inFunction, const string& inName);
+			void join(void) const;
+			void release(Node* inNode);
+			void sort(void);
+			
+			private:
+			//! restrict (disable) copy constructor.
+			TaskGraph(const TaskGraph&);
+			//! restrict (disable) assignment operator.
+			void operator=(const TaskGraph&);
+		};
+		
+	} // end of Threading namespace
+	
+} // end of PACC namespace
+
+#endif // PACC_Threading_TaskGraph_hpp_
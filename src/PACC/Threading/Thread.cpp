@@ -63,12 +63,58 @@ struct ThreadStruct {
 #include <pthread.h>
 #include <unistd.h>
 #include <sys/errno.h>
+#ifdef PACC_AFFINITY
+#include <sched.h>
+#endif
 #define ErrNo errno // descriptor of last error
 typedef pthread_t ThreadStruct;
 #endif
 
+using namespace std;
 using namespace PACC;
 
+namespace {
+	
+#ifdef PACC_THREADS_WIN32
+	typedef HANDLE NativeHandle;
+#else // Unix...
+	typedef pthread_t NativeHandle;
+#endif
+	
+	/*! \brief Pin native thread \c inThread to processors \c inCPUs (all processors if empty).
+	\return False if the operating system refused the processor set, true otherwise.
+	*/
+	bool pinThread(NativeHandle inThread, const vector<unsigned int>& inCPUs)
+	{
+#if defined(PACC_AFFINITY) && defined(PACC_THREADS_WIN32)
+		DWORD_PTR lMask = 0;
+		for(unsigned int i = 0; i < inCPUs.size(); ++i) {
+			if(inCPUs[i] >= 8*sizeof(DWORD_PTR)) return false;
+			lMask |= ((DWORD_PTR) 1) << inCPUs[i];
+		}
+		if(lMask == 0) {
+			DWORD_PTR lSystem;
+			if(!::GetProcessAffinityMask(::GetCurrentProcess(), &lMask, &lSystem)) return false;
+		}
+		return ::SetThreadAffinityMask(inThread, lMask) != 0;
+#elif defined(PACC_AFFINITY)
+		cpu_set_t lSet;
+		CPU_ZERO(&lSet);
+		for(unsigned int i = 0; i < inCPUs.size(); ++i) {
+			if(inCPUs[i] >= CPU_SETSIZE) return false;
+			CPU_SET(inCPUs[i], &lSet);
+		}
+		if(inCPUs.empty()) {
+			for(unsigned int i = 0; i < CPU_SETSIZE; ++i) CPU_SET(i, &lSet);
+		}
+		return ::pthread_setaffinity_np(inThread, sizeof(lSet), &lSet) == 0;
+#else
+		return true;
+#endif
+	}
+	
+}
+
 /*! \brief Create thread.
 
 Note that method Thread::run must be called in order to start the execution of Thread::main.
@@ -207,6 +253,44 @@ void Threading::Thread::run(void)
 	unlock();
 }
 
+/*! \brief Pin this thread to the processors of set \c inCPUs.
+
+Processors are identified by their operating system index (from 0). An empty set removes any previous pinning. If the thread is not running yet, the set is applied as soon as it starts (before calling Thread::main), and the thread never runs elsewhere. If it is already running, the set is applied immediately by the calling thread.
+
+A Threading::Exception is thrown if the operating system refuses the set (e.g. because it contains no valid processor). On platforms that do not support thread affinity (see Thread::isAffinitySupported), the set is recorded but has no effect.
+*/
+void Threading::Thread::setAffinity(const vector<unsigned int>& inCPUs)
+{
+	lock();
+	mAffinity = inCPUs;
+	bool lSuccess = true;
+	if(mRunning) {
+#ifdef PACC_THREADS_WIN32
+		lSuccess = pinThread(((ThreadStruct*) mThread)->mHandle, inCPUs);
+#else // Unix...
+		lSuccess = pinThread(*((ThreadStruct*) mThread), inCPUs);
+#endif
+	}
+	unlock();
+	if(!lSuccess) throw Exception(eOtherError, "Thread::setAffinity() invalid processor set");
+}
+
+//! Pin this thread to processor \c inCPU (see Thread::setAffinity(const vector<unsigned int>&)).
+void Threading::Thread::setAffinity(unsigned int inCPU)
+{
+	setAffinity(vector<unsigned int>(1, inCPU));
+}
+
+//! Return whether thread affinity is supported on this platform.
+bool Threading::Thread::isAffinitySupported(void)
+{
+#ifdef PACC_AFFINITY
+	return true;
+#else
+	return false;
+#endif
+}
+
 /*! \brief Sleep calling thread for \c inSeconds seconds. 
 
 A negative value will throw a Threading::Exception.
@@ -232,6 +316,21 @@ void Threading::Thread::sleep(double inSeconds)
 #endif
 }
 
+/*! \brief Hint the processor that the calling thread is spin-waiting.
+
+This function should be called on each iteration of a busy wait loop (e.g. see Mutex::lock). On processors that support it, it reduces the power consumption of the loop and its impact on a sibling hardware thread, and it avoids a costly pipeline flush when the loop exits. Otherwise, it does nothing.
+*/
+void Threading::Thread::pause(void)
+{
+#if defined(_MSC_VER)
+	YieldProcessor();
+#elif defined(__i386__) || defined(__x86_64__)
+	__builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+	__asm__ __volatile__("yield");
+#endif
+}
+
 /*! \brief Startup thread.
 
 This function is first called when the thread starts up and immediately calls function Thread::main. After main returns (or is cancelled), it cleans up by signalling any waiting thread, and then terminates.
@@ -241,6 +340,12 @@ void* Threading::Thread::startup(void* inThread)
 	Thread* lThread = (Thread*) inThread;
 	// signal parent thread that this thread is starting to run
 	lThread->lock();
+	// pin thread before it executes anything (an invalid set is ignored)
+#ifdef PACC_THREADS_WIN32
+	if(!lThread->mAffinity.empty()) pinThread(::GetCurrentThread(), lThread->mAffinity);
+#else // Unix...
+	if(!lThread->mAffinity.empty()) pinThread(::pthread_self(), lThread->mAffinity);
+#endif
 	lThread->mRunning = true;
 	lThread->signal();
 	lThread->unlock();
@@ -37,6 +37,7 @@
 #define PACC_Threading_Thread_hpp_
 
 #include "PACC/Threading/Condition.hpp"
+#include <vector>
 
 namespace PACC { 
 	
@@ -48,6 +49,8 @@ namespace PACC {
 		
 		This class incapsulates an abstract cross-platform thread. It should be subclassed in order to define virtual member function Thread::main which is called soon after thread creation (see Thread::run). The thread terminates when main returns or after a call to Thread::cancel is honored by a subsequent cancellation point. A cancellation point can be created by a call to Thread::makeCancellationPoint.
 		
+		A thread can be pinned to a set of processors (see Thread::setAffinity), either before or after it starts to run. Otherwise, the operating system may migrate it freely between processors.
+		
 		This class should be compatible with any flavour of Unix that supports POSIX threads. It should also be compatible will any version of Windows that is supported by class Condition (refer to its documentation for more details). It has been tested under Linux, MacOS X, and Windows 2000/XP. 
 		*/
 		class Thread : public Condition {
@@ -56,14 +59,22 @@ namespace PACC {
 			virtual ~Thread(void);
 			
 			void cancel(void);
+			//! Return processors to which this thread is pinned (empty if not pinned).
+			const std::vector<unsigned int>& getAffinity(void) const {return mAffinity;}
 			bool isRunning(void) const;
 			bool isSelf(void) const;
+			static void pause(void);
 			static void sleep(double inSeconds);
 			void run(void);
+			void setAffinity(const std::vector<unsigned int>& inCPUs);
+			void setAffinity(unsigned int inCPU);
 			void wait(bool inLock=true);
 			
+			static bool isAffinitySupported(void);
+			
 			protected:
 			void* mThread; //!< Opaque structure of native thread.
+			std::vector<unsigned int> mAffinity; //!< Processors to which thread is pinned.
 			bool mCancel; //!< Should be canceled flag.
 			bool mRunning; //!< Is running flag
 			
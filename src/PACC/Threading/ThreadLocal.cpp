@@ -0,0 +1,145 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/ThreadLocal.cpp
+ * \brief Class methods for the typed thread local variable.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#include "PACC/Threading/ThreadLocal.hpp"
+#include <cstring>
+
+using namespace std;
+using namespace PACC;
+
+thread_local Threading::ThreadLocalBase::Slot* Threading::ThreadLocalBase::mSlots = 0;
+thread_local size_t Threading::ThreadLocalBase::mSlotCount = 0;
+
+namespace {
+	
+	//! Registry of slot indices and serial numbers.
+	struct Registry {
+		Threading::Mutex mMutex; //!< Mutex that protects the registry.
+		unsigned long long mSerial; //!< Last serial number.
+		size_t mIndexCount; //!< Number of allocated indices.
+		vector<size_t> mFreeIndices; //!< Indices released by deleted instances.
+		
+		Registry(void) : mSerial(0), mIndexCount(0) {}
+	};
+	
+	//! Return the registry (constructed on first use, so that instances can have static storage).
+	Registry& getRegistry(void)
+	{
+		static Registry lRegistry;
+		return lRegistry;
+	}
+	
+	//! Release the slots of a thread at its termination.
+	struct SlotCleanup {
+		bool mActive; //!< Whether the thread has slots.
+		
+		SlotCleanup(void) : mActive(false) {}
+		~SlotCleanup(void) {
+			if(mActive) Threading::ThreadLocalBase::releaseSlots();
+		}
+	};
+	
+	thread_local SlotCleanup gSlotCleanup;
+	
+}
+
+/*! \brief Construct instance with a new serial number and a free slot index.
+*/
+Threading::ThreadLocalBase::ThreadLocalBase(void)
+{
+	Registry& lRegistry = getRegistry();
+	lRegistry.mMutex.lock();
+	mSerial = ++lRegistry.mSerial;
+	if(lRegistry.mFreeIndices.empty()) mIndex = lRegistry.mIndexCount++;
+	else {
+		mIndex = lRegistry.mFreeIndices.back();
+		lRegistry.mFreeIndices.pop_back();
+	}
+	lRegistry.mMutex.unlock();
+}
+
+/*! \brief Release slot index of instance.
+
+The slots of the threads at this index become stale, since no other instance will ever have the same serial number.
+*/
+Threading::ThreadLocalBase::~ThreadLocalBase(void)
+{
+	Registry& lRegistry = getRegistry();
+	lRegistry.mMutex.lock();
+	lRegistry.mFreeIndices.push_back(mIndex);
+	lRegistry.mMutex.unlock();
+}
+
+/*! \brief Set value of the calling thread to \c inValue.
+
+The slots of the calling thread are grown if needed, and released at its termination.
+*/
+void Threading::ThreadLocalBase::bind(void* inValue)
+{
+	if(mIndex >= mSlotCount) {
+		size_t lCount = mSlotCount == 0 ? 8 : mSlotCount;
+		while(lCount <= mIndex) lCount *= 2;
+		Slot* lSlots = new Slot[lCount];
+		if(mSlotCount > 0) memcpy(lSlots, mSlots, mSlotCount*sizeof(Slot));
+		memset(lSlots+mSlotCount, 0, (lCount-mSlotCount)*sizeof(Slot));
+		delete[] mSlots;
+		mSlots = lSlots;
+		mSlotCount = lCount;
+		gSlotCleanup.mActive = true;
+	}
+	mSlots[mIndex].mSerial = mSerial;
+	mSlots[mIndex].mValue = inValue;
+}
+
+/*! \brief Release the slots of the calling thread.
+
+This method is called automatically at thread termination. The values of the thread, which belong to the instances, are not deleted; a subsequent access by the same thread constructs a new value.
+*/
+void Threading::ThreadLocalBase::releaseSlots(void)
+{
+	delete[] mSlots;
+	mSlots = 0;
+	mSlotCount = 0;
+}
+
+/*! \brief Give instance a new serial number, so that the slots of all threads become stale.
+*/
+void Threading::ThreadLocalBase::renew(void)
+{
+	Registry& lRegistry = getRegistry();
+	lRegistry.mMutex.lock();
+	mSerial = ++lRegistry.mSerial;
+	lRegistry.mMutex.unlock();
+}
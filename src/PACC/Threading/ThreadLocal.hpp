@@ -0,0 +1,205 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/ThreadLocal.hpp
+ * \brief Class definition for the typed thread local variable.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#ifndef PACC_Threading_ThreadLocal_hpp_
+#define PACC_Threading_ThreadLocal_hpp_
+
+#include "PACC/Threading/Mutex.hpp"
+#include <functional>
+#include <vector>
+
+namespace PACC { 
+	
+	namespace Threading {
+		
+		/*! \brief Untyped base of class ThreadLocal.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		Every instance owns an index in a per-thread array of slots, which is held in native (\c thread_local) storage. A slot records the address of the value of the calling thread, along with the serial number of the instance that owns it; indices are recycled when instances are deleted, but serial numbers are unique, so that a stale slot is never mistaken for a valid one. Finding the value of the calling thread therefore costs a bounds check and a comparison, without any library call.
+		*/
+		class ThreadLocalBase {
+			public:
+			static void releaseSlots(void);
+			
+			protected:
+			//! Per-thread slot of an instance.
+			struct Slot {
+				unsigned long long mSerial; //!< Serial number of owner instance.
+				void* mValue; //!< Value of the thread for the owner instance.
+			};
+			
+			ThreadLocalBase(void);
+			~ThreadLocalBase(void);
+			
+			void bind(void* inValue);
+			//! Return value of the calling thread, or null if it has none.
+			void* find(void) const {
+				return mIndex < mSlotCount && mSlots[mIndex].mSerial == mSerial ? mSlots[mIndex].mValue : 0;
+			}
+			void renew(void);
+			
+			unsigned long long mSerial; //!< Unique serial number of instance.
+			size_t mIndex; //!< Index of instance in per-thread slots.
+			
+			static thread_local Slot* mSlots; //!< Slots of the calling thread.
+			static thread_local size_t mSlotCount; //!< Number of slots of the calling thread.
+			
+			private:
+			//! restrict (disable) copy constructor.
+			ThreadLocalBase(const ThreadLocalBase&);
+			//! restrict (disable) assignment operator.
+			void operator=(const ThreadLocalBase&);
+		};
+		
+		/*! \brief Typed thread local variable.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		Contrary to the \c thread_local keyword, which only applies to variables of static storage, this class can be instantiated anywhere (e.g. as a class member). Each thread that accesses the variable (see ThreadLocal::get) gets its own value, which is lazily constructed on first access, either by default construction, by copy of an initial value, or by a factory function (see constructors). Once constructed, accessing the value of the calling thread costs a few loads from native thread local storage, compared with a library call for class TLS, which remains the untyped and portable alternative.
+		
+		The values of all threads can be enumerated (see ThreadLocal::forEach and ThreadLocal::accumulate), for instance to merge per-thread counters or statistics:
+		\code
+Threading::ThreadLocal<unsigned long> lHits(0);
+// in any thread
+++lHits.get();
+// later on, in any thread
+unsigned long lTotal = lHits.accumulate(0UL, [](unsigned long inSum, unsigned long inHits) {return inSum + inHits;});
+		\endcode
+		Values belong to the variable rather than to the threads: they are deleted with the variable (or by ThreadLocal::clear), and therefore survive the termination of their thread, so that they can still be merged. Enumeration is protected by a mutex against the lazy construction of new values, but not against concurrent modifications of existing values by their threads; synchronizing those (e.g. using atomic values, or waiting for the threads) is left to the caller.
+		*/
+		template <class T>
+		class ThreadLocal : protected ThreadLocalBase {
+			public:
+			//! Construct thread local variable with default constructed values.
+			ThreadLocal(void) : mFactory([]() {return new T();}) {}
+			//! Construct thread local variable with values that are copies of \c inValue.
+			explicit ThreadLocal(const T& inValue) : mFactory([inValue]() {return new T(inValue);}) {}
+			//! Construct thread local variable with values returned by function \c inFactory.
+			explicit ThreadLocal(const std::function<T(void)>& inFactory) : mFactory([inFactory]() {return new T(inFactory());}) {}
+			//! Delete thread local variable and the values of all threads.
+			~ThreadLocal(void) {clear();}
+			
+			//! Return reference to value of the calling thread (construct it on first access).
+			T& get(void) {
+				void* lValue = find();
+				return lValue ? *static_cast<T*>(lValue) : create();
+			}
+			//! Return reference to value of the calling thread.
+			T& operator*(void) {return get();}
+			//! Return pointer to value of the calling thread.
+			T* operator->(void) {return &get();}
+			
+			/*! \brief Return \c inInit combined with the value of every thread, using binary function \c inCombine.
+			
+			Values are combined in construction order, as in std::accumulate.
+			*/
+			template <class R, class Combine>
+			R accumulate(R inInit, Combine inCombine) {
+				mMutex.lock();
+				try {
+					for(size_t i = 0; i < mValues.size(); ++i) inInit = inCombine(inInit, *mValues[i]);
+				}
+				catch(...) {
+					mMutex.unlock();
+					throw;
+				}
+				mMutex.unlock();
+				return inInit;
+			}
+			
+			/*! \brief Delete the values of all threads.
+			
+			The next access of any thread constructs a new value. This method must not be called while other threads use their value.
+			*/
+			void clear(void) {
+				mMutex.lock();
+				for(size_t i = 0; i < mValues.size(); ++i) delete mValues[i];
+				mValues.clear();
+				renew();
+				mMutex.unlock();
+			}
+			
+			//! Call function \c inFunction with the value of every thread, in construction order.
+			template <class Function>
+			void forEach(Function inFunction) {
+				mMutex.lock();
+				try {
+					for(size_t i = 0; i < mValues.size(); ++i) inFunction(*mValues[i]);
+				}
+				catch(...) {
+					mMutex.unlock();
+					throw;
+				}
+				mMutex.unlock();
+			}
+			
+			//! Return number of threads that have a value.
+			size_t size(void) const {
+				mMutex.lock();
+				size_t lSize = mValues.size();
+				mMutex.unlock();
+				return lSize;
+			}
+			
+			protected:
+			std::function<T*(void)> mFactory; //!< Function that constructs a new value.
+			std::vector<T*> mValues; //!< Values of all threads.
+			Mutex mMutex; //!< Mutex that protects the list of values.
+			
+			//! Construct value of the calling thread (slow path of ThreadLocal::get).
+			T& create(void) {
+				T* lValue = mFactory();
+				mMutex.lock();
+				try {
+					mValues.push_back(lValue);
+				}
+				catch(...) {
+					mMutex.unlock();
+					delete lValue;
+					throw;
+				}
+				mMutex.unlock();
+				bind(lValue);
+				return *lValue;
+			}
+			
+		};
+		
+	} // end of Threading namespace
+	
+} // end of PACC namespace
+
+#endif // PACC_Threading_ThreadLocal_hpp_
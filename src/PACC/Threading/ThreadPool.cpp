@@ -47,92 +47,771 @@
  */
 
 #include "PACC/Threading/ThreadPool.hpp"
+#include "PACC/Threading/Exception.hpp"
+#include "PACC/Threading/ScheduledExecutor.hpp"
+#include "PACC/XML/Streamer.hpp"
 #include "PACC/config.hpp"
+#include <algorithm>
+#include <cmath>
 
 using namespace std;
 using namespace PACC;
 
-/*! \brief Execute a pending task.
+//! Slave thread of the calling thread (null if the calling thread is not a slave).
+static thread_local Threading::SlaveThread* gCurrentSlave = 0;
 
-When awakened by its parent thread pool, this method removes the next task from the head of the queue and starts executing it immediately. It also broadcasts a signal to all waiting threads for this task, both prior to task execution and after task completion.
+//! State of random victim selection for threads that are not slaves (see ThreadPool::runPending).
+static thread_local unsigned int gHelperSeed = 0x9E3779B9;
+
+//! Return the slave thread of the calling thread, or a null pointer if the calling thread is not a slave of any thread pool.
+Threading::SlaveThread* Threading::SlaveThread::getCurrent(void)
+{
+	return gCurrentSlave;
+}
+
+/*! \brief Execute pending tasks.
+
+When awakened by its parent thread pool, this method removes the next task from the head of the queue and starts executing it immediately. Once the task is completed, the threads waiting for it (if any) are awakened. In work-stealing mode, the next task is taken from the local deque of this slave first, then from the head of the queue, and finally from the top of the deque of another slave. When no task can be found, the slave parks on the event count of the pool.
+
+The slave terminates once its pool is being deleted and no more pending task can be found. It also terminates when it retires from an elastic pool: either the pool is shrinking (see ThreadPool::resize), or the slave has stayed idle for longer than the idle time out while the pool holds more than its minimum number of slaves.
 */
 void Threading::SlaveThread::main(void) 
 {
-	while(!mCancel)
+	gCurrentSlave = this;
+	mStarted = mPool->mTimer.getValue();
+	for(;;)
 	{
-		// wait for available task
-		mPool->lock();
-		while(mPool->mTasks.empty() && !mCancel) mPool->wait();
-		if(!mCancel)
-		{
-			// dequeu next task
-			Task* lTask = mPool->mTasks.front();
-			mPool->mTasks.pop();
-			mPool->unlock();
-			// signal all that task is running
-			lTask->lock();
-			lTask->mRunning = true;
-			lTask->broadcast();
-			lTask->unlock();
-			// run task
-			lTask->main();
-			// signal all that task is completed
-			lTask->lock();
-			lTask->mRunning = false;
-			lTask->mCompleted = true;
-			lTask->broadcast();
-			lTask->unlock();
+		Task* lTask = mPool->popTask(this);
+		if(lTask) {
+			if(mPool->mMetrics.load(memory_order_relaxed)) mPool->runMeasured(lTask);
+			else ThreadPool::runTask(lTask);
+			continue;
+		}
+		// no task found, register as waiter and check again
+		unsigned int lKey = mPool->mIdle.prepareWait();
+		if(mPool->hasWork()) {
+			mPool->mIdle.cancelWait();
+			continue;
+		}
+		if(mPool->mShutdown.load()) {
+			mPool->mIdle.cancelWait();
+			break;
 		}
-		else mPool->unlock();
+		if(mPool->mRetiring.load() > 0) {
+			// pool is shrinking
+			mPool->mIdle.cancelWait();
+			if(mPool->retire(this, false)) break;
+			continue;
+		}
+		// slaves above the minimum of an elastic pool wait with a time out
+		double lTimeout = 0;
+		if(mPool->isElastic() && mPool->mSlaveCount.load() > mPool->mMinSlaves.load()) lTimeout = mPool->mIdleTimeout.load();
+		if(!mPool->mIdle.wait(lKey, lTimeout) && mPool->retire(this, true)) break;
 	}
+	if(mPool->mMetrics.load(memory_order_relaxed)) mPool->getThreadMetrics().mStop.store(mPool->mTimer.getValue(), memory_order_relaxed);
+	gCurrentSlave = 0;
 }
 
-//! Construct thread pool by allocating \c inSlaves threads.
-Threading::ThreadPool::ThreadPool(unsigned int inSlaves)
+/*! \brief Construct thread pool by allocating \c inSlaves threads.
+
+Argument \c inScheduling selects the scheduling mode of the pool (see class ThreadPool). If argument \c inAffinity is not empty, all slave threads are pinned to this set of processors (see Thread::setAffinity); for instance, a pool can be confined to the processors of a NUMA node (see class PartitionedThreadPool).
+
+The number of slaves of this pool is fixed, but it can be changed later with method ThreadPool::resize.
+*/
+Threading::ThreadPool::ThreadPool(unsigned int inSlaves, Scheduling inScheduling, const vector<unsigned int>& inAffinity) : ThreadPool(inSlaves, inSlaves, inScheduling, inAffinity) {}
+
+/*! \brief Construct elastic thread pool of \c inMinSlaves to \c inMaxSlaves threads.
+
+The pool starts with \c inMinSlaves threads, and allocates more threads (up to \c inMaxSlaves) when tasks wait too long, while threads above the minimum retire after staying idle (see class ThreadPool). A minimum of 0 is valid: the first pushed task then allocates the first slave. Arguments \c inScheduling and \c inAffinity are described in constructor ThreadPool(unsigned int, Scheduling, const vector<unsigned int>&). In work-stealing mode, one deque is allocated for each of the \c inMaxSlaves potential slaves.
+
+Throws a Threading::Exception if \c inMinSlaves is larger than \c inMaxSlaves.
+*/
+Threading::ThreadPool::ThreadPool(unsigned int inMinSlaves, unsigned int inMaxSlaves, Scheduling inScheduling, const vector<unsigned int>& inAffinity) : mRing(4096), mScheduling(inScheduling), mQueued(0), mShutdown(false), mSequence(0), mAging(0.01), mMeasuring(false), mAffinity(inAffinity), mMinSlaves(inMinSlaves), mMaxSlaves(inMaxSlaves), mSlaveCount(0), mRetiring(0), mLatency(0.01), mIdleTimeout(10), mLastActivity(0), mLastGrowth(0), mMetrics(false), mMetricsStart(0), mDepth(0), mMaxDepth(0), mSampling(1)
 {
-	// allocate slave threads
-	for(unsigned int i = 0; i < inSlaves; ++i) 
-	{
-		SlaveThread* lThread = new SlaveThread(this);
-		push_back(lThread);
+	if(inMinSlaves > inMaxSlaves) throw Exception(eOtherError, "ThreadPool::ThreadPool() minimum number of slaves is larger than maximum");
+	setName("ThreadPool");
+	// allocate deques before any slave starts to steal
+	if(mScheduling == eWorkStealing) {
+		for(unsigned int i = 0; i < inMaxSlaves; ++i) mDeques.push_back(new WorkDeque);
 	}
+	// allocate slave threads
+	lock();
+	for(unsigned int i = 0; i < inMinSlaves; ++i) spawn();
+	unlock();
 }
 
-//! Delete thread pool.
+/*! \brief Delete thread pool.
+
+This method waits for all pending tasks to be started, and then for the slave threads to terminate. If all slaves of an elastic pool have retired, a slave is allocated to execute the pending tasks.
+*/
 Threading::ThreadPool::~ThreadPool(void)
 {
+	// no slave can retire or be allocated once the shutdown flag is set
 	lock();
-	// wait for queue to become empty
-	while(!mTasks.empty()) 
-	{
-		// wait for last task in queue to at least start running
-		Task* lTask = mTasks.back();
-		lTask->lock();
-		unlock();
-		lTask->wait(false);
-		lTask->unlock();
-		lock();
-	}
-	// now cancel all threads
+	mShutdown.store(true);
+	if(size() == 0 && mMaxSlaves.load() > 0 && hasWork()) spawn();
+	unlock();
+	// cancel all threads; they will terminate once there are no more pending tasks
 	for(unsigned int i = 0; i < size(); ++i) (*this)[i]->cancel();
 	// signal them to wake up
-	broadcast();
-	unlock();
+	mIdle.notifyAll();
 	// then delete them (the thread destructor will wait for thread completion)
 	for(unsigned int i = 0; i < size(); ++i) delete (*this)[i];
+	for(unsigned int i = 0; i < mRetired.size(); ++i) delete mRetired[i];
+	for(unsigned int i = 0; i < mDeques.size(); ++i) delete mDeques[i];
+}
+
+/*! \brief Count tasks of array [\c inFirst, \c inLast), which are about to be pushed by the calling thread, as pending (metrics must be enabled).
+
+Every task is flagged as counted, and one task out of every sampling period is also flagged as timed; its push time is recorded, unless it is already (\c inStamped=true).
+*/
+void Threading::ThreadPool::countSubmitted(Task** inFirst, Task** inLast, bool inStamped)
+{
+	ThreadMetrics& lMetrics = getThreadMetrics();
+	long lCount = inLast - inFirst;
+	lMetrics.mSubmitted.store(lMetrics.mSubmitted.load(memory_order_relaxed)+lCount, memory_order_relaxed);
+	unsigned int lSampling = mSampling.load(memory_order_relaxed);
+	double lNow = -1;
+	for(Task** lTask = inFirst; lTask != inLast; ++lTask) {
+		unsigned int lFlags = Task::eCounted;
+		if(++lMetrics.mSkipped >= lSampling) {
+			lMetrics.mSkipped = 0;
+			lFlags |= Task::eTimed;
+			if(!inStamped) {
+				if(lNow < 0) lNow = mTimer.getValue();
+				(*lTask)->mEnqueued = lNow;
+			}
+		}
+		(*lTask)->mState.fetch_or(lFlags, memory_order_relaxed);
+	}
+	long lDepth = mDepth.fetch_add(lCount, memory_order_relaxed) + lCount;
+	long lMax = mMaxDepth.load(memory_order_relaxed);
+	while(lDepth > lMax && !mMaxDepth.compare_exchange_weak(lMax, lDepth, memory_order_relaxed));
+}
+
+/*! \brief Write a snapshot of the metrics of this pool into stream \c outStream every \c inPeriod seconds, using scheduler \c ioScheduler.
+\return Handle of the periodic task (see ScheduledExecutor::cancel).
+
+Snapshots are written as text, or as XML elements if argument \c inXML is true (see ThreadPool::Metrics::write). The stream must outlive the periodic task, and should not be written by other threads in the meantime. Metrics must be enabled separately (see ThreadPool::setMetrics).
+*/
+unsigned long Threading::ThreadPool::exportMetrics(ScheduledExecutor& ioScheduler, ostream& outStream, double inPeriod, bool inXML)
+{
+	ostream* lStream = &outStream;
+	return ioScheduler.scheduleAtFixedRate([this, lStream, inXML]() {
+		Metrics lMetrics = getMetrics();
+		if(inXML) {
+			XML::Streamer lStreamer(*lStream);
+			lMetrics.write(lStreamer);
+			*lStream << endl;
+		}
+		else lMetrics.write(*lStream);
+		lStream->flush();
+	}, inPeriod, inPeriod);
+}
+
+/*! \brief Return a snapshot of the metrics of this pool (see ThreadPool::setMetrics).
+
+The counters of every thread are read while they are being updated, so the snapshot is only approximately consistent (e.g. a task can be counted as completed before it is counted as submitted). Workers are listed by increasing slave index, followed by the helping threads; slaves that terminated before metrics were reset are omitted.
+*/
+Threading::ThreadPool::Metrics Threading::ThreadPool::getMetrics(void) const
+{
+	Metrics lMetrics;
+	double lNow = mTimer.getValue();
+	double lStart = mMetricsStart.load();
+	lMetrics.mElapsed = lNow - lStart;
+	lMetrics.mSubmitted = 0;
+	lMetrics.mCompleted = 0;
+	lMetrics.mQueueDepth = max(mDepth.load(), 0L);
+	lMetrics.mMaxQueueDepth = max(mMaxDepth.load(), lMetrics.mQueueDepth);
+	mThreadMetrics.forEach([&](const ThreadMetrics& inThread) {
+		int lIndex = inThread.mIndex.load(memory_order_acquire);
+		if(lIndex == -2) return;
+		lMetrics.mSubmitted += inThread.mSubmitted.load(memory_order_relaxed);
+		inThread.mWait.addTo(lMetrics.mWait);
+		inThread.mRun.addTo(lMetrics.mRun);
+		Metrics::Worker lWorker;
+		lWorker.mIndex = lIndex;
+		lWorker.mCompleted = inThread.mCompleted.load(memory_order_relaxed);
+		// extrapolate busy time from the timed tasks
+		unsigned long lTimed = inThread.mRun.mCount.load(memory_order_relaxed);
+		lWorker.mBusyTime = lTimed > 0 ? inThread.mBusy.load(memory_order_relaxed) * lWorker.mCompleted / lTimed : 0;
+		lWorker.mIdleTime = 0;
+		lMetrics.mCompleted += lWorker.mCompleted;
+		double lStop = inThread.mStop.load(memory_order_relaxed);
+		lWorker.mRunning = (lStop == 0);
+		if(lIndex < 0) {
+			// helping (or pushing only) thread
+			if(lWorker.mCompleted == 0) return;
+		}
+		else {
+			if(!lWorker.mRunning && lStop < lStart) return;
+			double lLifetime = (lWorker.mRunning ? lNow : lStop) - max(inThread.mStart.load(memory_order_relaxed), lStart);
+			lWorker.mIdleTime = max(lLifetime - lWorker.mBusyTime, 0.);
+		}
+		lMetrics.mWorkers.push_back(lWorker);
+	});
+	stable_sort(lMetrics.mWorkers.begin(), lMetrics.mWorkers.end(), [](const Metrics::Worker& inLeft, const Metrics::Worker& inRight) {
+		if((inLeft.mIndex < 0) != (inRight.mIndex < 0)) return inRight.mIndex < 0;
+		return inLeft.mIndex < inRight.mIndex;
+	});
+	return lMetrics;
+}
+
+//! Return metrics of the calling thread, initialized on first access.
+Threading::ThreadPool::ThreadMetrics& Threading::ThreadPool::getThreadMetrics(void)
+{
+	ThreadMetrics& lMetrics = mThreadMetrics.get();
+	if(lMetrics.mIndex.load(memory_order_relaxed) == -2) {
+		SlaveThread* lSlave = gCurrentSlave;
+		bool lOwn = lSlave && lSlave->mPool == this;
+		double lStart = mMetricsStart.load();
+		if(lOwn && lSlave->mStarted > lStart) lStart = lSlave->mStarted;
+		lMetrics.mStart.store(lStart, memory_order_relaxed);
+		lMetrics.mIndex.store(lOwn ? (int) lSlave->mIndex : -1, memory_order_release);
+	}
+	return lMetrics;
+}
+
+/*! \brief Allocate a new slave if the elastic pool is allowed to grow at time \c inNow.
+
+At most one slave is allocated per growth latency period, unless the pool has no slave at all. Failure to allocate a thread is not reported: the pool simply keeps running with its current slaves.
+*/
+void Threading::ThreadPool::grow(double inNow)
+{
+	if(mSlaveCount.load() > 0 && inNow - mLastGrowth.load(memory_order_relaxed) < mLatency.load(memory_order_relaxed)) return;
+	lock();
+	if(!mShutdown.load() && mSlaveCount.load() < mMaxSlaves.load() && (mSlaveCount.load() == 0 || inNow - mLastGrowth.load() >= mLatency.load())) {
+		mLastGrowth.store(inNow);
+		try {spawn();}
+		catch(Exception&) {}
+	}
+	unlock();
+}
+
+//! Return whether some task is (momentarily) pending in the queues or in any deque.
+bool Threading::ThreadPool::hasWork(void) const
+{
+	if(!mRing.empty() || mQueued.load() > 0) return true;
+	for(unsigned int i = 0; i < mDeques.size(); ++i) {
+		if(!mDeques[i]->empty()) return true;
+	}
+	return false;
+}
+
+/*! \brief Remove the next task to execute by slave \c inSlave, and record its wait time if wait statistics are enabled.
+\return Pointer to task, or null pointer if no pending task was found.
+*/
+Threading::Task* Threading::ThreadPool::popTask(SlaveThread* inSlave)
+{
+	Task* lTask = takeTask(inSlave);
+	if(lTask && mMeasuring.load(memory_order_relaxed)) recordWait(lTask);
+	if(lTask && isElastic()) {
+		// grow the pool if this task has waited too long, and others are still pending
+		double lNow = mTimer.getValue();
+		mLastActivity.store(lNow, memory_order_relaxed);
+		if(lNow - lTask->mEnqueued > mLatency.load(memory_order_relaxed) && hasWork()) grow(lNow);
+	}
+	return lTask;
+}
+
+/*! \brief Remove the next task to execute by slave \c inSlave.
+\return Pointer to task, or null pointer if no pending task was found.
+
+This method does not block; in work-stealing mode, it tries the local deque of the slave, the FIFO queue, and then the deques of the other slaves, starting from a random victim. The overflow queue (or the priority queue, in priority and deadline modes) is only locked when it is not empty. If \c inSlave is null (i.e. the calling thread is not a slave of this pool), there is no local deque to try.
+*/
+Threading::Task* Threading::ThreadPool::takeTask(SlaveThread* inSlave)
+{
+	Task* lTask = 0;
+	if(!mDeques.empty() && inSlave && (lTask = mDeques[inSlave->mIndex]->take()) != 0) return lTask;
+	if(mRing.pop(lTask)) return lTask;
+	if(mQueued.load(memory_order_relaxed) > 0) {
+		lock();
+		if(!mHeap.empty()) {
+			pop_heap(mHeap.begin(), mHeap.end(), isAfter);
+			lTask = mHeap.back();
+			mHeap.pop_back();
+			mQueued.fetch_sub(1);
+		}
+		else if(!mTasks.empty()) {
+			lTask = mTasks.front();
+			mTasks.pop();
+			mQueued.fetch_sub(1);
+		}
+		unlock();
+		if(lTask) return lTask;
+	}
+	if(mDeques.size() > (inSlave ? 1 : 0)) {
+		// xorshift for victim selection
+		unsigned int& lSeed = inSlave ? inSlave->mSeed : gHelperSeed;
+		lSeed ^= lSeed << 13;
+		lSeed ^= lSeed >> 17;
+		lSeed ^= lSeed << 5;
+		unsigned int lVictim = lSeed % mDeques.size();
+		for(unsigned int i = 0; i < mDeques.size(); ++i, lVictim = (lVictim+1) % mDeques.size()) {
+			if(inSlave && lVictim == inSlave->mIndex) continue;
+			if((lTask = mDeques[lVictim]->steal()) != 0) return lTask;
+		}
+	}
+	return 0;
+}
+
+/*! \brief Execute one pending task in the calling thread.
+\return True if a task was executed, false if no pending task was found.
+
+This method lets any thread help the slaves of this pool. If the calling thread is a slave of this pool, its local deque is tried first (in work-stealing mode). It does not block.
+*/
+bool Threading::ThreadPool::runPending(void)
+{
+	SlaveThread* lSlave = gCurrentSlave;
+	Task* lTask = popTask(lSlave && lSlave->mPool == this ? lSlave : 0);
+	if(!lTask) return false;
+	if(mMetrics.load(memory_order_relaxed)) runMeasured(lTask);
+	else runTask(lTask);
+	return true;
+}
+
+/*! \brief Execute task \c inTask in the calling thread, and record it in the metrics of the thread.
+
+The wait and run times of the task are only measured if it was flagged as timed when pushed (see ThreadPool::countSubmitted). Tasks pushed before metrics were enabled are not counted as pending.
+*/
+void Threading::ThreadPool::runMeasured(Task* inTask)
+{
+	ThreadMetrics& lMetrics = getThreadMetrics();
+	unsigned int lState = inTask->mState.load(memory_order_relaxed);
+	if(lState & Task::eCounted) mDepth.fetch_sub(1, memory_order_relaxed);
+	if(lState & Task::eTimed) {
+		double lStart = mTimer.getValue();
+		lMetrics.mWait.add(lStart - inTask->mEnqueued);
+		runTask(inTask);
+		double lRun = mTimer.getValue() - lStart;
+		lMetrics.mRun.add(lRun);
+		lMetrics.mBusy.store(lMetrics.mBusy.load(memory_order_relaxed)+lRun, memory_order_relaxed);
+	}
+	else runTask(inTask);
+	lMetrics.mCompleted.store(lMetrics.mCompleted.load(memory_order_relaxed)+1, memory_order_relaxed);
+}
+
+//! Execute task \c inTask in the calling thread, waking up threads waiting for its completion.
+void Threading::ThreadPool::runTask(Task* inTask)
+{
+	// mark task as running, run (or skip) it, and wake up threads waiting for its completion
+	inTask->run();
+}
+
+/*! \brief Wait for completion of task \c inTask, while executing pending tasks.
+
+Instead of blocking right away, the calling thread executes the pending tasks of this pool (see ThreadPool::runPending) until task \c inTask is completed. It only blocks (using Task::wait) when no pending task can be found. This method should be used by tasks that wait for tasks that they have pushed themselves (e.g. recursive divide and conquer): the waiting slave then keeps working, which prevents the pool from running out of slaves, and in work-stealing mode it usually runs its own subtasks first.
+*/
+void Threading::ThreadPool::waitHelping(const Task& inTask)
+{
+	while(!inTask.isCompleted()) {
+		if(!runPending()) {
+			inTask.wait();
+			break;
+		}
+	}
 }
 
 /*! \brief Push task \c inTask onto the thread pool queue.
 
-The thread pool maintains a queue of task references that will be executed in FIFO order.
+The thread pool maintains a queue of task references that will be executed in FIFO order. In work-stealing mode, a task pushed by a slave of this pool is instead pushed onto the local deque of this slave (see class ThreadPool).
+
+The task is appended to the lock-free ring, unless the ring is full or the overflow queue is not empty (in which case it is appended to the overflow queue, so that FIFO order is preserved). A sleeping slave is then awakened, if any.
 */
 void Threading::ThreadPool::push(Task& inTask)
 {
 	// reset task flags
 	inTask.reset();
-	// push task onto queue and signal availability
+	schedule(&inTask);
+}
+
+/*! \brief Push tasks of array [\c inFirst, \c inLast) onto the thread pool queue.
+
+This method is equivalent to pushing every task in order with method ThreadPool::push, but much cheaper for large batches: the whole batch is reserved in the lock-free ring at once (or, if the ring does not have room for it, appended to the overflow queue under a single lock), and at most one sleeping slave per task is awakened with a single system call. In work-stealing mode, a batch pushed by a slave of this pool goes onto its local deque, where other slaves can steal from.
+*/
+void Threading::ThreadPool::pushBatch(Task** inFirst, Task** inLast)
+{
+	if(inFirst == inLast) return;
+	for(Task** lTask = inFirst; lTask != inLast; ++lTask) (*lTask)->reset();
+	size_t lCount = inLast - inFirst;
+	bool lStamped = mMeasuring.load(memory_order_relaxed) || isElastic();
+	if(lStamped) {
+		double lNow = mTimer.getValue();
+		for(Task** lTask = inFirst; lTask != inLast; ++lTask) (*lTask)->mEnqueued = lNow;
+	}
+	if(mMetrics.load(memory_order_relaxed)) countSubmitted(inFirst, inLast, lStamped);
+	SlaveThread* lSlave = gCurrentSlave;
+	if(mScheduling == ePriority || mScheduling == eDeadline) {
+		// insert into priority queue
+		lock();
+		for(Task** lTask = inFirst; lTask != inLast; ++lTask) pushHeap(*lTask);
+		unlock();
+	}
+	else if(!mDeques.empty() && lSlave && lSlave->mPool == this) {
+		// push onto local deque
+		for(Task** lTask = inFirst; lTask != inLast; ++lTask) mDeques[lSlave->mIndex]->push(*lTask);
+	}
+	else if(mQueued.load() > 0 || !mRing.push(inFirst, lCount)) {
+		// ring is full, use overflow queue
+		lock();
+		for(Task** lTask = inFirst; lTask != inLast; ++lTask) mTasks.push(*lTask);
+		mQueued.fetch_add(lCount);
+		unlock();
+	}
+	// wake up as many sleeping slaves as needed
+	unsigned int lSlaves = mMaxSlaves.load();
+	mIdle.notify(lCount < lSlaves ? lCount : lSlaves);
+	// allocate a slave if none is idle and tasks are late
+	if(isElastic() && mIdle.getWaiters() == 0) {
+		double lNow = mTimer.getValue();
+		if(mSlaveCount.load() == 0 || lNow - mLastActivity.load(memory_order_relaxed) > mLatency.load(memory_order_relaxed)) grow(lNow);
+	}
+}
+
+/*! \brief Push dynamically allocated task \c inTask onto the thread pool queue.
+
+The thread pool takes ownership of the task, and deletes it once it has run. The task must have been allocated with operator new, and should not be accessed by the caller after this call; in particular, it cannot be waited for (use ThreadPool::submit for tasks that return results). Otherwise, the task is scheduled as for method ThreadPool::push.
+*/
+void Threading::ThreadPool::pushDetached(Task* inTask)
+{
+	inTask->setDetached();
+	schedule(inTask);
+}
+
+//! Append task \c inTask to the proper queue, and wake up a sleeping slave if any.
+void Threading::ThreadPool::schedule(Task* inTask)
+{
+	bool lStamped = mMeasuring.load(memory_order_relaxed) || isElastic();
+	if(lStamped) inTask->mEnqueued = mTimer.getValue();
+	if(mMetrics.load(memory_order_relaxed)) countSubmitted(&inTask, &inTask+1, lStamped);
+	SlaveThread* lSlave = gCurrentSlave;
+	if(mScheduling == ePriority || mScheduling == eDeadline) {
+		// insert into priority queue
+		lock();
+		pushHeap(inTask);
+		unlock();
+	}
+	else if(!mDeques.empty() && lSlave && lSlave->mPool == this) {
+		// push onto local deque
+		mDeques[lSlave->mIndex]->push(inTask);
+	}
+	else if(mQueued.load() > 0 || !mRing.push(inTask)) {
+		// ring is full, use overflow queue
+		lock();
+		mTasks.push(inTask);
+		mQueued.fetch_add(1);
+		unlock();
+	}
+	// wake up a sleeping slave if any
+	mIdle.notifyOne();
+	// allocate a slave if none is idle and tasks are late
+	if(isElastic() && mIdle.getWaiters() == 0) {
+		double lNow = mTimer.getValue();
+		if(mSlaveCount.load() == 0 || lNow - mLastActivity.load(memory_order_relaxed) > mLatency.load(memory_order_relaxed)) grow(lNow);
+	}
+}
+
+//! Return a copy of the wait statistics of this pool, indexed by task priority.
+map<int, Threading::ThreadPool::WaitStatistics> Threading::ThreadPool::getWaitStatistics(void) const
+{
+	mStatisticsMutex.lock();
+	map<int, WaitStatistics> lStatistics = mStatistics;
+	mStatisticsMutex.unlock();
+	return lStatistics;
+}
+
+/*! \brief Insert task \c inTask into the priority queue.
+
+The pool mutex must be locked. The scheduling key of the task is its deadline (time of push plus relative deadline) in deadline mode, and its time of push minus its priority times the aging period in priority mode (or minus its priority if aging is disabled); ties are broken in FIFO order.
+*/
+void Threading::ThreadPool::pushHeap(Task* inTask)
+{
+	if(!mMeasuring.load(memory_order_relaxed)) inTask->mEnqueued = mTimer.getValue();
+	inTask->mSequence = mSequence++;
+	if(mScheduling == eDeadline) inTask->mKey = inTask->mDeadline > 0 ? inTask->mEnqueued + inTask->mDeadline : HUGE_VAL;
+	else if(mAging > 0) inTask->mKey = inTask->mEnqueued - inTask->mPriority * mAging;
+	else inTask->mKey = -inTask->mPriority;
+	mHeap.push_back(inTask);
+	push_heap(mHeap.begin(), mHeap.end(), isAfter);
+	mQueued.fetch_add(1);
+}
+
+//! Add wait time of task \c inTask (which is about to start) to the statistics of its priority.
+void Threading::ThreadPool::recordWait(const Task* inTask)
+{
+	double lWait = mTimer.getValue() - inTask->mEnqueued;
+	bool lLate = inTask->mDeadline > 0 && lWait > inTask->mDeadline;
+	mStatisticsMutex.lock();
+	mStatistics[inTask->mPriority].add(lWait, lLate);
+	mStatisticsMutex.unlock();
+}
+
+/*! \brief Remove slave \c inSlave from the pool, if it is allowed to retire.
+\return True if the slave has retired (and should terminate), false otherwise.
+
+A slave may retire if the pool is shrinking (see ThreadPool::resize), or if its idle wait has timed out (\c inTimedOut=true) while the pool holds more than its minimum number of slaves. In both cases, it does not retire if some task is pending. The retired slave is deleted later by the pool, since a thread cannot delete itself.
+*/
+bool Threading::ThreadPool::retire(SlaveThread* inSlave, bool inTimedOut)
+{
 	lock();
-	mTasks.push(&inTask);
-	signal();
+	bool lRequested = mRetiring.load() > 0;
+	if(mShutdown.load() || (!lRequested && !(inTimedOut && mSlaveCount.load() > mMinSlaves.load()))) {
+		unlock();
+		return false;
+	}
+	// leave the pool first, then check for work; a pusher that does not see this slave anymore allocates a new one
+	mSlaveCount.fetch_sub(1);
+	atomic_thread_fence(memory_order_seq_cst);
+	if(hasWork()) {
+		mSlaveCount.fetch_add(1);
+		unlock();
+		return false;
+	}
+	if(lRequested) mRetiring.fetch_sub(1);
+	erase(find(begin(), end(), inSlave));
+	mRetired.push_back(inSlave);
 	unlock();
+	return true;
+}
+
+/*! \brief Set number of slaves to \c inSlaves.
+
+The pool becomes a fixed size pool of \c inSlaves slaves (see ThreadPool::resize(unsigned int, unsigned int)).
+*/
+void Threading::ThreadPool::resize(unsigned int inSlaves)
+{
+	resize(inSlaves, inSlaves);
+}
+
+/*! \brief Set minimum and maximum number of slaves to \c inMinSlaves and \c inMaxSlaves.
+
+Missing slaves are allocated immediately, so that the pool holds at least \c inMinSlaves slaves when this method returns. Extra slaves (above \c inMaxSlaves) retire as soon as they are idle, once all pending tasks have been started; this method does not wait for them. If both bounds are equal, the pool has a fixed size. Otherwise, it is elastic (see class ThreadPool).
+
+Throws a Threading::Exception if \c inMinSlaves is larger than \c inMaxSlaves, or, in work-stealing mode, if \c inMaxSlaves is larger than the maximum number of slaves given at construction (deques are only allocated at construction).
+*/
+void Threading::ThreadPool::resize(unsigned int inMinSlaves, unsigned int inMaxSlaves)
+{
+	if(inMinSlaves > inMaxSlaves) throw Exception(eOtherError, "ThreadPool::resize() minimum number of slaves is larger than maximum");
+	if(mScheduling == eWorkStealing && inMaxSlaves > mDeques.size()) throw Exception(eOtherError, "ThreadPool::resize() maximum number of slaves exceeds the number of deques");
+	lock();
+	mMinSlaves.store(inMinSlaves);
+	mMaxSlaves.store(inMaxSlaves);
+	unsigned int lCount = mSlaveCount.load() - mRetiring.load();
+	if(lCount < inMinSlaves) {
+		// cancel pending retirements, then allocate the missing slaves
+		unsigned int lCancel = inMinSlaves - lCount < mRetiring.load() ? inMinSlaves - lCount : mRetiring.load();
+		mRetiring.fetch_sub(lCancel);
+		try {
+			for(lCount += lCancel; lCount < inMinSlaves; ++lCount) spawn();
+		}
+		catch(...) {
+			unlock();
+			throw;
+		}
+	}
+	else if(lCount > inMaxSlaves) mRetiring.fetch_add(lCount - inMaxSlaves);
+	unlock();
+	// wake up idle slaves, so that they retire or update their time out
+	mIdle.notifyAll();
+}
+
+/*! \brief Allocate a new slave thread.
+
+The pool mutex must be locked. Retired slaves are deleted first, and the new slave gets the lowest index that is not used by another slave (i.e. it may inherit the deque of a retired slave, which is always empty).
+*/
+void Threading::ThreadPool::spawn(void)
+{
+	for(unsigned int i = 0; i < mRetired.size(); ++i) delete mRetired[i];
+	mRetired.clear();
+	vector<bool> lUsed(size()+1, false);
+	for(unsigned int i = 0; i < size(); ++i) {
+		if((*this)[i]->mIndex < lUsed.size()) lUsed[(*this)[i]->mIndex] = true;
+	}
+	unsigned int lIndex = find(lUsed.begin(), lUsed.end(), false) - lUsed.begin();
+	SlaveThread* lThread = new SlaveThread(this, lIndex, mAffinity);
+	push_back(lThread);
+	mSlaveCount.fetch_add(1);
+}
+
+/*! \brief Reset the metrics of this pool.
+
+All counters and histograms are cleared, and busy and idle times restart from now; the current number of pending tasks becomes the peak. Threads that update their counters at the same time may lose their update.
+*/
+void Threading::ThreadPool::resetMetrics(void)
+{
+	double lNow = mTimer.getValue();
+	mMetricsStart.store(lNow);
+	mMaxDepth.store(max(mDepth.load(), 0L));
+	mThreadMetrics.forEach([lNow](ThreadMetrics& ioThread) {ioThread.reset(lNow);});
+}
+
+/*! \brief Enable (\c inEnable=true) or disable pool metrics (see class ThreadPool), timing one task out of every \c inSampling tasks pushed by each thread.
+
+Enabling metrics resets them (see ThreadPool::resetMetrics). Metrics are disabled by default. While enabled, every task is counted, but only the sampled tasks are timed (all of them, by default); the busy times of the workers are extrapolated from the timed tasks. A sampling period of 0 is treated as 1.
+*/
+void Threading::ThreadPool::setMetrics(bool inEnable, unsigned int inSampling)
+{
+	mSampling.store(inSampling > 0 ? inSampling : 1);
+	if(inEnable && !mMetrics.load()) {
+		mDepth.store(0);
+		resetMetrics();
+	}
+	mMetrics.store(inEnable);
+}
+
+//! Clear wait statistics.
+void Threading::ThreadPool::resetWaitStatistics(void)
+{
+	mStatisticsMutex.lock();
+	mStatistics.clear();
+	mStatisticsMutex.unlock();
+}
+
+/*! \brief Enable (\c inEnable=true) or disable wait statistics.
+
+When enabled, every pushed task is time stamped, and the time it spends in the queues is added to the statistics of its priority when a slave removes it (see ThreadPool::getWaitStatistics). Statistics are disabled by default, since they add a mutex to every task. Tasks pushed before statistics are enabled may report invalid wait times.
+*/
+void Threading::ThreadPool::setWaitStatistics(bool inEnable)
+{
+	mMeasuring.store(inEnable);
+}
+
+//! Add time \c inTime (in seconds) to histogram (calling thread must be its only writer).
+void Threading::ThreadPool::TimeHistogram::add(double inTime)
+{
+	if(inTime < 0) inTime = 0;
+	mCount.store(mCount.load(memory_order_relaxed)+1, memory_order_relaxed);
+	mTotal.store(mTotal.load(memory_order_relaxed)+inTime, memory_order_relaxed);
+	if(inTime > mMaximum.load(memory_order_relaxed)) mMaximum.store(inTime, memory_order_relaxed);
+	atomic<unsigned long>& lBucket = mHistogram[WaitStatistics::getBucket(inTime)];
+	lBucket.store(lBucket.load(memory_order_relaxed)+1, memory_order_relaxed);
+}
+
+//! Add content of histogram to statistics \c ioStatistics.
+void Threading::ThreadPool::TimeHistogram::addTo(WaitStatistics& ioStatistics) const
+{
+	ioStatistics.mCount += mCount.load(memory_order_relaxed);
+	ioStatistics.mTotal += mTotal.load(memory_order_relaxed);
+	ioStatistics.mMaximum = max(ioStatistics.mMaximum, mMaximum.load(memory_order_relaxed));
+	for(unsigned int i = 0; i < WaitStatistics::eBuckets; ++i) ioStatistics.mHistogram[i] += mHistogram[i].load(memory_order_relaxed);
+}
+
+//! Clear histogram.
+void Threading::ThreadPool::TimeHistogram::reset(void)
+{
+	mCount.store(0, memory_order_relaxed);
+	mTotal.store(0, memory_order_relaxed);
+	mMaximum.store(0, memory_order_relaxed);
+	for(unsigned int i = 0; i < WaitStatistics::eBuckets; ++i) mHistogram[i].store(0, memory_order_relaxed);
+}
+
+//! Clear counters, and restart busy and idle times at time \c inNow.
+void Threading::ThreadPool::ThreadMetrics::reset(double inNow)
+{
+	mStart.store(inNow, memory_order_relaxed);
+	mSubmitted.store(0, memory_order_relaxed);
+	mCompleted.store(0, memory_order_relaxed);
+	mBusy.store(0, memory_order_relaxed);
+	mWait.reset();
+	mRun.reset();
+}
+
+//! Return fraction of the lifetime of the slaves spent executing tasks (busy time over busy plus idle time).
+double Threading::ThreadPool::Metrics::getUtilization(void) const
+{
+	double lBusy = 0, lTotal = 0;
+	for(size_t i = 0; i < mWorkers.size(); ++i) {
+		if(mWorkers[i].mIndex < 0) continue;
+		lBusy += mWorkers[i].mBusyTime;
+		lTotal += mWorkers[i].mBusyTime + mWorkers[i].mIdleTime;
+	}
+	return lTotal > 0 ? lBusy / lTotal : 0;
+}
+
+//! Write metrics as text into stream \c outStream (one line for the pool, one per time histogram, and one per worker).
+void Threading::ThreadPool::Metrics::write(ostream& outStream) const
+{
+	outStream << "pool: submitted " << mSubmitted << ", completed " << mCompleted << ", pending " << mQueueDepth << " (peak " << mMaxQueueDepth << "), elapsed " << mElapsed << " s, utilization " << 100*getUtilization() << "%" << endl;
+	const WaitStatistics* lStatistics[2] = {&mWait, &mRun};
+	const char* lNames[2] = {"wait", "run"};
+	for(unsigned int i = 0; i < 2; ++i) {
+		outStream << lNames[i] << ": count " << lStatistics[i]->getCount() << ", mean " << lStatistics[i]->getMean()*1e6 << " us, p50 " << lStatistics[i]->getPercentile(0.5)*1e6 << " us, p99 " << lStatistics[i]->getPercentile(0.99)*1e6 << " us, max " << lStatistics[i]->getMaximum()*1e6 << " us" << endl;
+	}
+	for(size_t i = 0; i < mWorkers.size(); ++i) {
+		const Worker& lWorker = mWorkers[i];
+		if(lWorker.mIndex < 0) outStream << "helper: ";
+		else outStream << "slave " << lWorker.mIndex << (lWorker.mRunning ? ": " : " (terminated): ");
+		outStream << "completed " << lWorker.mCompleted << ", busy " << lWorker.mBusyTime << " s, idle " << lWorker.mIdleTime << " s" << endl;
+	}
+}
+
+/*! \brief Write metrics as XML into streamer \c outStreamer.
+
+The metrics are written as a \c ThreadPoolMetrics element, with \c Wait and \c Run elements for the time histograms (in seconds), and a \c Worker element per worker.
+*/
+void Threading::ThreadPool::Metrics::write(XML::Streamer& outStreamer) const
+{
+	outStreamer.openTag("ThreadPoolMetrics");
+	outStreamer.insertAttribute("elapsed", mElapsed);
+	outStreamer.insertAttribute("submitted", mSubmitted);
+	outStreamer.insertAttribute("completed", mCompleted);
+	outStreamer.insertAttribute("pending", mQueueDepth);
+	outStreamer.insertAttribute("peak", mMaxQueueDepth);
+	outStreamer.insertAttribute("utilization", getUtilization());
+	const WaitStatistics* lStatistics[2] = {&mWait, &mRun};
+	const char* lNames[2] = {"Wait", "Run"};
+	for(unsigned int i = 0; i < 2; ++i) {
+		outStreamer.openTag(lNames[i]);
+		outStreamer.insertAttribute("count", lStatistics[i]->getCount());
+		outStreamer.insertAttribute("mean", lStatistics[i]->getMean());
+		outStreamer.insertAttribute("p50", lStatistics[i]->getPercentile(0.5));
+		outStreamer.insertAttribute("p90", lStatistics[i]->getPercentile(0.9));
+		outStreamer.insertAttribute("p99", lStatistics[i]->getPercentile(0.99));
+		outStreamer.insertAttribute("max", lStatistics[i]->getMaximum());
+		outStreamer.closeTag();
+	}
+	for(size_t i = 0; i < mWorkers.size(); ++i) {
+		outStreamer.openTag("Worker");
+		outStreamer.insertAttribute("index", mWorkers[i].mIndex);
+		outStreamer.insertAttribute("running", mWorkers[i].mRunning ? 1 : 0);
+		outStreamer.insertAttribute("completed", mWorkers[i].mCompleted);
+		outStreamer.insertAttribute("busy", mWorkers[i].mBusyTime);
+		outStreamer.insertAttribute("idle", mWorkers[i].mIdleTime);
+		outStreamer.closeTag();
+	}
+	outStreamer.closeTag();
+}
+
+//! Construct empty statistics.
+Threading::ThreadPool::WaitStatistics::WaitStatistics(void) : mCount(0), mLate(0), mTotal(0), mMaximum(0)
+{
+	for(unsigned int i = 0; i < eBuckets; ++i) mHistogram[i] = 0;
+}
+
+//! Add wait time \c inWait (in seconds); argument \c inLate tells whether the task started after its deadline.
+void Threading::ThreadPool::WaitStatistics::add(double inWait, bool inLate)
+{
+	if(inWait < 0) inWait = 0;
+	++mCount;
+	if(inLate) ++mLate;
+	mTotal += inWait;
+	if(inWait > mMaximum) mMaximum = inWait;
+	++mHistogram[getBucket(inWait)];
+}
+
+/*! \brief Return estimated percentile \c inFraction of wait times (e.g. 0.99 for the 99th percentile), in seconds.
+
+The estimate is the upper bound of the histogram bucket that holds the percentile, hence it is accurate within a factor of two (and never larger than the maximum wait time).
+*/
+double Threading::ThreadPool::WaitStatistics::getPercentile(double inFraction) const
+{
+	if(mCount == 0) return 0;
+	double lRank = inFraction * mCount;
+	unsigned long lCumulated = 0;
+	double lBound = 1e-6;
+	for(unsigned int i = 0; i < eBuckets; ++i, lBound *= 2) {
+		lCumulated += mHistogram[i];
+		if(lCumulated >= lRank) return lBound < mMaximum ? lBound : mMaximum;
+	}
+	return mMaximum;
 }
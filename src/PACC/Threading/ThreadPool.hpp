@@ -38,6 +38,15 @@
 
 #include "PACC/Threading/Thread.hpp"
 #include "PACC/Threading/Task.hpp"
+#include "PACC/Threading/Future.hpp"
+#include "PACC/Threading/EventCount.hpp"
+#include "PACC/Threading/MPMCQueue.hpp"
+#include "PACC/Threading/ThreadLocal.hpp"
+#include "PACC/Threading/WorkDeque.hpp"
+#include "PACC/Util/Timer.hpp"
+#include <atomic>
+#include <map>
+#include <ostream>
 #include <queue>
 #include <vector>
 
@@ -45,8 +54,13 @@ namespace PACC {
 	
 	using namespace std;
 	
+	namespace XML {
+		class Streamer;
+	}
+	
 	namespace Threading {
 		
+		class ScheduledExecutor;
 		class ThreadPool;
 		
 		/*! \brief Slave thread for the portable thread pool.
@@ -57,15 +71,30 @@ namespace PACC {
 		*/
 		class SlaveThread : public Thread {
 			public:
-			//! Construct a slave thread for a thread pool.
-			SlaveThread(ThreadPool* inPool) : mPool(inPool) {run();}
+			//! Construct slave thread number \c inIndex for thread pool \c inPool, pinned to processors \c inAffinity (if not empty).
+			SlaveThread(ThreadPool* inPool, unsigned int inIndex=0, const vector<unsigned int>& inAffinity=vector<unsigned int>()) : mPool(inPool), mIndex(inIndex), mSeed(inIndex+1), mStarted(0) {
+				mAffinity = inAffinity;
+				run();
+			}
 			//! Delete slave thread; wait for thread termination.
 			~SlaveThread(void) {wait(true);}
 			
+			//! Return index of this slave in its parent thread pool.
+			unsigned int getIndex(void) const {return mIndex;}
+			//! Return parent thread pool.
+			ThreadPool* getPool(void) const {return mPool;}
+			
+			static SlaveThread* getCurrent(void);
+			
 			protected:
 			ThreadPool* mPool; //!< Pointer to parent thread pool
+			unsigned int mIndex; //!< Index of slave in parent thread pool
+			unsigned int mSeed; //!< State of random victim selection (work-stealing mode)
+			double mStarted; //!< Time at which the slave started (on the timer of its pool).
 			
 			void main(void);
+			
+			friend class ThreadPool;
 		};
 		
 		/*! \brief Portable thread pool of slaves.
@@ -95,16 +124,292 @@ int void main(int argc, char** argv)
 	return 0;
 }
 		\endcode
+		
+		Two scheduling modes are supported (see constructor):
+		- ThreadPool::eFIFO (default): every task is appended to the single FIFO queue of the pool.
+		- ThreadPool::eWorkStealing: tasks pushed by a slave thread of this pool (i.e. from within Task::main) are pushed onto a lock-free deque owned by this slave (see class WorkDeque). Each slave first executes its own most recent tasks (LIFO), then the tasks of the FIFO queue, and finally steals the oldest tasks of other slaves. Tasks pushed by any other thread still go through the FIFO queue, so that external submitters are served in order. This mode is best suited for fine-grained tasks that spawn other tasks, because most pushes and pops then never touch the pool mutex.
+		
+		Besides objects derived from class Task, the thread pool accepts any callable object through method ThreadPool::submit, which returns a Future of its result. Continuations can be attached to futures (see Future::then) and futures can be combined (see functions whenAll and whenAny), so that dependent computations are chained without blocking any thread:
+		\code
+Future<double> lSum = lPool.submit([&]() {return computeSum(lData);});
+Future<void> lDone = lSum.then([](double inSum) {cout << inSum << endl;});
+lDone.wait();
+		\endcode
+		
+		Two other modes replace the FIFO queue by a priority queue, protected by the pool mutex:
+		- ThreadPool::ePriority: tasks with a larger priority (see Task::setPriority) are served first, and tasks of equal priority in FIFO order. To avoid starvation, the priority of a waiting task is raised by one level for every ThreadPool::getAging seconds of waiting (0 disables aging).
+		- ThreadPool::eDeadline: tasks are served in earliest deadline first order (see Task::setDeadline); tasks without deadline are served in FIFO order after all tasks with a deadline.
+		
+		In any mode, the time that tasks spend waiting in the queues can be measured for every priority level (see ThreadPool::setWaitStatistics), in order to compare the latency of different classes of tasks under load.
+		
+		A pool can also be elastic (see constructor ThreadPool(unsigned int, unsigned int, Scheduling, const vector<unsigned int>&)): it then starts with a minimum number of slaves, and allocates a new slave (up to a maximum) whenever tasks wait longer than a growth latency (see ThreadPool::setGrowthLatency) while all slaves are busy. Slaves above the minimum retire after staying idle for some time (see ThreadPool::setIdleTimeout). The bounds can be changed at any time with method ThreadPool::resize. Because slaves come and go, the number of slaves of an elastic pool should be obtained with method ThreadPool::getSlaveCount, rather than with the size of the pool (i.e. of its vector of slaves), which may only be accessed while the pool is locked.
+		
+		In the first two modes, the FIFO queue is a bounded lock-free ring (see class MPMCQueue) backed by an unbounded overflow queue, which is protected by the pool mutex and only used when the ring is full. Idle slaves park on an event count (see class EventCount), so that pushing a task while all slaves are busy costs neither a lock nor a system call.
+		
+		Once enabled (see ThreadPool::setMetrics), pool metrics count pushed and executed tasks, track the current and peak number of pending tasks, accumulate histograms of wait times (from push to start) and run times, and measure the busy and idle time of every slave. Counters are kept per thread, in thread local storage, and updated without any lock or atomic read-modify-write, except for a single shared counter of pending tasks. Timing a task costs three reads of the pool timer, so that only a sample of the tasks can be timed, while all tasks are counted; metrics can therefore stay enabled in production. Method ThreadPool::getMetrics returns a snapshot, which can be written as text or as XML (see ThreadPool::Metrics), and method ThreadPool::exportMetrics writes snapshots periodically.
 			*/
 		class ThreadPool : public vector<SlaveThread*>, public Condition {      
 			public:
-			ThreadPool(unsigned int inSlaves);
+			//! Scheduling modes of the thread pool.
+			enum Scheduling {
+				eFIFO, //!< Single FIFO queue for all tasks.
+				eWorkStealing, //!< Per slave deques for tasks pushed by slaves, with work stealing.
+				ePriority, //!< Priority queue, with aging.
+				eDeadline //!< Earliest deadline first queue.
+			};
+			
+			/*! \brief Statistics of the time spent by tasks in the queues of a thread pool (or, in pool metrics, running).
+			\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+			\ingroup Threading
+			
+			Wait times are accumulated into a histogram with power of two buckets (in microseconds), from which percentiles are estimated.
+			*/
+			class WaitStatistics {
+				public:
+				WaitStatistics(void);
+				
+				void add(double inWait, bool inLate);
+				
+				//! Return number of tasks.
+				unsigned long getCount(void) const {return mCount;}
+				//! Return number of tasks that started after their deadline.
+				unsigned long getLate(void) const {return mLate;}
+				//! Return maximum wait time (in seconds).
+				double getMaximum(void) const {return mMaximum;}
+				//! Return mean wait time (in seconds).
+				double getMean(void) const {return mCount ? mTotal/mCount : 0;}
+				double getPercentile(double inFraction) const;
+				
+				protected:
+				//! Number of histogram buckets.
+				enum {eBuckets = 40};
+				unsigned long mCount; //!< Number of tasks.
+				unsigned long mLate; //!< Number of tasks that started after their deadline.
+				double mTotal; //!< Total wait time.
+				double mMaximum; //!< Maximum wait time.
+				unsigned long mHistogram[eBuckets]; //!< Number of tasks per bucket (bucket i holds waits below 2^i microseconds).
+				
+				//! Return bucket of time \c inTime (in seconds).
+				static unsigned int getBucket(double inTime) {
+					unsigned int lBucket = 0;
+					for(double lBound = 1e-6; lBucket < eBuckets-1 && inTime >= lBound; lBound *= 2) ++lBucket;
+					return lBucket;
+				}
+				
+				friend class ThreadPool;
+			};
+			
+			/*! \brief Snapshot of the metrics of a thread pool (see ThreadPool::getMetrics).
+			\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+			\ingroup Threading
+			*/
+			struct Metrics {
+				//! Metrics of a thread that executed tasks of the pool.
+				struct Worker {
+					int mIndex; //!< Index of slave in the pool (-1 for a helping thread, see ThreadPool::runPending).
+					bool mRunning; //!< Whether the slave is still running (always true for a helping thread).
+					unsigned long mCompleted; //!< Number of executed tasks.
+					double mBusyTime; //!< Time spent executing tasks (in seconds, extrapolated from the timed tasks).
+					double mIdleTime; //!< Time spent without task by a slave (in seconds, always 0 for a helping thread).
+				};
+				
+				double mElapsed; //!< Time since metrics were enabled or reset (in seconds).
+				unsigned long mSubmitted; //!< Number of pushed tasks.
+				unsigned long mCompleted; //!< Number of executed tasks.
+				long mQueueDepth; //!< Number of pending tasks.
+				long mMaxQueueDepth; //!< Peak number of pending tasks.
+				WaitStatistics mWait; //!< Statistics of times between push and start of timed tasks.
+				WaitStatistics mRun; //!< Statistics of run times of timed tasks.
+				vector<Worker> mWorkers; //!< Metrics of every thread that executed tasks.
+				
+				double getUtilization(void) const;
+				void write(ostream& outStream) const;
+				void write(XML::Streamer& outStreamer) const;
+			};
+			
+			ThreadPool(unsigned int inSlaves, Scheduling inScheduling=eFIFO, const vector<unsigned int>& inAffinity=vector<unsigned int>());
+			ThreadPool(unsigned int inMinSlaves, unsigned int inMaxSlaves, Scheduling inScheduling=eFIFO, const vector<unsigned int>& inAffinity=vector<unsigned int>());
 			~ThreadPool(void);
 			
+			//! Return aging period of priorities (see ThreadPool::setAging).
+			double getAging(void) const {return mAging;}
+			//! Return growth latency of the elastic pool (see ThreadPool::setGrowthLatency).
+			double getGrowthLatency(void) const {return mLatency.load();}
+			//! Return idle time out of the elastic pool (see ThreadPool::setIdleTimeout).
+			double getIdleTimeout(void) const {return mIdleTimeout.load();}
+			//! Return maximum number of slaves.
+			unsigned int getMaxSlaves(void) const {return mMaxSlaves.load();}
+			//! Return minimum number of slaves.
+			unsigned int getMinSlaves(void) const {return mMinSlaves.load();}
+			Metrics getMetrics(void) const;
+			//! Return current number of slaves.
+			unsigned int getSlaveCount(void) const {return mSlaveCount.load();}
+			//! Return scheduling mode of this pool.
+			Scheduling getScheduling(void) const {return mScheduling;}
+			map<int, WaitStatistics> getWaitStatistics(void) const;
+			
+			/*! \brief Set aging period of priorities to \c inAging seconds (mode ThreadPool::ePriority).
+			
+			A task that has waited \c inAging seconds is served before a task pushed at the same time with a priority larger by one. The default is 0.01 second; value 0 disables aging (strict priorities). The new period only applies to tasks pushed afterwards.
+			*/
+			void setAging(double inAging) {lock(); mAging = inAging; unlock();}
+			
+			/*! \brief Set growth latency of the elastic pool to \c inLatency seconds.
+			
+			A new slave is allocated when a task has waited more than \c inLatency seconds in the queues, or when no slave has started any task during the last \c inLatency seconds while all of them are busy; at most one slave is allocated per growth latency period. The default is 0.01 second.
+			*/
+			void setGrowthLatency(double inLatency) {mLatency.store(inLatency);}
+			/*! \brief Set idle time out of the elastic pool to \c inTimeout seconds.
+			
+			A slave above the minimum number of slaves retires after waiting \c inTimeout seconds without finding any task. The default is 10 seconds. The new time out applies to the next wait of every slave.
+			*/
+			void setIdleTimeout(double inTimeout) {mIdleTimeout.store(inTimeout);}
+			
+			void resize(unsigned int inSlaves);
+			void resize(unsigned int inMinSlaves, unsigned int inMaxSlaves);
+			
+			unsigned long exportMetrics(ScheduledExecutor& ioScheduler, ostream& outStream, double inPeriod, bool inXML=false);
+			void resetMetrics(void);
+			void setMetrics(bool inEnable, unsigned int inSampling=1);
+			void resetWaitStatistics(void);
+			void setWaitStatistics(bool inEnable);
+			
 			void push(Task& inTask);
+			void pushBatch(Task** inFirst, Task** inLast);
+			void pushDetached(Task* inTask);
+			
+			/*! \brief Push tasks of range [\c inFirst, \c inLast) onto the thread pool queue.
+			
+			The range can hold either tasks (e.g. a vector of objects derived from class Task) or pointers to tasks. Pointers to the tasks are first gathered, and then pushed using ThreadPool::pushBatch(Task**, Task**).
+			*/
+			template <class Iterator>
+			void pushBatch(Iterator inFirst, Iterator inLast) {
+				vector<Task*> lTasks;
+				for(; inFirst != inLast; ++inFirst) lTasks.push_back(getTaskPointer(*inFirst));
+				if(!lTasks.empty()) pushBatch(&lTasks.front(), &lTasks.front()+lTasks.size());
+			}
+			bool runPending(void);
+			void waitHelping(const Task& inTask);
+			
+			/*! \brief Submit function \c inFunction for execution by the thread pool.
+			\return Future of the value returned by the function.
+			
+			The function is any callable object without argument (e.g. a lambda). It is moved into a detached task (see ThreadPool::pushDetached), so that no object needs to outlive the call. Any exception thrown by the function is stored into the returned future, and thrown again by Future::get.
+			*/
+			template <class Function>
+			auto submit(Function inFunction) -> Future<decltype(inFunction())> {
+				typedef decltype(inFunction()) T;
+				shared_ptr<FutureState<T> > lResult = make_shared<FutureState<T> >(this);
+				pushDetached(new FutureTask<T, Function>(lResult, std::move(inFunction)));
+				return Future<T>(lResult);
+			}
+			
+			/*! \brief Push nullary function \c inFunction with cancellation token \c inToken onto the thread pool.
+			\return Future of the value returned by the function.
+			
+			If \c inToken is canceled before the function starts, the function is not run, and the future holds a Threading::Exception with code Threading::eCanceled. The function may also poll \c inToken while running (see class CancellationSource).
+			*/
+			template <class Function>
+			auto submit(Function inFunction, const CancellationToken& inToken) -> Future<decltype(inFunction())> {
+				typedef decltype(inFunction()) T;
+				shared_ptr<FutureState<T> > lResult = make_shared<FutureState<T> >(this);
+				FutureTask<T, Function>* lTask = new FutureTask<T, Function>(lResult, std::move(inFunction));
+				lTask->setCancellationToken(inToken);
+				pushDetached(lTask);
+				return Future<T>(lResult);
+			}
 			
 			protected:
-			queue<Task*> mTasks; //!< Queue of tasks.
+			/*! \brief Lock-free histogram of task times, modified by a single thread.
+			
+			Every field is updated with relaxed atomic loads and stores (no read-modify-write), so that other threads can read it at any time.
+			*/
+			struct TimeHistogram {
+				atomic<unsigned long> mCount; //!< Number of tasks.
+				atomic<double> mTotal; //!< Total time.
+				atomic<double> mMaximum; //!< Maximum time.
+				atomic<unsigned long> mHistogram[WaitStatistics::eBuckets]; //!< Number of tasks per bucket (see WaitStatistics).
+				
+				void add(double inTime);
+				void addTo(WaitStatistics& ioStatistics) const;
+				void reset(void);
+			};
+			
+			/*! \brief Metrics of a thread that pushes or executes tasks of the pool.
+			
+			Metrics are held in thread local storage, and only modified by their own thread (see ThreadPool::TimeHistogram).
+			*/
+			struct ThreadMetrics {
+				atomic<int> mIndex; //!< Index of slave (-1 for other threads, -2 if not initialized yet).
+				atomic<double> mStart; //!< Time at which the slave started (or metrics were reset).
+				atomic<double> mStop; //!< Time at which the slave terminated (0 while it runs).
+				atomic<unsigned long> mSubmitted; //!< Number of pushed tasks.
+				atomic<unsigned long> mCompleted; //!< Number of executed tasks.
+				atomic<double> mBusy; //!< Time spent executing timed tasks.
+				unsigned int mSkipped; //!< Number of tasks pushed since the last timed task.
+				TimeHistogram mWait; //!< Times between push and start of timed tasks.
+				TimeHistogram mRun; //!< Run times of timed tasks.
+				
+				//! Construct uninitialized metrics.
+				ThreadMetrics(void) : mIndex(-2), mStop(0), mSkipped(0) {reset(0);}
+				void reset(double inNow);
+			};
+			
+			MPMCQueue<Task*> mRing; //!< Lock-free FIFO queue of tasks.
+			queue<Task*> mTasks; //!< Overflow queue of tasks (protected by the pool mutex).
+			Scheduling mScheduling; //!< Scheduling mode.
+			vector<WorkDeque*> mDeques; //!< Per slave deques of tasks (work-stealing mode).
+			atomic<unsigned int> mQueued; //!< Number of tasks in the overflow queue.
+			atomic<bool> mShutdown; //!< Pool is being deleted flag.
+			vector<Task*> mHeap; //!< Priority queue of tasks (priority and deadline modes, protected by the pool mutex).
+			unsigned long long mSequence; //!< Sequence number of next pushed task (protected by the pool mutex).
+			double mAging; //!< Aging period of priorities.
+			Timer mTimer; //!< Timer of queue wait times.
+			atomic<bool> mMeasuring; //!< Wait statistics are enabled flag.
+			Mutex mStatisticsMutex; //!< Mutex of wait statistics.
+			map<int, WaitStatistics> mStatistics; //!< Wait statistics per priority.
+			EventCount mIdle; //!< Event count of idle slaves.
+			vector<unsigned int> mAffinity; //!< Processor set of slaves.
+			atomic<unsigned int> mMinSlaves; //!< Minimum number of slaves (modified with the pool mutex locked).
+			atomic<unsigned int> mMaxSlaves; //!< Maximum number of slaves (modified with the pool mutex locked).
+			atomic<unsigned int> mSlaveCount; //!< Current number of slaves (modified with the pool mutex locked).
+			atomic<unsigned int> mRetiring; //!< Number of slaves that should retire as soon as they are idle (modified with the pool mutex locked).
+			vector<SlaveThread*> mRetired; //!< Retired slaves that have not been deleted yet (protected by the pool mutex).
+			atomic<double> mLatency; //!< Growth latency of the elastic pool.
+			atomic<double> mIdleTimeout; //!< Idle time out of the elastic pool.
+			atomic<double> mLastActivity; //!< Time at which a slave last started a task (elastic pool).
+			atomic<double> mLastGrowth; //!< Time at which the elastic pool last allocated a slave.
+			atomic<bool> mMetrics; //!< Metrics are enabled flag.
+			atomic<double> mMetricsStart; //!< Time at which metrics were enabled or reset.
+			atomic<long> mDepth; //!< Number of pending tasks (while metrics are enabled).
+			atomic<long> mMaxDepth; //!< Peak number of pending tasks.
+			atomic<unsigned int> mSampling; //!< One task out of every mSampling pushed by a thread is timed.
+			mutable ThreadLocal<ThreadMetrics> mThreadMetrics; //!< Metrics of every thread.
+			
+			//! Return pointer to task \c inTask.
+			static Task* getTaskPointer(Task& inTask) {return &inTask;}
+			//! Return pointer to task \c inTask.
+			static Task* getTaskPointer(Task* inTask) {return inTask;}
+			
+			void countSubmitted(Task** inFirst, Task** inLast, bool inStamped);
+			ThreadMetrics& getThreadMetrics(void);
+			void grow(double inNow);
+			bool hasWork(void) const;
+			//! Return whether the number of slaves may vary.
+			bool isElastic(void) const {return mMinSlaves.load(memory_order_relaxed) < mMaxSlaves.load(memory_order_relaxed);}
+			//! Return whether task \c inLeft should be served after task \c inRight (priority and deadline modes).
+			static bool isAfter(const Task* inLeft, const Task* inRight) {
+				return inLeft->mKey > inRight->mKey || (inLeft->mKey == inRight->mKey && inLeft->mSequence > inRight->mSequence);
+			}
+			Task* popTask(SlaveThread* inSlave);
+			void pushHeap(Task* inTask);
+			void recordWait(const Task* inTask);
+			bool retire(SlaveThread* inSlave, bool inTimedOut);
+			Task* takeTask(SlaveThread* inSlave);
+			void runMeasured(Task* inTask);
+			void schedule(Task* inTask);
+			void spawn(void);
+			static void runTask(Task* inTask);
 			
 			friend class SlaveThread;
 		};
@@ -114,4 +419,3 @@ int void main(int argc, char** argv)
 } // end of PACC namespace
 
 #endif // PACC_Threading_ThreadPool_hpp_
-
@@ -0,0 +1,160 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/Topology.cpp
+ * \brief Class methods for the processor and memory topology.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#include "PACC/Threading/Topology.hpp"
+#include "PACC/Threading/Exception.hpp"
+#include "PACC/config.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#ifdef PACC_THREADS_WIN32
+#include <windows.h>
+#else // Unix...
+#include <unistd.h>
+#ifdef PACC_AFFINITY
+#include <sched.h>
+#endif
+#endif
+
+using namespace std;
+using namespace PACC;
+
+namespace {
+	
+	//! Return first line of text file \c inName (empty if the file cannot be read).
+	string readFirstLine(const string& inName)
+	{
+		ifstream lFile(inName.c_str());
+		string lContent;
+		getline(lFile, lContent);
+		return lContent;
+	}
+	
+	//! Read processor sets of all nodes from the operating system.
+	vector<vector<unsigned int> > readNodes(void)
+	{
+		vector<vector<unsigned int> > lNodes;
+#ifndef PACC_THREADS_WIN32
+		// Linux: one directory per online node
+		vector<unsigned int> lOnline = Threading::Topology::parseCPUList(readFirstLine("/sys/devices/system/node/online"));
+		for(unsigned int i = 0; i < lOnline.size(); ++i) {
+			ostringstream lName;
+			lName << "/sys/devices/system/node/node" << lOnline[i] << "/cpulist";
+			vector<unsigned int> lCPUs = Threading::Topology::parseCPUList(readFirstLine(lName.str()));
+			// skip memory-only nodes
+			if(!lCPUs.empty()) lNodes.push_back(lCPUs);
+		}
+#endif
+		if(lNodes.empty()) {
+			// single node with all processors
+			vector<unsigned int> lCPUs;
+			for(unsigned int i = 0; i < Threading::Topology::getCPUCount(); ++i) lCPUs.push_back(i);
+			lNodes.push_back(lCPUs);
+		}
+		return lNodes;
+	}
+	
+	//! Return processor sets of all nodes (read once).
+	const vector<vector<unsigned int> >& getNodes(void)
+	{
+		static const vector<vector<unsigned int> > lNodes = readNodes();
+		return lNodes;
+	}
+	
+}
+
+//! Return number of online processors.
+unsigned int Threading::Topology::getCPUCount(void)
+{
+#ifdef PACC_THREADS_WIN32
+	SYSTEM_INFO lInfo;
+	::GetSystemInfo(&lInfo);
+	return lInfo.dwNumberOfProcessors;
+#else // Unix...
+	long lCount = ::sysconf(_SC_NPROCESSORS_ONLN);
+	return lCount > 0 ? (unsigned int) lCount : 1;
+#endif
+}
+
+//! Return index of the processor that runs the calling thread, or -1 if unknown.
+int Threading::Topology::getCurrentCPU(void)
+{
+#if defined(PACC_THREADS_WIN32)
+	return (int) ::GetCurrentProcessorNumber();
+#elif defined(PACC_AFFINITY)
+	return ::sched_getcpu();
+#else
+	return -1;
+#endif
+}
+
+//! Return number of NUMA nodes (at least 1).
+unsigned int Threading::Topology::getNodeCount(void)
+{
+	return getNodes().size();
+}
+
+//! Return processors of NUMA node \c inNode; throw exception if the node index is invalid.
+const vector<unsigned int>& Threading::Topology::getNodeCPUs(unsigned int inNode)
+{
+	const vector<vector<unsigned int> >& lNodes = getNodes();
+	if(inNode >= lNodes.size()) throw Exception(eOtherError, "Topology::getNodeCPUs() invalid node index");
+	return lNodes[inNode];
+}
+
+/*! \brief Parse list of processors \c inList in the Linux format (e.g. "0-3,8,10-11").
+\return Vector of processor indices (empty if the list is empty or malformed).
+*/
+vector<unsigned int> Threading::Topology::parseCPUList(const string& inList)
+{
+	vector<unsigned int> lCPUs;
+	istringstream lStream(inList);
+	string lRange;
+	while(getline(lStream, lRange, ',')) {
+		if(lRange.empty()) continue;
+		char* lEnd;
+		unsigned long lFirst = strtoul(lRange.c_str(), &lEnd, 10);
+		if(lEnd == lRange.c_str()) return vector<unsigned int>();
+		unsigned long lLast = lFirst;
+		if(*lEnd == '-') {
+			const char* lStart = lEnd+1;
+			lLast = strtoul(lStart, &lEnd, 10);
+			if(lEnd == lStart || lLast < lFirst) return vector<unsigned int>();
+		}
+		for(unsigned long i = lFirst; i <= lLast; ++i) lCPUs.push_back((unsigned int) i);
+	}
+	return lCPUs;
+}
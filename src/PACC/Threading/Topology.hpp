@@ -0,0 +1,69 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/Topology.hpp
+ * \brief Class definition for the processor and memory topology.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#ifndef PACC_Threading_Topology_hpp_
+#define PACC_Threading_Topology_hpp_
+
+#include <string>
+#include <vector>
+
+namespace PACC { 
+	
+	using namespace std;
+	
+	namespace Threading {
+		
+		/*! \brief Processor and memory topology of the machine.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		This class describes the NUMA (non uniform memory access) nodes of the machine: every node groups a set of processors with the memory bank that is closest to them. Under Linux, the topology is read from the \c /sys file system. On other platforms (or if the information is not available), the machine is described as a single node that holds all of its processors.
+		
+		Node indices are contiguous from 0, even if the operating system numbers its nodes otherwise; processor indices are those of the operating system, as expected by Thread::setAffinity.
+		*/
+		class Topology {
+			public:
+			static unsigned int getCPUCount(void);
+			static int getCurrentCPU(void);
+			static unsigned int getNodeCount(void);
+			static const vector<unsigned int>& getNodeCPUs(unsigned int inNode);
+			static vector<unsigned int> parseCPUList(const string& inList);
+		};
+		
+	} // end of Threading namespace
+	
+} // end of PACC namespace
+
+#endif // PACC_Threading_Topology_hpp_
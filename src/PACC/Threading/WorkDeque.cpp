@@ -0,0 +1,119 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/WorkDeque.cpp
+ * \brief Class methods for the lock-free work-stealing deque.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#include "PACC/Threading/WorkDeque.hpp"
+
+using namespace std;
+using namespace PACC;
+
+//! Construct empty deque with initial capacity \c inCapacity (rounded up to a power of two).
+Threading::WorkDeque::WorkDeque(unsigned int inCapacity) : mTop(0), mBottom(0)
+{
+	long lCapacity = 2;
+	while(lCapacity < (long) inCapacity) lCapacity *= 2;
+	mArray.store(new Array(lCapacity), memory_order_relaxed);
+}
+
+//! Delete deque and all of its arrays (the tasks themselves are not deleted).
+Threading::WorkDeque::~WorkDeque(void)
+{
+	delete mArray.load(memory_order_relaxed);
+	for(unsigned int i = 0; i < mRetired.size(); ++i) delete mRetired[i];
+}
+
+/*! \brief Push task \c inTask at the bottom of the deque.
+
+This method should only be called by the owner thread. If the array is full, it is replaced by one of twice the capacity.
+*/
+void Threading::WorkDeque::push(Task* inTask)
+{
+	long lBottom = mBottom.load(memory_order_relaxed);
+	long lTop = mTop.load(memory_order_acquire);
+	Array* lArray = mArray.load(memory_order_relaxed);
+	if(lBottom-lTop > lArray->mMask) {
+		// array is full, copy tasks into a larger one
+		Array* lNew = new Array(2*(lArray->mMask+1));
+		for(long i = lTop; i < lBottom; ++i) {
+			lNew->mTasks[i & lNew->mMask].store(lArray->mTasks[i & lArray->mMask].load(memory_order_relaxed), memory_order_relaxed);
+		}
+		mRetired.push_back(lArray);
+		mArray.store(lNew, memory_order_release);
+		lArray = lNew;
+	}
+	lArray->mTasks[lBottom & lArray->mMask].store(inTask, memory_order_relaxed);
+	mBottom.store(lBottom+1, memory_order_release);
+}
+
+/*! \brief Steal the top task of the deque.
+\return Pointer to stolen task, or null pointer if the deque is empty or if the steal lost a race.
+
+This method can be called by any thread.
+*/
+Threading::Task* Threading::WorkDeque::steal(void)
+{
+	long lTop = mTop.load(memory_order_acquire);
+	atomic_thread_fence(memory_order_seq_cst);
+	long lBottom = mBottom.load(memory_order_acquire);
+	if(lTop >= lBottom) return 0;
+	Array* lArray = mArray.load(memory_order_acquire);
+	Task* lTask = lArray->mTasks[lTop & lArray->mMask].load(memory_order_relaxed);
+	// another thief, or the owner, may have taken this task already
+	if(!mTop.compare_exchange_strong(lTop, lTop+1, memory_order_seq_cst, memory_order_relaxed)) return 0;
+	return lTask;
+}
+
+/*! \brief Take the bottom task of the deque.
+\return Pointer to task, or null pointer if the deque is empty.
+
+This method should only be called by the owner thread.
+*/
+Threading::Task* Threading::WorkDeque::take(void)
+{
+	long lBottom = mBottom.load(memory_order_relaxed)-1;
+	Array* lArray = mArray.load(memory_order_relaxed);
+	mBottom.store(lBottom, memory_order_relaxed);
+	atomic_thread_fence(memory_order_seq_cst);
+	long lTop = mTop.load(memory_order_relaxed);
+	Task* lTask = 0;
+	if(lTop <= lBottom) {
+		lTask = lArray->mTasks[lBottom & lArray->mMask].load(memory_order_relaxed);
+		if(lTop == lBottom) {
+			// last task, race against thieves
+			if(!mTop.compare_exchange_strong(lTop, lTop+1, memory_order_seq_cst, memory_order_relaxed)) lTask = 0;
+			mBottom.store(lBottom+1, memory_order_relaxed);
+		}
+	} else mBottom.store(lBottom+1, memory_order_relaxed);
+	return lTask;
+}
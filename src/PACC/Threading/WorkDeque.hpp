@@ -0,0 +1,100 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Threading/WorkDeque.hpp
+ * \brief Class definition for the lock-free work-stealing deque.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#ifndef PACC_Threading_WorkDeque_hpp_
+#define PACC_Threading_WorkDeque_hpp_
+
+#include <atomic>
+#include <vector>
+
+namespace PACC { 
+	
+	using namespace std;
+	
+	namespace Threading {
+		
+		class Task;
+		
+		/*! \brief Lock-free work-stealing deque of tasks.
+		\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+		\ingroup Threading
+		
+		This class implements the dynamic circular work-stealing deque of Chase and Lev, with the memory orderings of Le, Pop, Cohen and Zappa Nardelli:
+		- D. Chase and Y. Lev, "Dynamic Circular Work-Stealing Deque", SPAA 2005.
+		- N.M. Le, A. Pop, A. Cohen and F. Zappa Nardelli, "Correct and Efficient Work-Stealing for Weak Memory Models", PPoPP 2013.
+		
+		A single owner thread pushes and takes tasks at the bottom of the deque (LIFO order), using methods WorkDeque::push and WorkDeque::take. Any other thread can steal tasks at the top of the deque (FIFO order), using method WorkDeque::steal. None of these methods ever lock. When full, the circular buffer is doubled by the owner; old buffers are only released when the deque is deleted, because a concurrent thief may still be reading them.
+		*/
+		class WorkDeque {
+			public:
+			WorkDeque(unsigned int inCapacity=256);
+			~WorkDeque(void);
+			
+			//! Return whether the deque is (momentarily) empty.
+			bool empty(void) const {return mBottom.load(memory_order_relaxed) <= mTop.load(memory_order_relaxed);}
+			//! Return the (momentary) number of tasks in the deque.
+			long size(void) const {long lSize = mBottom.load(memory_order_relaxed)-mTop.load(memory_order_relaxed); return lSize > 0 ? lSize : 0;}
+			
+			void push(Task* inTask);
+			Task* steal(void);
+			Task* take(void);
+			
+			protected:
+			//! Circular array of tasks.
+			struct Array {
+				Array(long inCapacity) : mMask(inCapacity-1), mTasks(new atomic<Task*>[inCapacity]) {}
+				~Array(void) {delete[] mTasks;}
+				long mMask; //!< Capacity minus one (capacity is a power of two).
+				atomic<Task*>* mTasks; //!< Task slots.
+			};
+			
+			atomic<long> mTop; //!< Index of top task (next to steal).
+			char mPad[64]; //!< Keep top and bottom on distinct cache lines.
+			atomic<long> mBottom; //!< Index following the bottom task (next to push).
+			atomic<Array*> mArray; //!< Current circular array.
+			vector<Array*> mRetired; //!< Arrays replaced by a larger one.
+			
+			private:
+			//! restrict (disable) copy constructor.
+			WorkDeque(const WorkDeque&);
+			//! restrict (disable) assignment operator.
+			void operator=(const WorkDeque&);
+		};
+		
+	} // end of Threading namespace
+	
+} // end of PACC namespace
+
+#endif // PACC_Threading_WorkDeque_hpp_
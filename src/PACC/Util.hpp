@@ -40,6 +40,7 @@
 
 #include "PACC/Util/Assert.hpp"
 #include "PACC/Util/Date.hpp"
+#include "PACC/Util/ObjectPool.hpp"
 #include "PACC/Util/Randomizer.hpp"
 #include "PACC/Util/RandomPermutation.hpp"
 #include "PACC/Util/SignalHandler.hpp"
@@ -0,0 +1,169 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Util/ObjectPool.cpp
+ * \brief Class methods for the thread caching pool of small objects.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#include "PACC/Util/ObjectPool.hpp"
+#include "PACC/Threading/Mutex.hpp"
+#include <vector>
+
+using namespace std;
+using namespace PACC;
+
+thread_local ObjectPool::Cache ObjectPool::mCaches[ObjectPool::eClassCount];
+thread_local unsigned int ObjectPool::mCacheLimit = 2*ObjectPool::eBatchSize;
+
+namespace {
+	
+	//! Global free list of a size class.
+	struct FreeList {
+		Threading::Mutex mMutex; //!< Mutex that protects the list.
+		void* mHead; //!< First free block.
+		size_t mCount; //!< Number of free blocks.
+		
+		FreeList(void) : mHead(0), mCount(0) {}
+	};
+	
+	//! Global state of the pool.
+	struct Arena {
+		FreeList mLists[ObjectPool::eClassCount]; //!< Free lists of size classes.
+		Threading::Mutex mMutex; //!< Mutex that protects the slabs.
+		vector<void*> mSlabs; //!< Allocated slabs.
+	};
+	
+	//! Return the global state (constructed on first use, and never deleted, so that objects can be released during static destruction).
+	Arena& getArena(void)
+	{
+		static Arena* lArena = new Arena;
+		return *lArena;
+	}
+	
+	//! Return the blocks of a thread to the global lists at its termination.
+	struct CacheCleanup {
+		bool mActive; //!< Whether the thread has cached blocks.
+		
+		CacheCleanup(void) : mActive(false) {}
+		~CacheCleanup(void) {
+			if(mActive) ObjectPool::releaseCache();
+		}
+	};
+	
+	thread_local CacheCleanup gCacheCleanup;
+	
+}
+
+/*! \brief Return the blocks of size class \c inClass cached by the calling thread to the global list, keeping up to half of the cache limit.
+*/
+void ObjectPool::drain(size_t inClass)
+{
+	Cache& lCache = mCaches[inClass];
+	unsigned int lKeep = mCacheLimit/2;
+	if(lCache.mCount <= lKeep) return;
+	// detach the blocks beyond those kept
+	Block* lFirst = lCache.mHead;
+	Block* lLast = lFirst;
+	for(unsigned int i = lCache.mCount-lKeep; i > 1; --i) lLast = lLast->mNext;
+	size_t lCount = lCache.mCount-lKeep;
+	lCache.mHead = lLast->mNext;
+	lCache.mCount = lKeep;
+	FreeList& lList = getArena().mLists[inClass];
+	lList.mMutex.lock();
+	lLast->mNext = static_cast<Block*>(lList.mHead);
+	lList.mHead = lFirst;
+	lList.mCount += lCount;
+	lList.mMutex.unlock();
+}
+
+/*! \brief Return the total size of the slabs allocated by the pool (in bytes).
+*/
+size_t ObjectPool::getReservedSize(void)
+{
+	Arena& lArena = getArena();
+	lArena.mMutex.lock();
+	size_t lSize = lArena.mSlabs.size()*eSlabSize;
+	lArena.mMutex.unlock();
+	return lSize;
+}
+
+/*! \brief Refill the cache of size class \c inClass of the calling thread, and return one block of this class.
+
+A batch of blocks is taken from the global list of the class; if this list is empty, a new slab is carved into blocks. A thread that has released its cache (see ObjectPool::releaseCache) only takes single blocks.
+*/
+void* ObjectPool::refill(size_t inClass)
+{
+	Arena& lArena = getArena();
+	Cache& lCache = mCaches[inClass];
+	size_t lSize = (inClass+1)*eGranularity;
+	size_t lWanted = mCacheLimit > 0 ? eBatchSize : 1;
+	FreeList& lList = lArena.mLists[inClass];
+	lList.mMutex.lock();
+	if(lList.mCount > 0) {
+		Block* lFirst = static_cast<Block*>(lList.mHead);
+		Block* lLast = lFirst;
+		size_t lCount = lList.mCount < lWanted ? lList.mCount : lWanted;
+		for(size_t i = lCount; i > 1; --i) lLast = lLast->mNext;
+		lList.mHead = lLast->mNext;
+		lList.mCount -= lCount;
+		lList.mMutex.unlock();
+		lLast->mNext = lCache.mHead;
+		lCache.mHead = lFirst->mNext;
+		lCache.mCount += lCount-1;
+		if(lCount > 1) gCacheCleanup.mActive = true;
+		return lFirst;
+	}
+	lList.mMutex.unlock();
+	// carve a new slab: the calling thread caches a batch, the rest goes to the global list
+	char* lSlab = static_cast<char*>(::operator new(eSlabSize));
+	lArena.mMutex.lock();
+	lArena.mSlabs.push_back(lSlab);
+	lArena.mMutex.unlock();
+	size_t lCount = eSlabSize/lSize;
+	for(size_t i = 0; i+1 < lCount; ++i) reinterpret_cast<Block*>(lSlab+i*lSize)->mNext = reinterpret_cast<Block*>(lSlab+(i+1)*lSize);
+	Block* lLast = reinterpret_cast<Block*>(lSlab+(lCount-1)*lSize);
+	lLast->mNext = lCache.mHead;
+	lCache.mHead = reinterpret_cast<Block*>(lSlab)->mNext;
+	lCache.mCount += lCount-1;
+	gCacheCleanup.mActive = true;
+	if(lCache.mCount > mCacheLimit) drain(inClass);
+	return lSlab;
+}
+
+/*! \brief Return all the blocks cached by the calling thread to the global lists.
+
+This method is called automatically at thread termination. Afterwards, the calling thread still allocates and releases blocks, but without caching them.
+*/
+void ObjectPool::releaseCache(void)
+{
+	mCacheLimit = 0;
+	for(size_t i = 0; i < eClassCount; ++i) drain(i);
+}
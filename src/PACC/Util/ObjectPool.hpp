@@ -0,0 +1,155 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Util/ObjectPool.hpp
+ * \brief Class definition for the thread caching pool of small objects.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#ifndef PACC_ObjectPool_hpp_
+#define PACC_ObjectPool_hpp_
+
+#include <cstddef>
+#include <new>
+
+namespace PACC {
+	
+	using namespace std;
+	
+	/*! \brief Thread caching pool of small fixed-size memory blocks.
+	\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+	\ingroup Util
+	
+	This class allocates blocks of memory for small objects that are created and deleted at a high rate by many threads (e.g. tasks of a thread pool, nodes of an %XML tree). Requested sizes are rounded up to a multiple of 16 bytes, and each rounded size (size class) has its own free lists. Blocks larger than ObjectPool::eMaxSize bytes are forwarded to the global operator new.
+	
+	Every thread keeps a private free list for each size class, so that allocating and releasing a block usually costs a few instructions, without any lock nor atomic operation. A thread that runs out of blocks refills its list with a batch of blocks taken from a global list (or carved from a new slab of memory); a thread whose list grows too long returns a batch to the global list. Blocks can therefore be released by any thread, not only by the thread that allocated them (e.g. a task pushed by one thread and deleted by a slave of the pool). The blocks cached by a thread are returned to the global lists when it terminates.
+	
+	Slabs are never returned to the system: the pool keeps the peak memory of each size class for later reuse. Classes usually get their blocks through mixin class Pooled.
+	*/
+	class ObjectPool {
+		public:
+		//! Constants of the pool.
+		enum {
+			eGranularity = 16, //!< Size granularity of blocks (in bytes).
+			eMaxSize = 512, //!< Maximum size of pooled blocks (in bytes).
+			eClassCount = eMaxSize/eGranularity, //!< Number of size classes.
+			eBatchSize = 32, //!< Number of blocks exchanged with the global lists at once.
+			eSlabSize = 64*1024 //!< Size of slabs (in bytes).
+		};
+		
+		//! Return a block of at least \c inSize bytes.
+		static void* allocate(size_t inSize) {
+			if(inSize == 0 || inSize > eMaxSize) return ::operator new(inSize);
+			Cache& lCache = mCaches[(inSize-1)/eGranularity];
+			Block* lBlock = lCache.mHead;
+			if(!lBlock) return refill((inSize-1)/eGranularity);
+			lCache.mHead = lBlock->mNext;
+			--lCache.mCount;
+			return lBlock;
+		}
+		
+		//! Release block \c inBlock of \c inSize bytes (the size given to ObjectPool::allocate).
+		static void deallocate(void* inBlock, size_t inSize) {
+			if(!inBlock) return;
+			if(inSize == 0 || inSize > eMaxSize) {
+				::operator delete(inBlock);
+				return;
+			}
+			Cache& lCache = mCaches[(inSize-1)/eGranularity];
+			Block* lBlock = static_cast<Block*>(inBlock);
+			lBlock->mNext = lCache.mHead;
+			lCache.mHead = lBlock;
+			if(++lCache.mCount > mCacheLimit) drain((inSize-1)/eGranularity);
+		}
+		
+		static size_t getReservedSize(void);
+		static void releaseCache(void);
+		
+		protected:
+		//! Free block (the link is stored within the block itself).
+		struct Block {
+			Block* mNext; //!< Next free block.
+		};
+		
+		//! Free list of a thread for a size class.
+		struct Cache {
+			Block* mHead; //!< First free block.
+			unsigned int mCount; //!< Number of free blocks.
+		};
+		
+		static thread_local Cache mCaches[eClassCount]; //!< Free lists of the calling thread.
+		static thread_local unsigned int mCacheLimit; //!< Maximum number of cached blocks per size class for the calling thread.
+		
+		static void drain(size_t inClass);
+		static void* refill(size_t inClass);
+	};
+	
+	/*! \brief Mixin that allocates the objects of a class hierarchy from the ObjectPool.
+	\author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+	\ingroup Util
+	
+	A class derives from Pooled<T> (where \c T is the class itself) in order to replace its operators new and delete, and those of all of its derived classes. Since the pool has a size class for every multiple of 16 bytes, derived classes of different sizes can share the mixin of their base class. Pool blocks are only aligned on 16 bytes: with C++17, over-aligned classes (e.g. <tt>struct alignas(64) MyTask : Task</tt>) bypass the pool and use the aligned global operators. The base class must have a virtual destructor if objects are deleted through a pointer to it, so that the block is released with the size of the actual object. Arrays and stack objects are not affected.
+	*/
+	template <class T>
+	class Pooled {
+		public:
+		//! Allocate object of \c inSize bytes from the pool.
+		static void* operator new(size_t inSize) {return ObjectPool::allocate(inSize);}
+		//! Release object of \c inSize bytes to the pool.
+		static void operator delete(void* inObject, size_t inSize) {ObjectPool::deallocate(inObject, inSize);}
+		/*! \brief Allocate object of \c inSize bytes, returning 0 instead of throwing if memory is exhausted.
+		
+		The block comes from the heap, rounded up to its size class, so that the matching operator delete (called if the constructor throws) can free it without knowing its size; it joins the pool once the object is deleted.
+		*/
+		static void* operator new(size_t inSize, const std::nothrow_t&) noexcept {
+			if(inSize > 0 && inSize <= ObjectPool::eMaxSize) inSize = (inSize+ObjectPool::eGranularity-1)/ObjectPool::eGranularity*ObjectPool::eGranularity;
+			return ::operator new(inSize, std::nothrow);
+		}
+		//! Counterpart of the nothrow operator new (called only if the constructor throws).
+		static void operator delete(void* inObject, const std::nothrow_t&) noexcept {::operator delete(inObject);}
+#ifdef __cpp_aligned_new
+		//! Allocate over-aligned object of \c inSize bytes from the heap.
+		static void* operator new(size_t inSize, std::align_val_t inAlign) {return ::operator new(inSize, inAlign);}
+		//! Allocate over-aligned object of \c inSize bytes from the heap, returning 0 instead of throwing if memory is exhausted.
+		static void* operator new(size_t inSize, std::align_val_t inAlign, const std::nothrow_t&) noexcept {return ::operator new(inSize, inAlign, std::nothrow);}
+		//! Release over-aligned object to the heap.
+		static void operator delete(void* inObject, std::align_val_t inAlign) {::operator delete(inObject, inAlign);}
+		//! Counterpart of the nothrow aligned operator new (called only if the constructor throws).
+		static void operator delete(void* inObject, std::align_val_t inAlign, const std::nothrow_t&) noexcept {::operator delete(inObject, inAlign);}
+#endif
+		//! Construct object in place at address \c inPlace.
+		static void* operator new(size_t, void* inPlace) {return inPlace;}
+		//! Counterpart of the placement operator new (does nothing).
+		static void operator delete(void*, void*) {}
+	};
+	
+} // end of PACC namespace
+
+#endif // PACC_ObjectPool_hpp_
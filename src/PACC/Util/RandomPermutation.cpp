@@ -0,0 +1,177 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/Util/RandomPermutation.cpp
+ * \brief Class methods for the random permutation.
+ * \author Marc Parizeau, Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#include "PACC/Util/RandomPermutation.hpp"
+#include "PACC/Threading/ThreadPool.hpp"
+#include <unordered_map>
+
+using namespace std;
+using namespace PACC;
+
+namespace {
+	
+	//! Minimum number of elements per block for a parallel shuffle.
+	const unsigned int cMinBlockSize = 1 << 16;
+	
+	/*! \brief Task for shuffling a block, or merging two adjacent shuffled blocks.
+	
+	If the second block is empty, the task shuffles block [\c mBegin,\c mMiddle[ with the Fisher-Yates algorithm. Otherwise, it merges shuffled blocks [\c mBegin,\c mMiddle[ and [\c mMiddle,\c mEnd[ into a single shuffled block, using the merge procedure of MergeShuffle.
+	*/
+	class ShuffleTask : public Threading::Task {
+	 public:
+		ShuffleTask(void) : mData(0), mBegin(0), mMiddle(0), mEnd(0), mRand(0) {}
+		
+		void set(unsigned int* inData, size_t inBegin, size_t inMiddle, size_t inEnd, Randomizer* inRand) {
+			mData = inData;
+			mBegin = inBegin;
+			mMiddle = inMiddle;
+			mEnd = inEnd;
+			mRand = inRand;
+		}
+		
+		void main(void) {
+			if(mMiddle == mEnd) shuffle();
+			else merge();
+		}
+		
+	 protected:
+		unsigned int* mData; //!< Pointer to permutation data.
+		size_t mBegin; //!< Start of first block.
+		size_t mMiddle; //!< End of first block, start of second block.
+		size_t mEnd; //!< End of second block.
+		Randomizer* mRand; //!< Random number generator of this block.
+		
+		//! Shuffle first block using the Fisher-Yates algorithm.
+		void shuffle(void) {
+			for(size_t i = mBegin+1; i < mMiddle; ++i) {
+				size_t j = mBegin + (*mRand)(i-mBegin+1);
+				if(i != j) swap(mData[i], mData[j]);
+			}
+		}
+		
+		//! Merge both shuffled blocks into a single shuffled block.
+		void merge(void) {
+			size_t i = mBegin, j = mMiddle;
+			unsigned long int lBits = 0;
+			unsigned int lAvailable = 0;
+			// randomly interleave both blocks until one of them is exhausted (one random bit per step)
+			for(;; ++i) {
+				if(lAvailable == 0) {
+					lBits = mRand->getInteger();
+					lAvailable = 32;
+				}
+				bool lFlip = lBits & 1;
+				lBits >>= 1;
+				--lAvailable;
+				if(lFlip) {
+					if(j == mEnd) break;
+					swap(mData[i], mData[j++]);
+				} else if(i == j) break;
+			}
+			// then insert remaining elements with the Fisher-Yates algorithm
+			for(; i < mEnd; ++i) {
+				size_t k = mBegin + (*mRand)(i-mBegin+1);
+				swap(mData[i], mData[k]);
+			}
+		}
+	};
+	
+}
+
+/*! \brief Shuffle permutation randomly using the slave threads of pool \c inPool.
+
+The permutation is split into one block per slave thread (never smaller than 65536 elements). Each block is shuffled by an independent generator seeded from \c inRand, and adjacent blocks are then merged pairwise until a single uniformly shuffled block remains. Merges of a same level run in parallel. For small permutations, or a pool of a single thread, this method reverts to RandomPermutation::permutate.
+
+The resulting permutation differs from the one produced by RandomPermutation::permutate for the same generator state, but it only depends on the state of \c inRand and on the number of slave threads in the pool.
+*/
+RandomPermutation& RandomPermutation::permutateParallel(Threading::ThreadPool& inPool, Randomizer& inRand)
+{
+	size_t lBlocks = inPool.getMaxSlaves();
+	if(size()/cMinBlockSize < lBlocks) lBlocks = size()/cMinBlockSize;
+	if(lBlocks <= 1) return permutate(inRand);
+	// seed an independent generator for each block
+	vector<Randomizer*> lRands(lBlocks);
+	vector<unsigned long int> lSeeds(4);
+	for(size_t i = 0; i < lBlocks; ++i) {
+		for(size_t j = 0; j < lSeeds.size(); ++j) lSeeds[j] = inRand.getInteger();
+		lRands[i] = new Randomizer(lSeeds);
+	}
+	// compute block boundaries
+	vector<size_t> lBounds(lBlocks+1);
+	for(size_t i = 0; i <= lBlocks; ++i) lBounds[i] = (size()*i)/lBlocks;
+	// shuffle each block
+	vector<ShuffleTask> lTasks(lBlocks);
+	for(size_t i = 0; i < lBlocks; ++i) {
+		lTasks[i].set(&(*this)[0], lBounds[i], lBounds[i+1], lBounds[i+1], lRands[i]);
+		inPool.push(lTasks[i]);
+	}
+	for(size_t i = 0; i < lBlocks; ++i) lTasks[i].wait();
+	// merge adjacent blocks pairwise, level by level
+	for(size_t lStep = 1; lStep < lBlocks; lStep *= 2) {
+		size_t lCount = 0;
+		for(size_t i = 0; i+lStep < lBlocks; i += 2*lStep) {
+			size_t lEnd = (i+2*lStep < lBlocks ? lBounds[i+2*lStep] : lBounds[lBlocks]);
+			lTasks[lCount].set(&(*this)[0], lBounds[i], lBounds[i+lStep], lEnd, lRands[i]);
+			inPool.push(lTasks[lCount++]);
+		}
+		for(size_t i = 0; i < lCount; ++i) lTasks[i].wait();
+	}
+	for(size_t i = 0; i < lBlocks; ++i) delete lRands[i];
+	return *this;
+}
+
+/*! \brief Draw \c inK distinct integers from range [0,\c inN[, in random order, using number generator \c inRand.
+
+The sample is returned in vector \c outSample (resized to \c inK). This method simulates the first \c inK steps of a Fisher-Yates shuffle, but only keeps track of the displaced elements in a hash table. Its expected cost is O(\c inK) in time and memory, whatever the value of \c inN. If \c inK is larger than \c inN, it is reduced to \c inN.
+*/
+vector<unsigned int>& RandomPermutation::sample(vector<unsigned int>& outSample, unsigned int inK, unsigned int inN, Randomizer& inRand)
+{
+	if(inK > inN) inK = inN;
+	outSample.resize(inK);
+	unordered_map<unsigned int, unsigned int> lDisplaced;
+	lDisplaced.reserve(inK);
+	for(unsigned int i = 0; i < inK; ++i) {
+		unsigned int j = i + (unsigned int) inRand(inN-i);
+		// value currently at position j (and at position i) of the virtual permutation
+		unordered_map<unsigned int, unsigned int>::iterator lJ = lDisplaced.find(j);
+		unsigned int lValueJ = (lJ == lDisplaced.end() ? j : lJ->second);
+		unordered_map<unsigned int, unsigned int>::iterator lI = lDisplaced.find(i);
+		unsigned int lValueI = (lI == lDisplaced.end() ? i : lI->second);
+		outSample[i] = lValueJ;
+		// position i is never visited again, so only position j needs updating
+		if(j != i) lDisplaced[j] = lValueI;
+	}
+	return outSample;
+}
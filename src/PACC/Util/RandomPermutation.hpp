@@ -44,11 +44,18 @@ namespace PACC {
 	
 	using namespace std;
 	
+	namespace Threading {
+		class ThreadPool;
+	}
+	
 	/*!\brief Random permutation generator.
 	\author Marc Parizeau, Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
 	\ingroup Util
 	
 	A random permutation of size X is a vector that contains integer 0 to X-1 randomly permutated.
+	
+	Method RandomPermutation::permutate shuffles the whole vector using the Fisher-Yates algorithm. When only the first k elements are needed, method RandomPermutation::permutateFirst stops after k steps. Method RandomPermutation::sample draws k distinct integers without materializing the permutation at all. For very large permutations, method RandomPermutation::permutateParallel shuffles independent blocks on a Threading::ThreadPool, and then merges them using the MergeShuffle algorithm of reference:
+	- A. Bacher, O. Bodini, A. Hollender and J. Lumbroso, "MergeShuffle: A Very Fast, Parallel Random Permutation Algorithm", arXiv:1508.03167, 2015.
 	*/
 	class RandomPermutation : public vector<unsigned int> {
 	 public:
@@ -57,12 +64,35 @@ namespace PACC {
 			for(unsigned int i=0; i < inSize; ++i) (*this)[i] = i;
 		}
 		
-		//! Shuffle permutation randomly using number generator \c inRand.
+		/*! \brief Shuffle permutation randomly using number generator \c inRand.
+		
+		For a given generator state, this method produces the same permutation as the former implementation based on std::random_shuffle.
+		*/
 		RandomPermutation &permutate(Randomizer &inRand=PACC::rand) {
-			random_shuffle(begin(), end(), inRand);
+			for(size_type i = 1; i < size(); ++i) {
+				size_type j = inRand(i+1);
+				if(i != j) std::swap((*this)[i], (*this)[j]);
+			}
 			return *this;
 		}
 		
+		/*! \brief Shuffle only the first \c inK elements of the permutation using number generator \c inRand.
+		
+		After this call, the first \c inK elements are a uniformly distributed random sample (in random order) of the whole permutation; the remaining elements are left in an unspecified order. The cost is O(\c inK).
+		*/
+		RandomPermutation &permutateFirst(unsigned int inK, Randomizer &inRand=PACC::rand) {
+			if(inK > size()) inK = size();
+			for(size_type i = 0; i < inK; ++i) {
+				size_type j = i + inRand(size()-i);
+				if(i != j) std::swap((*this)[i], (*this)[j]);
+			}
+			return *this;
+		}
+		
+		RandomPermutation &permutateParallel(Threading::ThreadPool& inPool, Randomizer &inRand=PACC::rand);
+		
+		static vector<unsigned int>& sample(vector<unsigned int>& outSample, unsigned int inK, unsigned int inN, Randomizer &inRand=PACC::rand);
+		
 	};
 	
 } // end of namespace PACC
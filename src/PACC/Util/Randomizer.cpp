@@ -47,13 +47,120 @@
  */
 
 #include "PACC/Util/Randomizer.hpp"
+#include <cmath>
 #include <sstream>
 
 using namespace std;
 using namespace PACC;
 
+unsigned long int Randomizer::smNormalK[128];
+double Randomizer::smNormalW[128];
+double Randomizer::smNormalF[128];
+unsigned long int Randomizer::smExponentialK[256];
+double Randomizer::smExponentialW[256];
+double Randomizer::smExponentialF[256];
+
+namespace PACC {
+	
+	/*! \brief Initializer for the Ziggurat tables of class Randomizer.
+	
+	The tables are computed once at load time, before the global random number generator is constructed. The constants are those of Marsaglia and Tsang (2000) for 128 normal layers and 256 exponential layers.
+	*/
+	class ZigguratTables {
+	 public:
+		ZigguratTables(void) {
+			// normal distribution (128 layers, 31 bits magnitudes)
+			const double lM1 = 2147483648.0;
+			double lDn = 3.442619855899, lTn = lDn;
+			const double lVn = 9.91256303526217e-3;
+			double lQ = lVn/exp(-0.5*lDn*lDn);
+			Randomizer::smNormalK[0] = (unsigned long int) ((lDn/lQ)*lM1);
+			Randomizer::smNormalK[1] = 0;
+			Randomizer::smNormalW[0] = lQ/lM1;
+			Randomizer::smNormalW[127] = lDn/lM1;
+			Randomizer::smNormalF[0] = 1.;
+			Randomizer::smNormalF[127] = exp(-0.5*lDn*lDn);
+			for(int i = 126; i >= 1; --i) {
+				lDn = sqrt(-2.*log(lVn/lDn+exp(-0.5*lDn*lDn)));
+				Randomizer::smNormalK[i+1] = (unsigned long int) ((lDn/lTn)*lM1);
+				lTn = lDn;
+				Randomizer::smNormalF[i] = exp(-0.5*lDn*lDn);
+				Randomizer::smNormalW[i] = lDn/lM1;
+			}
+			// exponential distribution (256 layers, 32 bits magnitudes)
+			const double lM2 = 4294967296.0;
+			double lDe = 7.697117470131487, lTe = lDe;
+			const double lVe = 3.949659822581572e-3;
+			lQ = lVe/exp(-lDe);
+			Randomizer::smExponentialK[0] = (unsigned long int) ((lDe/lQ)*lM2);
+			Randomizer::smExponentialK[1] = 0;
+			Randomizer::smExponentialW[0] = lQ/lM2;
+			Randomizer::smExponentialW[255] = lDe/lM2;
+			Randomizer::smExponentialF[0] = 1.;
+			Randomizer::smExponentialF[255] = exp(-lDe);
+			for(int i = 254; i >= 1; --i) {
+				lDe = -log(lVe/lDe+exp(-lDe));
+				Randomizer::smExponentialK[i+1] = (unsigned long int) ((lDe/lTe)*lM2);
+				lTe = lDe;
+				Randomizer::smExponentialF[i] = exp(-lDe);
+				Randomizer::smExponentialW[i] = lDe/lM2;
+			}
+		}
+	};
+	
+	static ZigguratTables gZigguratTables; //!< Compute tables before any generator is used.
+	
+}
+
 Randomizer PACC::rand;
 
+/*! \brief Handle the slow path of the exponential Ziggurat.
+
+Argument \c inValue is the rejected 32 bits integer and \c inLayer its layer. The base layer samples the tail directly; other layers accept or reject the wedge point against the exact density, drawing a new integer until one is accepted.
+*/
+double Randomizer::getExponentialTail(unsigned long int inValue, unsigned int inLayer)
+{
+	for(;;) {
+		// base layer: sample from the tail beyond the last layer
+		if(inLayer == 0) return 7.697117470131487 - log(randDblExc());
+		// wedge: accept against the exact density
+		double lX = inValue*smExponentialW[inLayer];
+		if(smExponentialF[inLayer]+randDblExc()*(smExponentialF[inLayer-1]-smExponentialF[inLayer]) < exp(-lX)) return lX;
+		// draw again
+		inValue = randInt();
+		inLayer = inValue & 255;
+		if(inValue < smExponentialK[inLayer]) return inValue*smExponentialW[inLayer];
+	}
+}
+
+/*! \brief Handle the slow path of the normal Ziggurat.
+
+Argument \c inValue is the rejected signed 32 bits integer and \c inLayer its layer. The base layer samples the tail with Marsaglia's method; other layers accept or reject the wedge point against the exact density, drawing a new integer until one is accepted.
+*/
+double Randomizer::getGaussianTail(int inValue, unsigned int inLayer)
+{
+	const double lR = 3.442619855899;
+	for(;;) {
+		double lX = inValue*smNormalW[inLayer];
+		if(inLayer == 0) {
+			// base layer: sample from the tail beyond lR
+			double lY;
+			do {
+				lX = -log(randDblExc())/lR;
+				lY = -log(randDblExc());
+			} while(lY+lY < lX*lX);
+			return (inValue > 0 ? lR+lX : -lR-lX);
+		}
+		// wedge: accept against the exact density
+		if(smNormalF[inLayer]+randDblExc()*(smNormalF[inLayer-1]-smNormalF[inLayer]) < exp(-0.5*lX*lX)) return lX;
+		// draw again
+		inValue = (int) randInt();
+		inLayer = inValue & 127;
+		unsigned int lAbs = (inValue < 0 ? 0U-(unsigned int)inValue : (unsigned int)inValue);
+		if(lAbs < smNormalK[inLayer]) return inValue*smNormalW[inLayer];
+	}
+}
+
 /*! Return state of generator.
 */
 string Randomizer::getState(void) const
@@ -54,7 +54,12 @@ namespace PACC {
 	 
 	 Its implementation is based on the \c %MTRand class by Richard J. Wagner <http://www-personal.engin.umich.edu/~wagnerr/MersenneTwister.html>
 	 
-	 It can generate uniformly distributed booleans, integers and floats, or gaussian distributed floats.
+	 It can generate uniformly distributed booleans, integers and floats, or gaussian and exponentially distributed floats.
+	 
+	 Method Randomizer::getGaussian uses the Box-Muller transform of the original %MTRand class. Methods Randomizer::getGaussianFast and Randomizer::getExponential use instead the Ziggurat method of Marsaglia and Tsang, with precomputed tables that are shared by all generators:
+	 - G. Marsaglia and W.W. Tsang, "The Ziggurat Method for Generating Random Variables", Journal of Statistical Software, Vol. 5, No. 8, 2000, pp 1-7.
+	 
+	 With the Ziggurat method, about 99% of samples cost a single 32 bits integer, a table lookup and a multiplication; the others fall back to an exact rejection step. The two gaussian methods do not produce the same sequence for a given seed.
 	 */
 	class Randomizer : protected MTRand {
 	 public:
@@ -94,11 +99,44 @@ namespace PACC {
 		//! Return a gaussian distributed random float with mean \c inMean and standard deviation \c inStdDev. Default is N(0,1).
 		double getGaussian(const double& inMean=0, const double& inStdDev=1) {return randNorm(inMean, inStdDev);}
 		
+		/*! \brief Return a gaussian distributed random float with mean \c inMean and standard deviation \c inStdDev, using the Ziggurat method. Default is N(0,1).
+		
+		This method is several times faster than Randomizer::getGaussian, but it does not produce the same sequence of numbers for a given seed.
+		*/
+		double getGaussianFast(const double& inMean=0, const double& inStdDev=1) {
+			int lValue = (int) randInt();
+			unsigned int lLayer = lValue & 127;
+			unsigned int lAbs = (lValue < 0 ? 0U-(unsigned int)lValue : (unsigned int)lValue);
+			if(lAbs < smNormalK[lLayer]) return inMean + inStdDev*(lValue*smNormalW[lLayer]);
+			return inMean + inStdDev*getGaussianTail(lValue, lLayer);
+		}
+		
+		//! Return an exponentially distributed random float with rate \c inRate (mean 1/\c inRate), using the Ziggurat method. Default rate is 1.
+		double getExponential(const double& inRate=1) {
+			unsigned long int lValue = randInt();
+			unsigned int lLayer = lValue & 255;
+			if(lValue < smExponentialK[lLayer]) return lValue*smExponentialW[lLayer]/inRate;
+			return getExponentialTail(lValue, lLayer)/inRate;
+		}
+		
 		//! Return state of generator.
 		string getState(void) const;
 		//! Set state of generator.
 		void setState(const string& inState);
 		
+	 protected:
+		static unsigned long int smNormalK[128]; //!< Ziggurat layer thresholds for the normal distribution.
+		static double smNormalW[128]; //!< Ziggurat layer widths for the normal distribution.
+		static double smNormalF[128]; //!< Ziggurat layer densities for the normal distribution.
+		static unsigned long int smExponentialK[256]; //!< Ziggurat layer thresholds for the exponential distribution.
+		static double smExponentialW[256]; //!< Ziggurat layer widths for the exponential distribution.
+		static double smExponentialF[256]; //!< Ziggurat layer densities for the exponential distribution.
+		
+		double getExponentialTail(unsigned long int inValue, unsigned int inLayer);
+		double getGaussianTail(int inValue, unsigned int inLayer);
+		
+		friend class ZigguratTables;
+		
 	};
 
 	extern Randomizer rand; //!< Global random number generator
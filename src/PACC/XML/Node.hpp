@@ -36,6 +36,7 @@
 #ifndef PACC_XML_Node_hpp_
 #define PACC_XML_Node_hpp_
 
+#include "PACC/Util/ObjectPool.hpp"
 #include "PACC/Util/Tokenizer.hpp"
 #include "PACC/XML/Attribute.hpp"
 #include <map>
@@ -78,9 +79,9 @@ namespace PACC {
 			
 			Markup data elements can have content represented by child nodes. A Node can parse itself from a stream Tokenizer. Any parse error throws a \c runtime_error exception. Method Node::getFirstChild is used to retrieve an Iterator on the first child of this node. Method Node::getParent is used to retrieve an Iterator on the parent of this node. An Iterator is used to iterate on sibling nodes.
 			
-			Nodes are also derived from a map of attribute name/value pairs that can be fetched and set using methods Node::getAttribute and Node::setAttribute. Finally, a node can serialize itself into an %XML Streamer.
+			Nodes are also derived from a map of attribute name/value pairs that can be fetched and set using methods Node::getAttribute and Node::setAttribute. Finally, a node can serialize itself into an %XML Streamer. Nodes are allocated from a thread caching ObjectPool, since parsing and building documents create and delete many of them. Since the destructor is not virtual, a class derived from Node must never be deleted through a pointer to Node (the tree deletes its children that way): nodes should not be subclassed.
 			*/
-		class Node : public AttributeList {
+		class Node : public AttributeList, public Pooled<Node> {
 			public:
 			//! Construct empty root node.
 			Node(void);
@@ -94,7 +95,7 @@ namespace PACC {
 			//! Copy constructor: make deep copy of node \c inNode.
 			Node(const Node& inNode);
 			
-			//! Delete the sub-tree rooted by this node.
+			//! Delete the sub-tree rooted by this node (not virtual: see class Node).
 			~Node(void);
 			
 			//! Make deep copy of the sub-tree rooted by node \c inRoot. 
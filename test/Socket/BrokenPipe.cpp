@@ -0,0 +1,101 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/test/Socket/BrokenPipe.cpp
+ * \brief Regression test: concurrent non-blocking sends on broken connections.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#include "PACC/Socket/TCP.hpp"
+#include <atomic>
+#include <csignal>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace std;
+using namespace PACC;
+
+namespace {
+
+	const unsigned int cThreads = 4; //!< Number of sending threads.
+	const unsigned int cSends = 20000; //!< Number of sends per thread.
+
+	//! %TCP socket that exposes the non-blocking operations of class Socket::Port.
+	class TestSocket : public Socket::TCP {
+		public:
+		explicit TestSocket(int inDescriptor) : TCP(inDescriptor) {}
+		using Port::trySend;
+		using Port::tryReceive;
+	};
+
+	int fail(const char* inMessage)
+	{
+		cerr << "BrokenPipe: " << inMessage << endl;
+		return 1;
+	}
+
+}
+
+/*!
+Threads that send on connections closed by their peer, with the default SIGPIPE handler (which terminates the process), must get a Socket::Exception with code eConnectionClosed. The process-wide handler must be left untouched, so that the sends of other threads are never exposed to the signal.
+ */
+int main(void)
+{
+	::signal(SIGPIPE, SIG_DFL);
+	atomic<unsigned int> lClosed(0), lOther(0);
+	vector<thread> lThreads;
+	for(unsigned int t = 0; t < cThreads; ++t) lThreads.push_back(thread([&]() {
+		for(unsigned int i = 0; i < cSends; ++i) {
+			int lPair[2];
+			if(::socketpair(AF_UNIX, SOCK_STREAM, 0, lPair) != 0) {
+				++lOther;
+				return;
+			}
+			::close(lPair[1]);
+			TestSocket lSocket(lPair[0]);
+			try {
+				lSocket.trySend("x", 1);
+				++lOther;
+			} catch(const Socket::Exception& inError) {
+				if(inError.getErrorCode() == Socket::eConnectionClosed) ++lClosed;
+				else ++lOther;
+			}
+		}
+	}));
+	for(unsigned int t = 0; t < cThreads; ++t) lThreads[t].join();
+	if(lOther.load() > 0) return fail("send on a broken connection did not fail with eConnectionClosed");
+	if(lClosed.load() != cThreads*cSends) return fail("sends were lost");
+	if(::signal(SIGPIPE, SIG_DFL) != SIG_DFL) return fail("SIGPIPE handler was changed");
+	cout << "BrokenPipe: passed" << endl;
+	return 0;
+}
@@ -0,0 +1,111 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/test/Socket/PortClose.cpp
+ * \brief Regression test: closing a socket with pending watches of the default poller.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#include "PACC/Socket/UDP.hpp"
+#include "PACC/Socket/Poller.hpp"
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+using namespace std;
+using namespace PACC;
+
+namespace {
+
+	//! %UDP socket that exposes the protected operations of class Socket::Port.
+	class TestSocket : public Socket::UDP {
+	 public:
+		using Port::bind;
+		using Port::close;
+		using Port::receive;
+	};
+
+	//! Return whether flag \c inFlag becomes true within about one second.
+	bool waitFor(const atomic<bool>& inFlag)
+	{
+		for(int i = 0; i < 1000 && !inFlag.load(); ++i) this_thread::sleep_for(chrono::milliseconds(1));
+		return inFlag.load();
+	}
+
+	int fail(const char* inMessage)
+	{
+		cerr << "PortClose: " << inMessage << endl;
+		return 1;
+	}
+
+}
+
+/*!
+A pending receive (a readable watch on an idle socket) must be resumed when the socket is closed, so that it fails with eBadDescriptor instead of hanging. The descriptor number is then reused by a new socket, which must be watchable without interference from the stale watch.
+ */
+int main(void)
+{
+	try {
+		Socket::Poller& lPoller = Socket::Poller::getDefault();
+		TestSocket lSocket;
+		lSocket.bind(0);
+		int lDescriptor = lSocket.getDescriptor();
+
+		atomic<bool> lResumed(false);
+		bool lFailed = false;
+		lPoller.watch(lDescriptor, Socket::Poller::eReadable, [&]() {
+			// what a suspended receive does when resumed
+			try {
+				char lBuffer[16];
+				lSocket.receive(lBuffer, sizeof(lBuffer));
+			} catch(const Socket::Exception& inError) {
+				lFailed = (inError.getErrorCode() == Socket::eBadDescriptor);
+			}
+			lResumed.store(true);
+		});
+		lSocket.close();
+		if(!lResumed.load()) return fail("pending watch was not resumed by close()");
+		if(!lFailed) return fail("resumed receive did not fail with eBadDescriptor");
+
+		TestSocket lReused;
+		lReused.bind(0);
+		if(lReused.getDescriptor() != lDescriptor) cerr << "PortClose: descriptor was not reused (test is weaker)" << endl;
+		atomic<bool> lReadable(false);
+		lPoller.watch(lReused.getDescriptor(), Socket::Poller::eReadable, [&]() {lReadable.store(true);});
+		if(lReadable.load()) return fail("watch of reused descriptor fired early");
+		lReused.sendDatagram("ping", Socket::Address(lReused.getSockAddress().getPortNumber(), "127.0.0.1"));
+		if(!waitFor(lReadable)) return fail("watch of reused descriptor did not fire");
+	} catch(const Socket::Exception& inError) {
+		return fail(inError.getMessage().c_str());
+	}
+	cout << "PortClose: passed" << endl;
+	return 0;
+}
@@ -0,0 +1,92 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/test/Threading/AtomicSemaphore.cpp
+ * \brief Regression test: counting and wake-ups of class Threading::AtomicSemaphore.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#include "PACC/Threading/AtomicSemaphore.hpp"
+#include "PACC/Util/Timer.hpp"
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace PACC;
+
+namespace {
+
+	const unsigned int cPosts = 50000; //!< Number of resources posted by each producer.
+
+	int fail(const char* inMessage)
+	{
+		cerr << "AtomicSemaphore: " << inMessage << endl;
+		return 1;
+	}
+
+}
+
+/*!
+Consumers that block on an exhausted semaphore must all be woken up by the posts of the producers, and acquire exactly the posted resources. A timed wait must time out when no resource is posted.
+ */
+int main(void)
+{
+	Threading::AtomicSemaphore lSemaphore;
+	if(lSemaphore.tryWait()) return fail("tryWait acquired a resource of an empty semaphore");
+	Timer lTimer;
+	if(lSemaphore.wait(0.05)) return fail("timed wait acquired a resource of an empty semaphore");
+	if(lTimer.getValue() < 0.04) return fail("timed wait returned before its time out");
+
+	const unsigned int lProducers = 3, lConsumers = 4;
+	atomic<unsigned int> lAcquired(0);
+	vector<thread> lThreads;
+	for(unsigned int c = 0; c < lConsumers; ++c) lThreads.push_back(thread([&]() {
+		while(lAcquired.load() < lProducers*cPosts) {
+			// the time out lets consumers leave once all resources were taken by others
+			if(lSemaphore.wait(0.05)) ++lAcquired;
+		}
+	}));
+	for(unsigned int p = 0; p < lProducers; ++p) lThreads.push_back(thread([&]() {
+		// post single resources and batches of 2 and 3
+		for(unsigned int lPosted = 0, i = 0; lPosted < cPosts; ++i) {
+			unsigned int lCount = 1 + i%3;
+			if(lCount > cPosts-lPosted) lCount = cPosts-lPosted;
+			lSemaphore.post(lCount);
+			lPosted += lCount;
+		}
+	}));
+	for(size_t i = 0; i < lThreads.size(); ++i) lThreads[i].join();
+	if(lAcquired.load() != lProducers*cPosts) return fail("acquired resources differ from posted resources");
+	if(lSemaphore.getCount() != 0) return fail("resources are left in the semaphore");
+	cout << "AtomicSemaphore: passed" << endl;
+	return 0;
+}
@@ -0,0 +1,139 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/test/Threading/BarrierLatch.cpp
+ * \brief Regression test: phases of class Threading::Barrier, and opening of class Threading::Latch.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#include "PACC/Threading/Barrier.hpp"
+#include "PACC/Threading/Latch.hpp"
+#include "PACC/Threading/ThreadPool.hpp"
+#include <atomic>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace PACC;
+
+namespace {
+
+	const unsigned int cPhases = 2000; //!< Number of barrier phases.
+
+	int fail(const char* inMessage)
+	{
+		cerr << "BarrierLatch: " << inMessage << endl;
+		return 1;
+	}
+
+	//! Task that counts down a latch.
+	class CountDownTask : public Threading::Task {
+		public:
+		CountDownTask(Threading::Latch& inLatch, atomic<unsigned int>& ioRuns) : mLatch(inLatch), mRuns(ioRuns) {}
+		protected:
+		Threading::Latch& mLatch; //!< Latch to count down.
+		atomic<unsigned int>& mRuns; //!< Number of executed tasks.
+		void main(void) {
+			++mRuns;
+			mLatch.countDown();
+		}
+	};
+
+	/*! Task that pushes subtasks onto its own pool and waits for them on a latch.
+	
+	With a single slave, the subtasks can only run if the waiting slave executes them itself.
+	*/
+	class ParentTask : public Threading::Task {
+		public:
+		ParentTask(Threading::ThreadPool& inPool) : mPool(inPool), mRuns(0), mOpened(false) {}
+		Threading::ThreadPool& mPool; //!< Pool of the task.
+		atomic<unsigned int> mRuns; //!< Number of executed subtasks.
+		bool mOpened; //!< Latch was opened.
+		protected:
+		void main(void) {
+			Threading::Latch lLatch(10);
+			for(unsigned int i = 0; i < 10; ++i) mPool.pushDetached(new CountDownTask(lLatch, mRuns));
+			mOpened = lLatch.wait();
+		}
+	};
+
+}
+
+/*!
+Barrier participants must never overtake each other by a phase, and exactly one of them must be elected per phase. A latch must stay closed until fully counted down, and a slave that waits on a latch must run the tasks that will open it.
+ */
+int main(void)
+{
+	// barrier phases
+	{
+		const unsigned int lThreads = 4;
+		Threading::Barrier lBarrier(lThreads);
+		vector<unsigned int> lSlots(lThreads, 0);
+		atomic<unsigned int> lElected(0), lOvertaken(0);
+		vector<thread> lParticipants;
+		for(unsigned int t = 0; t < lThreads; ++t) lParticipants.push_back(thread([&, t]() {
+			for(unsigned int lPhase = 1; lPhase <= cPhases; ++lPhase) {
+				lSlots[t] = lPhase;
+				if(lBarrier.wait()) ++lElected;
+				for(unsigned int i = 0; i < lThreads; ++i) if(lSlots[i] < lPhase) ++lOvertaken;
+				// nobody writes the slots of the next phase before everybody has read them
+				if(lBarrier.wait()) ++lElected;
+			}
+		}));
+		for(unsigned int t = 0; t < lThreads; ++t) lParticipants[t].join();
+		if(lOvertaken.load() > 0) return fail("a participant left the barrier before all arrived");
+		if(lElected.load() != 2*cPhases) return fail("not exactly one participant was elected per phase");
+		if(lBarrier.getPhase() != 2*cPhases) return fail("wrong number of completed phases");
+	}
+
+	// latch
+	{
+		Threading::Latch lLatch(3);
+		if(lLatch.tryWait() || lLatch.wait(0.02)) return fail("closed latch did not block");
+		lLatch.countDown(2);
+		if(lLatch.getCount() != 1 || lLatch.wait(0.01)) return fail("latch opened before its count reached zero");
+		thread lOpener([&]() {lLatch.countDown();});
+		if(!lLatch.wait()) return fail("latch did not open");
+		lOpener.join();
+		if(!lLatch.tryWait() || !lLatch.wait(0.01)) return fail("open latch blocked");
+	}
+
+	// waiting slave helps its pool
+	{
+		Threading::ThreadPool lPool(1);
+		ParentTask lParent(lPool);
+		lPool.push(lParent);
+		lParent.wait();
+		if(!lParent.mOpened || lParent.mRuns.load() != 10) return fail("waiting slave did not run the tasks of its pool");
+	}
+	cout << "BarrierLatch: passed" << endl;
+	return 0;
+}
@@ -0,0 +1,163 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/test/Threading/Cancellation.cpp
+ * \brief Regression test: cancellation of queued and running tasks with class Threading::CancellationSource.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#include "PACC/Threading/CancellationToken.hpp"
+#include "PACC/Threading/Exception.hpp"
+#include "PACC/Threading/Latch.hpp"
+#include "PACC/Threading/ThreadPool.hpp"
+#include <atomic>
+#include <iostream>
+#include <vector>
+
+using namespace std;
+using namespace PACC;
+
+namespace {
+
+	int fail(const char* inMessage)
+	{
+		cerr << "Cancellation: " << inMessage << endl;
+		return 1;
+	}
+
+	//! Task that blocks until a latch opens.
+	class GatedTask : public Threading::Task {
+		public:
+		explicit GatedTask(Threading::Latch& inGate) : mGate(inGate) {}
+		protected:
+		Threading::Latch& mGate; //!< Latch that releases the task.
+		void main(void) {mGate.wait();}
+	};
+
+	//! Task that counts its executions.
+	class CountTask : public Threading::Task {
+		public:
+		explicit CountTask(atomic<unsigned int>& ioRuns) : mRuns(ioRuns) {}
+		protected:
+		atomic<unsigned int>& mRuns; //!< Number of executions.
+		void main(void) {++mRuns;}
+	};
+
+	//! Task that runs until it is canceled.
+	class PollingTask : public Threading::Task {
+		public:
+		explicit PollingTask(Threading::Latch& inStarted) : mStarted(inStarted) {}
+		protected:
+		Threading::Latch& mStarted; //!< Latch opened when the task starts.
+		void main(void) {
+			mStarted.countDown();
+			while(!isCanceled()) Threading::Thread::sleep(0.001);
+		}
+	};
+
+}
+
+/*!
+Tasks and functions whose token is canceled before they start must be skipped, and completed as such; a running task must observe the cancellation of its token. Canceling a parent source cancels its children, but not the reverse.
+ */
+int main(void)
+{
+	Threading::ThreadPool lPool(1);
+
+	// queued tasks are skipped
+	{
+		Threading::Latch lGate(1);
+		GatedTask lBlocker(lGate);
+		lPool.push(lBlocker);
+		Threading::CancellationSource lSource;
+		atomic<unsigned int> lRuns(0);
+		vector<CountTask*> lTasks;
+		for(unsigned int i = 0; i < 10; ++i) {
+			lTasks.push_back(new CountTask(lRuns));
+			lTasks.back()->setCancellationToken(lSource.getToken());
+			lPool.push(*lTasks.back());
+		}
+		CountTask lOther(lRuns);
+		lPool.push(lOther);
+		Threading::Future<int> lResult = lPool.submit([]() {return 42;}, lSource.getToken());
+		lSource.cancel();
+		lGate.countDown();
+		bool lCanceled = false;
+		try {
+			lResult.get();
+		} catch(Threading::Exception& inError) {
+			lCanceled = (inError.getErrorCode() == Threading::eCanceled);
+		}
+		lOther.wait();
+		for(size_t i = 0; i < lTasks.size(); ++i) {
+			lTasks[i]->wait();
+			if(!lTasks[i]->isCompleted() || !lTasks[i]->isSkipped()) return fail("canceled task was not completed as skipped");
+			delete lTasks[i];
+		}
+		lBlocker.wait();
+		if(lRuns.load() != 1) return fail("canceled tasks were run, or the other task was not");
+		if(lOther.isSkipped()) return fail("task without token was skipped");
+		if(!lCanceled) return fail("canceled function did not fail with eCanceled");
+	}
+
+	// running tasks observe their token
+	{
+		Threading::Latch lStarted(1);
+		PollingTask lTask(lStarted);
+		Threading::CancellationSource lSource;
+		lTask.setCancellationToken(lSource.getToken());
+		lPool.push(lTask);
+		lStarted.wait();
+		lSource.cancel();
+		lTask.wait();
+		if(lTask.isSkipped()) return fail("running task was marked as skipped");
+	}
+
+	// parent and child sources
+	{
+		Threading::CancellationSource lParent;
+		Threading::CancellationSource lChild(lParent.getToken());
+		Threading::CancellationSource lSibling(lParent.getToken());
+		lChild.cancel();
+		if(lParent.isCanceled() || lSibling.isCanceled()) return fail("canceling a child canceled its parent");
+		lParent.cancel();
+		if(!lSibling.isCanceled() || !lSibling.getToken().isCanceled()) return fail("canceling a parent did not cancel its children");
+		bool lThrown = false;
+		try {
+			lSibling.getToken().throwIfCanceled();
+		} catch(Threading::Exception& inError) {
+			lThrown = (inError.getErrorCode() == Threading::eCanceled);
+		}
+		if(!lThrown) return fail("throwIfCanceled did not throw eCanceled");
+		if(Threading::CancellationToken().canBeCanceled()) return fail("default token can be canceled");
+	}
+	cout << "Cancellation: passed" << endl;
+	return 0;
+}
@@ -0,0 +1,122 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/test/Threading/Channel.cpp
+ * \brief Regression test: delivery of values through class Threading::Channel, with close.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#include "PACC/Threading/Channel.hpp"
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace PACC;
+
+namespace {
+
+	const unsigned int cCount = 100000; //!< Number of values per producer.
+
+	int fail(const char* inMessage)
+	{
+		cerr << "Channel: " << inMessage << endl;
+		return 1;
+	}
+
+}
+
+/*!
+A small channel forces producers and consumers to block on each other. Every value must be delivered exactly once, in the order of its producer, and the consumers must return once the channel is closed and drained.
+ */
+int main(void)
+{
+	// single producer and single consumer, with single and batch operations
+	{
+		Threading::Channel<unsigned int> lChannel(16);
+		thread lProducer([&]() {
+			unsigned int lBatch[7];
+			for(unsigned int i = 0; i < cCount;) {
+				if(i % 3 == 0 && i+7 <= cCount) {
+					for(unsigned int j = 0; j < 7; ++j) lBatch[j] = i+j;
+					i += lChannel.pushN(lBatch, 7);
+				}
+				else if(lChannel.push(i)) ++i;
+			}
+			lChannel.close();
+		});
+		unsigned int lExpected = 0, lValue;
+		bool lOrdered = true;
+		while(lChannel.pop(lValue)) {
+			if(lValue != lExpected) lOrdered = false;
+			++lExpected;
+		}
+		lProducer.join();
+		if(!lOrdered) return fail("SPSC values were delivered out of order");
+		if(lExpected != cCount) return fail("SPSC values were lost");
+		if(lChannel.push(0) || lChannel.tryPush(0)) return fail("push succeeded on a closed channel");
+		if(lChannel.pop(lValue, 0.01)) return fail("pop succeeded on a closed and empty channel");
+	}
+
+	// several producers and consumers
+	{
+		const unsigned int lProducers = 3, lConsumers = 3;
+		Threading::Channel<unsigned int, Threading::MPMCQueue<unsigned int> > lChannel(64);
+		vector<vector<unsigned int> > lReceived(lConsumers);
+		vector<thread> lThreads;
+		for(unsigned int c = 0; c < lConsumers; ++c) lThreads.push_back(thread([&, c]() {
+			unsigned int lValue;
+			while(lChannel.pop(lValue)) lReceived[c].push_back(lValue);
+		}));
+		vector<thread> lSenders;
+		for(unsigned int p = 0; p < lProducers; ++p) lSenders.push_back(thread([&, p]() {
+			for(unsigned int i = 0; i < cCount; ++i) lChannel.push(p*cCount+i);
+		}));
+		for(unsigned int p = 0; p < lProducers; ++p) lSenders[p].join();
+		lChannel.close();
+		for(unsigned int c = 0; c < lConsumers; ++c) lThreads[c].join();
+
+		vector<unsigned char> lSeen(lProducers*cCount, 0);
+		for(unsigned int c = 0; c < lConsumers; ++c) {
+			vector<long> lLast(lProducers, -1);
+			for(size_t i = 0; i < lReceived[c].size(); ++i) {
+				unsigned int lValue = lReceived[c][i];
+				if(lValue >= lProducers*cCount) return fail("MPMC value was corrupted");
+				if(lSeen[lValue]++) return fail("MPMC value was delivered twice");
+				// values of a producer reach every consumer in the order they were pushed
+				if((long) (lValue % cCount) <= lLast[lValue/cCount]) return fail("MPMC values of a producer were reordered");
+				lLast[lValue/cCount] = lValue % cCount;
+			}
+		}
+		for(size_t i = 0; i < lSeen.size(); ++i) if(!lSeen[i]) return fail("MPMC value was lost");
+	}
+	cout << "Channel: passed" << endl;
+	return 0;
+}
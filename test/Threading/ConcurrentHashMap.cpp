@@ -0,0 +1,130 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/test/Threading/ConcurrentHashMap.cpp
+ * \brief Regression test: deduplicated computations and bounded size of class Threading::ConcurrentHashMap.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#include "PACC/Threading/ConcurrentHashMap.hpp"
+#include "PACC/Threading/Thread.hpp"
+#include <atomic>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace PACC;
+
+namespace {
+
+	int fail(const char* inMessage)
+	{
+		cerr << "ConcurrentHashMap: " << inMessage << endl;
+		return 1;
+	}
+
+}
+
+/*!
+Concurrent misses of the same key must compute its value once, and share its result or exception. A bounded map must never hold more elements than its bound, whatever its number of segments, and its CLOCK eviction must keep the elements that are read between insertions.
+ */
+int main(void)
+{
+	// deduplication of concurrent computations
+	{
+		Threading::ConcurrentHashMap<int, int> lMap;
+		atomic<unsigned int> lCalls(0), lWrong(0);
+		vector<thread> lThreads;
+		for(unsigned int t = 0; t < 16; ++t) lThreads.push_back(thread([&]() {
+			for(int lKey = 0; lKey < 10; ++lKey) {
+				int lValue = lMap.getOrCompute(lKey, [&]() {
+					++lCalls;
+					// long enough for the other threads to miss the same key
+					Threading::Thread::sleep(0.01);
+					return lKey*2;
+				});
+				if(lValue != lKey*2) ++lWrong;
+			}
+		}));
+		for(size_t i = 0; i < lThreads.size(); ++i) lThreads[i].join();
+		if(lWrong.load() > 0) return fail("getOrCompute returned a wrong value");
+		if(lCalls.load() != 10) return fail("a value was computed more than once");
+	}
+
+	// exceptions are shared by the waiting threads, and not cached
+	{
+		Threading::ConcurrentHashMap<int, int> lMap;
+		atomic<unsigned int> lCalls(0), lThrown(0);
+		vector<thread> lThreads;
+		for(unsigned int t = 0; t < 8; ++t) lThreads.push_back(thread([&]() {
+			try {
+				lMap.getOrCompute(99, [&]() -> int {
+					++lCalls;
+					Threading::Thread::sleep(0.01);
+					throw runtime_error("computation failure");
+				});
+			} catch(const runtime_error&) {
+				++lThrown;
+			}
+		}));
+		for(size_t i = 0; i < lThreads.size(); ++i) lThreads[i].join();
+		if(lThrown.load() != 8) return fail("exception of a computation was not thrown to every caller");
+		if(lCalls.load() > 8 || lMap.contains(99)) return fail("failed computation was cached");
+		if(lMap.getOrCompute(99, []() {return 5;}) != 5) return fail("failed computation was not retried");
+	}
+
+	// bounded size, with more segments than elements
+	{
+		size_t lBounds[] = {1, 3, 10, 100, 1000};
+		for(size_t i = 0; i < sizeof(lBounds)/sizeof(lBounds[0]); ++i) {
+			Threading::ConcurrentHashMap<int, int> lMap(lBounds[i], 64);
+			for(int lKey = 0; lKey < 100000; ++lKey) lMap.set(lKey, lKey);
+			if(lMap.size() > lBounds[i]) return fail("bounded map holds more elements than its bound");
+			if(lMap.empty()) return fail("bounded map holds no element");
+		}
+	}
+
+	// CLOCK eviction keeps the elements that are read between insertions
+	{
+		Threading::ConcurrentHashMap<int, int> lMap(64, 1);
+		for(int lKey = 0; lKey < 64; ++lKey) lMap.set(lKey, lKey);
+		int lValue;
+		for(int lKey = 1000; lKey < 2000; ++lKey) {
+			for(int lHot = 0; lHot < 32; ++lHot) lMap.find(lHot, lValue);
+			lMap.set(lKey, lKey);
+		}
+		if(lMap.size() != 64) return fail("full bounded map does not hold its bound");
+		for(int lHot = 0; lHot < 32; ++lHot) if(!lMap.find(lHot, lValue) || lValue != lHot) return fail("referenced element was evicted");
+	}
+	cout << "ConcurrentHashMap: passed" << endl;
+	return 0;
+}
@@ -0,0 +1,135 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/test/Threading/Pipeline.cpp
+ * \brief Regression test: ordering, token bound and failures of class Threading::Pipeline.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#include "PACC/Threading/Pipeline.hpp"
+#include <atomic>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+using namespace PACC;
+
+namespace {
+
+	const unsigned long cCount = 20000; //!< Number of items produced by the source.
+	const unsigned int cTokens = 4; //!< Number of tokens of the pipeline.
+
+	int fail(const char* inMessage)
+	{
+		cerr << "Pipeline: " << inMessage << endl;
+		return 1;
+	}
+
+	//! Spin for a duration that depends on \c inValue, so that parallel items finish out of order.
+	unsigned long jitter(unsigned long inValue)
+	{
+		volatile unsigned long lSum = 0;
+		for(unsigned long i = 0; i < (inValue*7919) % 2000; ++i) lSum = lSum + i;
+		return lSum;
+	}
+
+}
+
+/*!
+Items go through a parallel stage, where they finish out of order, and must reach an in-order serial sink in source order, with no more items in flight than tokens. A failing stage must stop the pipeline, have its exception thrown by Pipeline::run, and not count the failed item as processed.
+ */
+int main(void)
+{
+	Threading::ThreadPool lPool(4);
+	atomic<long> lInFlight(0), lMaxInFlight(0);
+
+	{
+		Threading::Pipeline lPipeline(lPool, cTokens);
+		unsigned long lNext = 0;
+		lPipeline.addSource<unsigned long>([&](Threading::Pipeline::Control& ioControl) {
+			if(lNext == cCount) {
+				ioControl.stop();
+				return 0UL;
+			}
+			long lCount = ++lInFlight;
+			long lMax = lMaxInFlight.load();
+			while(lCount > lMax && !lMaxInFlight.compare_exchange_weak(lMax, lCount));
+			return lNext++;
+		});
+		lPipeline.addStage<unsigned long, vector<unsigned long> >(Threading::Pipeline::eParallel, [](unsigned long inValue) {
+			jitter(inValue);
+			// larger than the token buffer: stored on the heap
+			return vector<unsigned long>(10, inValue);
+		});
+		vector<unsigned long> lReceived;
+		lPipeline.addSink<vector<unsigned long> >(Threading::Pipeline::eSerialInOrder, [&](vector<unsigned long> inValues) {
+			lReceived.push_back(inValues[9]);
+			--lInFlight;
+		});
+		for(unsigned int lRun = 0; lRun < 2; ++lRun) {
+			lNext = 0;
+			lReceived.clear();
+			lPipeline.run();
+			if(lReceived.size() != cCount) return fail("items were lost");
+			for(unsigned long i = 0; i < cCount; ++i) if(lReceived[i] != i) return fail("in-order sink received items out of source order");
+			if(lPipeline.getStatistics(0).mItems != cCount || lPipeline.getStatistics(2).mItems != cCount) return fail("wrong number of processed items in statistics");
+		}
+		if(lMaxInFlight.load() > (long) cTokens) return fail("more items in flight than tokens");
+	}
+
+	{
+		Threading::Pipeline lPipeline(lPool, cTokens);
+		unsigned long lNext = 0;
+		atomic<unsigned long> lSunk(0), lPassed(0);
+		lPipeline.addSource<unsigned long>([&](Threading::Pipeline::Control& ioControl) {
+			if(lNext == cCount) ioControl.stop();
+			return lNext++;
+		});
+		lPipeline.addStage<unsigned long, unsigned long>(Threading::Pipeline::eParallel, [&](unsigned long inValue) {
+			if(inValue == 1000) throw runtime_error("stage failure");
+			++lPassed;
+			return inValue;
+		});
+		lPipeline.addSink<unsigned long>(Threading::Pipeline::eSerialOutOfOrder, [&](unsigned long) {++lSunk;});
+		bool lThrown = false;
+		try {
+			lPipeline.run();
+		} catch(const runtime_error&) {
+			lThrown = true;
+		}
+		if(!lThrown) return fail("exception of a stage was not thrown by run()");
+		if(lNext >= cCount) return fail("source was not stopped by a failure");
+		if(lSunk.load() >= cCount) return fail("failed item reached the sink");
+		if(lPipeline.getStatistics(1).mItems != lPassed.load()) return fail("failed item was counted as processed");
+	}
+	cout << "Pipeline: passed" << endl;
+	return 0;
+}
@@ -0,0 +1,117 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/test/Threading/TaskWait.cpp
+ * \brief Regression test: waiting for a task before it is pushed onto a thread pool.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#include "PACC/Threading/ThreadPool.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <thread>
+
+using namespace std;
+using namespace PACC;
+
+namespace {
+
+	//! Task that counts its executions.
+	class CountTask : public Threading::Task {
+		public:
+		CountTask(void) : mRuns(0) {}
+		atomic<unsigned int> mRuns; //!< Number of executions.
+		void main(void) {++mRuns;}
+	};
+
+	//! Return whether flag \c inFlag becomes true within about five seconds.
+	bool waitFor(const atomic<bool>& inFlag)
+	{
+		for(int i = 0; i < 5000 && !inFlag.load(); ++i) this_thread::sleep_for(chrono::milliseconds(1));
+		return inFlag.load();
+	}
+
+	//! Report failure \c inMessage and exit (a waiter may still be blocked).
+	void fail(const char* inMessage)
+	{
+		cerr << "TaskWait: " << inMessage << endl;
+		_Exit(1);
+	}
+
+	/*! Wait for task \c ioTask in another thread, then push it with function \c inPush, and check that the waiter wakes up.
+	
+	The waiter is given time to block first, so that it sets the waiter flag of the task before the thread pool resets its state.
+	*/
+	template <class Push>
+	void checkWaitBeforePush(CountTask& ioTask, unsigned int inRuns, Push inPush, const char* inMessage)
+	{
+		atomic<bool> lWoken(false);
+		thread lWaiter([&]() {ioTask.wait(); lWoken.store(true);});
+		this_thread::sleep_for(chrono::milliseconds(50));
+		if(lWoken.load()) fail("waiter returned before the task was pushed");
+		inPush();
+		if(!waitFor(lWoken)) {
+			lWaiter.detach();
+			fail(inMessage);
+		}
+		lWaiter.join();
+		if(ioTask.mRuns.load() != inRuns) fail("task did not run exactly once per push");
+	}
+
+}
+
+/*!
+A thread that waits for a task before it is pushed must be woken up once the task completes, whether the task is pushed alone or in a batch, when a completed task is reused, and when the pool records metrics.
+ */
+int main(void)
+{
+	Threading::ThreadPool lPool(2);
+	CountTask lTask;
+	checkWaitBeforePush(lTask, 1, [&]() {lPool.push(lTask);}, "waiter of a pushed task was not woken up");
+
+	// reused task: a waiter returns at once while the task is still completed, so reset it first
+	lTask.reset();
+	checkWaitBeforePush(lTask, 2, [&]() {lPool.push(lTask);}, "waiter of a reused task was not woken up");
+
+	CountTask lBatch[4];
+	Threading::Task* lPointers[4] = {&lBatch[0], &lBatch[1], &lBatch[2], &lBatch[3]};
+	checkWaitBeforePush(lBatch[3], 1, [&]() {lPool.pushBatch(lPointers, lPointers+4);}, "waiter of a task pushed in a batch was not woken up");
+	for(unsigned int i = 0; i < 4; ++i) lBatch[i].wait();
+
+	// with metrics, the pool flags the pushed tasks as counted and timed, which must preserve the waiter flag
+	lPool.setMetrics(true);
+	CountTask lMeasured;
+	checkWaitBeforePush(lMeasured, 1, [&]() {lPool.push(lMeasured);}, "waiter of a task pushed with metrics was not woken up");
+
+	cout << "TaskWait: passed" << endl;
+	return 0;
+}
@@ -0,0 +1,91 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/test/Threading/ThreadLocal.cpp
+ * \brief Regression test: per-thread values of class Threading::ThreadLocal.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#include "PACC/Threading/ThreadLocal.hpp"
+#include <iostream>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace PACC;
+
+namespace {
+
+	const unsigned int cThreads = 8; //!< Number of threads.
+	const unsigned long cIncrements = 10000; //!< Number of increments per thread.
+
+	int fail(const char* inMessage)
+	{
+		cerr << "ThreadLocal: " << inMessage << endl;
+		return 1;
+	}
+
+}
+
+/*!
+Every thread must get its own lazily constructed value, which survives the thread and can be merged. Variables must not share values, even when a deleted variable is replaced by a new one, and a cleared variable must construct new values.
+ */
+int main(void)
+{
+	Threading::ThreadLocal<unsigned long> lCounters(0);
+	Threading::ThreadLocal<unsigned long> lOthers([]() {return 1000UL;});
+	vector<unsigned long*> lAddresses(cThreads, 0);
+	vector<thread> lThreads;
+	for(unsigned int t = 0; t < cThreads; ++t) lThreads.push_back(thread([&, t]() {
+		lAddresses[t] = &lCounters.get();
+		for(unsigned long i = 0; i < cIncrements; ++i) ++lCounters.get();
+		++*lOthers;
+	}));
+	for(unsigned int t = 0; t < cThreads; ++t) lThreads[t].join();
+	if(set<unsigned long*>(lAddresses.begin(), lAddresses.end()).size() != cThreads) return fail("threads shared a value");
+	if(lCounters.accumulate(0UL, [](unsigned long inSum, unsigned long inValue) {return inSum + inValue;}) != cThreads*cIncrements) return fail("values of terminated threads were lost");
+	if(lOthers.accumulate(0UL, [](unsigned long inSum, unsigned long inValue) {return inSum + inValue;}) != cThreads*1001) return fail("variables shared their values");
+	if(lCounters.get() != 0) return fail("value of the main thread was not constructed from the initial value");
+
+	lCounters.get() = 5;
+	lCounters.clear();
+	if(lCounters.get() != 0) return fail("cleared variable kept the value of a thread");
+
+	// a new variable may reuse the slot of a deleted one, but not its values
+	for(unsigned int i = 0; i < 100; ++i) {
+		Threading::ThreadLocal<unsigned long>* lVariable = new Threading::ThreadLocal<unsigned long>(i);
+		if(lVariable->get() != i) return fail("new variable returned the value of a deleted variable");
+		lVariable->get() = 12345;
+		delete lVariable;
+	}
+	cout << "ThreadLocal: passed" << endl;
+	return 0;
+}
@@ -0,0 +1,127 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/test/Threading/ThreadPoolMetrics.cpp
+ * \brief Regression test: counters of the metrics of class Threading::ThreadPool.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#include "PACC/Threading/Latch.hpp"
+#include "PACC/Threading/ThreadPool.hpp"
+#include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using namespace PACC;
+
+namespace {
+
+	const unsigned int cTasks = 500; //!< Number of tasks per submitter.
+
+	int fail(const char* inMessage)
+	{
+		cerr << "ThreadPoolMetrics: " << inMessage << endl;
+		return 1;
+	}
+
+	//! Empty task.
+	class EmptyTask : public Threading::Task {
+		protected:
+		void main(void) {}
+	};
+
+	//! Task that blocks until a latch opens.
+	class GatedTask : public Threading::Task {
+		public:
+		explicit GatedTask(Threading::Latch& inGate) : mGate(inGate) {}
+		protected:
+		Threading::Latch& mGate; //!< Latch that releases the task.
+		void main(void) {mGate.wait();}
+	};
+
+}
+
+/*!
+Every pushed task must be counted once as submitted and once as completed, one task out of every sampling period must be timed, and the queue depth must return to zero, even for tasks pushed before metrics were enabled.
+ */
+int main(void)
+{
+	Threading::ThreadPool lPool(2);
+
+	// tasks pushed before metrics are enabled are not counted as pending when they start
+	Threading::Latch lGate(1);
+	GatedTask lGated1(lGate), lGated2(lGate), lQueued(lGate);
+	lPool.push(lGated1);
+	lPool.push(lGated2);
+	lPool.push(lQueued);
+	lPool.setMetrics(true, 4);
+	lGate.countDown();
+	lQueued.wait();
+	lGated1.wait();
+	lGated2.wait();
+	if(lPool.getMetrics().mQueueDepth != 0) return fail("tasks pushed before metrics were counted as pending");
+
+	lPool.resetMetrics();
+	const unsigned int lSubmitters = 2;
+	vector<EmptyTask> lTasks(lSubmitters*cTasks);
+	vector<thread> lThreads;
+	for(unsigned int s = 0; s < lSubmitters; ++s) lThreads.push_back(thread([&, s]() {
+		// half of the tasks one by one, and half in a batch
+		vector<EmptyTask>::iterator lFirst = lTasks.begin()+s*cTasks;
+		for(unsigned int i = 0; i < cTasks/2; ++i) lPool.push(lFirst[i]);
+		lPool.pushBatch(lFirst+cTasks/2, lFirst+cTasks);
+		for(unsigned int i = 0; i < cTasks; ++i) lFirst[i].wait();
+	}));
+	for(unsigned int s = 0; s < lSubmitters; ++s) lThreads[s].join();
+
+	Threading::ThreadPool::Metrics lMetrics = lPool.getMetrics();
+	if(lMetrics.mSubmitted != lSubmitters*cTasks) return fail("wrong number of submitted tasks");
+	if(lMetrics.mCompleted != lSubmitters*cTasks) return fail("wrong number of completed tasks");
+	unsigned long lWorkerTasks = 0;
+	for(size_t i = 0; i < lMetrics.mWorkers.size(); ++i) lWorkerTasks += lMetrics.mWorkers[i].mCompleted;
+	if(lWorkerTasks != lMetrics.mCompleted) return fail("tasks of the workers do not add up to the completed tasks");
+	if(lMetrics.mQueueDepth != 0) return fail("queue depth did not return to zero");
+	if(lMetrics.mMaxQueueDepth < 1 || lMetrics.mMaxQueueDepth > (long) (lSubmitters*cTasks)) return fail("peak queue depth is out of range");
+	unsigned long lTimed = lMetrics.mWait.getCount();
+	if(lTimed != lMetrics.mRun.getCount()) return fail("wait and run times were not sampled on the same tasks");
+	if(lTimed < lSubmitters*(cTasks/4-1) || lTimed > lSubmitters*(cTasks/4+1)) return fail("not one task out of every sampling period was timed");
+
+	ostringstream lText;
+	lMetrics.write(lText);
+	if(lText.str().empty()) return fail("metrics were not written");
+
+	lPool.resetMetrics();
+	lMetrics = lPool.getMetrics();
+	if(lMetrics.mSubmitted != 0 || lMetrics.mCompleted != 0 || lMetrics.mWait.getCount() != 0) return fail("metrics were not reset");
+	cout << "ThreadPoolMetrics: passed" << endl;
+	return 0;
+}
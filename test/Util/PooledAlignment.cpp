@@ -0,0 +1,92 @@
+/*
+ *  Portable Agile C++ Classes (PACC)
+ *  Copyright (C) 2001-2003 by Marc Parizeau
+ *  http://manitou.gel.ulaval.ca/~parizeau/PACC
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ *  Contact:
+ *  Laboratoire de Vision et Systemes Numeriques
+ *  Departement de genie electrique et de genie informatique
+ *  Universite Laval, Quebec, Canada, G1K 7P4
+ *  http://vision.gel.ulaval.ca
+ *
+ */
+
+/*!
+ * \file PACC/test/Util/PooledAlignment.cpp
+ * \brief Regression test: alignment of objects allocated through mixin class Pooled.
+ * \author Laboratoire de vision et syst&egrave;mes num&eacute;riques, Universit&eacute; Laval
+ * $Revision: 1.1 $
+ * $Date: 2026/10/16 14:00:00 $
+ */
+
+#include "PACC/Threading/ThreadPool.hpp"
+#include <cstdint>
+#include <iostream>
+#include <new>
+#include <vector>
+
+using namespace std;
+using namespace PACC;
+
+namespace {
+
+	//! Task of ordinary alignment (allocated from the pool).
+	struct SmallTask : public Threading::Task {
+		char mData[24]; //!< Payload.
+		void main(void) {}
+	};
+
+	//! Over-aligned task (allocated from the heap, with its alignment).
+	struct alignas(64) WideTask : public Threading::Task {
+		char mData[64]; //!< Payload.
+		void main(void) {}
+	};
+
+	//! Return whether pointer \c inObject is aligned on \c inAlign bytes.
+	bool isAligned(const void* inObject, size_t inAlign) {return reinterpret_cast<uintptr_t>(inObject) % inAlign == 0;}
+
+}
+
+/*!
+Objects of a class derived from Pooled must get the alignment of their type, with both the ordinary and the nothrow forms of operator new, also when they are interleaved with pooled allocations.
+ */
+int main(void)
+{
+	vector<Threading::Task*> lTasks;
+	unsigned int lMisaligned = 0;
+	for(unsigned int i = 0; i < 100; ++i) {
+		lTasks.push_back(new SmallTask);
+		WideTask* lWide = new WideTask;
+		WideTask* lNothrow = new(nothrow) WideTask;
+		if(!isAligned(lWide, alignof(WideTask))) ++lMisaligned;
+		if(!lNothrow || !isAligned(lNothrow, alignof(WideTask))) ++lMisaligned;
+		if(!isAligned(lTasks.back(), alignof(SmallTask))) ++lMisaligned;
+		lTasks.push_back(lWide);
+		lTasks.push_back(lNothrow);
+	}
+	// a task must be completed before it is deleted
+	Threading::ThreadPool lPool(1);
+	lPool.pushBatch(&lTasks.front(), &lTasks.front()+lTasks.size());
+	for(size_t i = 0; i < lTasks.size(); ++i) lTasks[i]->wait();
+	for(size_t i = 0; i < lTasks.size(); ++i) delete lTasks[i];
+	if(lMisaligned > 0) {
+		cerr << "PooledAlignment: " << lMisaligned << " misaligned objects out of 300" << endl;
+		return 1;
+	}
+	cout << "PooledAlignment: passed" << endl;
+	return 0;
+}